@@ -0,0 +1,653 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Util.hpp>
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace cul {
+
+namespace detail {
+
+/** Stack for tree traversals, which only allocates for very deep trees. */
+template <typename T>
+class TraversalStack final {
+public:
+    void push(T obj) {
+        if (m_size < k_fixed_size) m_fixed[m_size] = obj;
+        else m_more.push_back(obj);
+        ++m_size;
+    }
+
+    T pop() {
+        --m_size;
+        if (m_size < k_fixed_size) return m_fixed[m_size];
+        T rv = m_more.back();
+        m_more.pop_back();
+        return rv;
+    }
+
+    bool is_empty() const noexcept { return m_size == 0; }
+
+private:
+    static constexpr const std::size_t k_fixed_size = 64;
+
+    T m_fixed[k_fixed_size];
+    std::vector<T> m_more;
+    std::size_t m_size = 0;
+};
+
+} // end of detail namespace -> into ::cul
+
+/** A bounding volume hierarchy of rectangles, for finding overlapping
+ *  objects without testing every pair (a "broadphase").
+ *
+ *  Each object is stored with a "fat" rectangle, its own extended by a
+ *  margin. Moving an object only changes the tree once it leaves its fat
+ *  rectangle. New leaves are placed where they grow the tree's perimeter
+ *  the least (the 2D version of the "surface area heuristic"), and the tree
+ *  is kept balanced with rotations like an AVL tree.
+ *
+ *  All nodes live in one contiguous pool with a free list, so ids stay
+ *  stable and no allocation is made once the pool is large enough.
+ *
+ *  Queries are exact, results are tested against each object's own
+ *  rectangle after the tree finds candidates by fat rectangles. Overlapping
+ *  is as "overlaps", and containing a point as "is_contained_in".
+ *
+ *  Query callbacks may return a FlowControlSignal to stop early.
+ *
+ *  @tparam Payload anything default constructible, stored with each object
+ */
+template <typename T, typename Payload>
+class DynamicAabbTree final {
+public:
+    static_assert(std::is_arithmetic_v<T>, "DynamicAabbTree: T must be an arithmetic type.");
+
+    using ProxyId = std::uint32_t;
+    using RectangleType = Rectangle<T>;
+    using VectorType = Vector2<T>;
+
+    static constexpr const ProxyId k_null_proxy = std::numeric_limits<ProxyId>::max();
+
+    /** @param margin how far fat rectangles extend out from their objects' */
+    explicit DynamicAabbTree(T margin = T(0)): m_margin(margin) {}
+
+    /** @returns id for the new object, stable until it is removed */
+    ProxyId insert(const RectangleType & bounds, Payload payload);
+
+    /** @throws if the id does not refer to an object */
+    void remove(ProxyId);
+
+    /** Updates an object's rectangle.
+     *
+     *  @param displacement how far the object is expected to move next, its
+     *         fat rectangle is extended this way too
+     *  @throws if the id does not refer to an object
+     *  @returns true if the object had to be moved in the tree
+     */
+    bool move(ProxyId, const RectangleType & bounds,
+              const VectorType & displacement = VectorType());
+
+    /** @throws if the id does not refer to an object */
+    Payload & payload_of(ProxyId);
+
+    const Payload & payload_of(ProxyId) const;
+
+    /** @throws if the id does not refer to an object */
+    RectangleType bounds_of(ProxyId) const;
+
+    /** @throws if the id does not refer to an object */
+    RectangleType fat_bounds_of(ProxyId) const;
+
+    /** Calls f(ProxyId, const Payload &) for every object overlapping the
+     *  given rectangle.
+     */
+    template <typename Func>
+    void query(const RectangleType &, Func && f) const;
+
+    /** Calls f(ProxyId, const Payload &) for every object containing the
+     *  given point.
+     */
+    template <typename Func>
+    void query(const VectorType &, Func && f) const;
+
+    /** Calls f(ProxyId, const Payload &, T fraction) for every object hit by
+     *  the line segment from a to b, in no particular order.
+     *
+     *  The fraction is where along the segment the object is first hit, from
+     *  zero at a to one at b (zero if a is inside the object).
+     *  @note only for floating point types
+     */
+    template <typename Func>
+    void raycast(const VectorType & a, const VectorType & b, Func && f) const;
+
+    /** Calls f(ProxyId, ProxyId) once for every pair of overlapping objects,
+     *  with the lesser id first.
+     */
+    template <typename Func>
+    void for_each_overlapping_pair(Func && f) const;
+
+    /** Removes all objects, while keeping the pool's memory. */
+    void clear();
+
+    std::size_t size() const noexcept { return m_size; }
+
+    bool is_empty() const noexcept { return m_size == 0; }
+
+    /** @returns height of the tree, zero for none or one object */
+    int height() const noexcept
+        { return m_root == k_null_proxy ? 0 : m_nodes[m_root].height; }
+
+    T margin() const noexcept { return m_margin; }
+
+private:
+    using NodeIndex = ProxyId;
+    static constexpr const NodeIndex k_null_node = k_null_proxy;
+    static constexpr const int k_free_height = -1;
+    static constexpr const int k_leaf_height =  0;
+
+    struct Bounds {
+        T left = 0, top = 0, right = 0, bottom = 0;
+    };
+
+    struct Node {
+        Bounds bounds; // fat for leaves
+        Bounds tight;  // leaves only
+        // parent, or the next free node
+        NodeIndex parent = k_null_node;
+        NodeIndex child_a = k_null_node, child_b = k_null_node;
+        int height = k_free_height;
+        Payload payload;
+
+        bool is_leaf() const noexcept { return height == k_leaf_height; }
+    };
+
+    static Bounds to_bounds(const RectangleType & rect) noexcept
+        { return Bounds { rect.left, rect.top, right_of(rect), bottom_of(rect) }; }
+
+    static RectangleType to_rectangle(const Bounds & bounds) noexcept {
+        return RectangleType(bounds.left, bounds.top, bounds.right - bounds.left,
+                             bounds.bottom - bounds.top);
+    }
+
+    static Bounds combine(const Bounds & a, const Bounds & b) noexcept {
+        return Bounds { std::min(a.left, b.left), std::min(a.top   , b.top   ),
+                        std::max(a.right, b.right), std::max(a.bottom, b.bottom) };
+    }
+
+    static T perimeter_of(const Bounds & a) noexcept
+        { return T(2)*((a.right - a.left) + (a.bottom - a.top)); }
+
+    static bool contains(const Bounds & outer, const Bounds & inner) noexcept {
+        return    outer.left  <= inner.left  && outer.top    <= inner.top
+               && outer.right >= inner.right && outer.bottom >= inner.bottom;
+    }
+
+    // like "overlaps", on fat bounds this may only be conservative
+    static bool overlaps(const Bounds & a, const Bounds & b) noexcept {
+        return    a.right  > b.left && b.right  > a.left
+               && a.bottom > b.top  && b.bottom > a.top ;
+    }
+
+    static bool contains(const Bounds & a, const VectorType & r) noexcept
+        { return r.x >= a.left && r.y >= a.top && r.x < a.right && r.y < a.bottom; }
+
+    Bounds fatten(const Bounds &, const VectorType & displacement) const noexcept;
+
+    const Node & verify_leaf(ProxyId, const char * caller) const;
+
+    NodeIndex allocate_node();
+
+    void free_node(NodeIndex);
+
+    void insert_leaf(NodeIndex);
+
+    void remove_leaf(NodeIndex);
+
+    // @returns new root of the subtree
+    NodeIndex balance(NodeIndex);
+
+    // fix heights and bounds from a node up to the root, rebalancing along
+    // the way
+    void refit_from(NodeIndex);
+
+    template <typename TestNode, typename TestLeaf, typename Func>
+    void traverse(TestNode &&, TestLeaf &&, Func && f) const;
+
+    std::vector<Node> m_nodes;
+    NodeIndex m_root = k_null_node;
+    NodeIndex m_free_list = k_null_node;
+    std::size_t m_size = 0;
+    T m_margin;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T, typename Payload>
+typename DynamicAabbTree<T, Payload>::ProxyId
+    DynamicAabbTree<T, Payload>::insert(const RectangleType & bounds, Payload payload)
+{
+    auto idx = allocate_node();
+    auto & node = m_nodes[idx];
+    node.tight   = to_bounds(bounds);
+    node.bounds  = fatten(node.tight, VectorType());
+    node.height  = k_leaf_height;
+    node.payload = std::move(payload);
+    insert_leaf(idx);
+    ++m_size;
+    return idx;
+}
+
+template <typename T, typename Payload>
+void DynamicAabbTree<T, Payload>::remove(ProxyId id) {
+    verify_leaf(id, "remove");
+    remove_leaf(id);
+    free_node(id);
+    --m_size;
+}
+
+template <typename T, typename Payload>
+bool DynamicAabbTree<T, Payload>::move
+    (ProxyId id, const RectangleType & rect, const VectorType & displacement)
+{
+    verify_leaf(id, "move");
+    auto & node = m_nodes[id];
+    node.tight = to_bounds(rect);
+    // large displacements leave large fat bounds, which should shrink again
+    // once the object slows down
+    auto largest_fat = fatten(node.tight, displacement*T(2));
+    largest_fat.left   -= T(3)*m_margin;
+    largest_fat.top    -= T(3)*m_margin;
+    largest_fat.right  += T(3)*m_margin;
+    largest_fat.bottom += T(3)*m_margin;
+    if (contains(node.bounds, node.tight) && contains(largest_fat, node.bounds))
+        { return false; }
+
+    remove_leaf(id);
+    m_nodes[id].bounds = fatten(m_nodes[id].tight, displacement);
+    insert_leaf(id);
+    return true;
+}
+
+template <typename T, typename Payload>
+Payload & DynamicAabbTree<T, Payload>::payload_of(ProxyId id)
+    { return const_cast<Node &>(verify_leaf(id, "payload_of")).payload; }
+
+template <typename T, typename Payload>
+const Payload & DynamicAabbTree<T, Payload>::payload_of(ProxyId id) const
+    { return verify_leaf(id, "payload_of").payload; }
+
+template <typename T, typename Payload>
+typename DynamicAabbTree<T, Payload>::RectangleType
+    DynamicAabbTree<T, Payload>::bounds_of(ProxyId id) const
+{ return to_rectangle(verify_leaf(id, "bounds_of").tight); }
+
+template <typename T, typename Payload>
+typename DynamicAabbTree<T, Payload>::RectangleType
+    DynamicAabbTree<T, Payload>::fat_bounds_of(ProxyId id) const
+{ return to_rectangle(verify_leaf(id, "fat_bounds_of").bounds); }
+
+template <typename T, typename Payload>
+template <typename Func>
+void DynamicAabbTree<T, Payload>::query(const RectangleType & rect, Func && f) const {
+    auto bounds = to_bounds(rect);
+    traverse([&bounds](const Bounds & node) { return overlaps(node, bounds); },
+             [&bounds](const Bounds & leaf) { return overlaps(leaf, bounds); },
+             [&f](NodeIndex idx, const Node & leaf)
+             { return adapt_to_flow_control_signal(f, ProxyId(idx), leaf.payload); });
+}
+
+template <typename T, typename Payload>
+template <typename Func>
+void DynamicAabbTree<T, Payload>::query(const VectorType & r, Func && f) const {
+    traverse([&r](const Bounds & node) { return contains(node, r); },
+             [&r](const Bounds & leaf) { return contains(leaf, r); },
+             [&f](NodeIndex idx, const Node & leaf)
+             { return adapt_to_flow_control_signal(f, ProxyId(idx), leaf.payload); });
+}
+
+template <typename T, typename Payload>
+template <typename Func>
+void DynamicAabbTree<T, Payload>::raycast
+    (const VectorType & a, const VectorType & b, Func && f) const
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "DynamicAabbTree::raycast: only available for floating point "
+                  "types.");
+    const auto delta = b - a;
+    // @returns fraction where the segment enters, or something greater than
+    //          one if it misses
+    auto entry_of = [&a, &delta](const Bounds & box) {
+        static constexpr const T k_miss = T(2);
+        T low = T(0), high = T(1);
+        auto clip = [&low, &high](T start, T step, T box_low, T box_high) {
+            if (step == T(0)) {
+                if (start < box_low || start > box_high) high = -T(1);
+                return;
+            }
+            T t0 = (box_low  - start) / step;
+            T t1 = (box_high - start) / step;
+            if (t0 > t1) std::swap(t0, t1);
+            low  = std::max(low , t0);
+            high = std::min(high, t1);
+        };
+        clip(a.x, delta.x, box.left, box.right );
+        clip(a.y, delta.y, box.top , box.bottom);
+        return low <= high ? low : k_miss;
+    };
+    T fraction = 0;
+    traverse([&entry_of](const Bounds & node) { return entry_of(node) <= T(1); },
+             [&entry_of, &fraction](const Bounds & leaf) {
+                 fraction = entry_of(leaf);
+                 return fraction <= T(1);
+             },
+             [&f, &fraction](NodeIndex idx, const Node & leaf)
+             { return adapt_to_flow_control_signal(f, ProxyId(idx), leaf.payload, fraction); });
+}
+
+template <typename T, typename Payload>
+template <typename Func>
+void DynamicAabbTree<T, Payload>::for_each_overlapping_pair(Func && f) const {
+    using namespace fc_signal;
+    if (m_root == k_null_node) return;
+    // The tree is descended against itself: a pair of the same node stands
+    // for all pairs within it, and a pair of different nodes for all pairs
+    // with one object in each, skipped entirely if they do not overlap.
+    detail::TraversalStack<std::pair<NodeIndex, NodeIndex>> stack;
+    stack.push(std::make_pair(m_root, m_root));
+    while (!stack.is_empty()) {
+        auto [a_idx, b_idx] = stack.pop();
+        const auto & a = m_nodes[a_idx];
+        const auto & b = m_nodes[b_idx];
+        if (a_idx == b_idx) {
+            if (a.is_leaf()) continue;
+            stack.push(std::make_pair(a.child_a, a.child_a));
+            stack.push(std::make_pair(a.child_b, a.child_b));
+            stack.push(std::make_pair(a.child_a, a.child_b));
+        } else if (!overlaps(a.bounds, b.bounds)) {
+            continue;
+        } else if (a.is_leaf() && b.is_leaf()) {
+            if (!overlaps(a.tight, b.tight)) continue;
+            if (adapt_to_flow_control_signal(f, ProxyId(std::min(a_idx, b_idx)),
+                                             ProxyId(std::max(a_idx, b_idx))) == k_break)
+            { return; }
+        } else if (a.is_leaf() || (!b.is_leaf() && perimeter_of(b.bounds) > perimeter_of(a.bounds))) {
+            // descend into the larger of the two
+            stack.push(std::make_pair(a_idx, b.child_a));
+            stack.push(std::make_pair(a_idx, b.child_b));
+        } else {
+            stack.push(std::make_pair(a.child_a, b_idx));
+            stack.push(std::make_pair(a.child_b, b_idx));
+        }
+    }
+}
+
+template <typename T, typename Payload>
+void DynamicAabbTree<T, Payload>::clear() {
+    m_nodes.clear();
+    m_root = m_free_list = k_null_node;
+    m_size = 0;
+}
+
+template <typename T, typename Payload>
+/* private */ typename DynamicAabbTree<T, Payload>::Bounds
+    DynamicAabbTree<T, Payload>::fatten
+    (const Bounds & bounds, const VectorType & displacement) const noexcept
+{
+    Bounds rv { bounds.left  - m_margin, bounds.top    - m_margin,
+                bounds.right + m_margin, bounds.bottom + m_margin };
+    if (displacement.x < T(0)) rv.left   += displacement.x;
+    else                       rv.right  += displacement.x;
+    if (displacement.y < T(0)) rv.top    += displacement.y;
+    else                       rv.bottom += displacement.y;
+    return rv;
+}
+
+template <typename T, typename Payload>
+/* private */ const typename DynamicAabbTree<T, Payload>::Node &
+    DynamicAabbTree<T, Payload>::verify_leaf(ProxyId id, const char * caller) const
+{
+    using namespace exceptions_abbr;
+    if (id < m_nodes.size() && m_nodes[id].is_leaf()) return m_nodes[id];
+    throw InvArg("DynamicAabbTree::" + std::string(caller) + ": id does not "
+                 "refer to an object.");
+}
+
+template <typename T, typename Payload>
+/* private */ typename DynamicAabbTree<T, Payload>::NodeIndex
+    DynamicAabbTree<T, Payload>::allocate_node()
+{
+    using namespace exceptions_abbr;
+    if (m_free_list == k_null_node) {
+        if (m_nodes.size() >= std::size_t(k_null_node)) {
+            throw RtError("DynamicAabbTree::allocate_node: cannot hold any more "
+                          "objects.");
+        }
+        m_nodes.emplace_back();
+        return NodeIndex(m_nodes.size() - 1);
+    }
+    auto idx = m_free_list;
+    auto & node = m_nodes[idx];
+    m_free_list  = node.parent;
+    node.parent  = k_null_node;
+    node.child_a = node.child_b = k_null_node;
+    return idx;
+}
+
+template <typename T, typename Payload>
+/* private */ void DynamicAabbTree<T, Payload>::free_node(NodeIndex idx) {
+    auto & node  = m_nodes[idx];
+    node.height  = k_free_height;
+    node.payload = Payload();
+    node.parent  = m_free_list;
+    m_free_list  = idx;
+}
+
+template <typename T, typename Payload>
+/* private */ void DynamicAabbTree<T, Payload>::insert_leaf(NodeIndex leaf) {
+    if (m_root == k_null_node) {
+        m_root = leaf;
+        m_nodes[leaf].parent = k_null_node;
+        return;
+    }
+
+    // find the best sibling, where the perimeter grows the least
+    const auto leaf_bounds = m_nodes[leaf].bounds;
+    auto idx = m_root;
+    while (!m_nodes[idx].is_leaf()) {
+        const auto & node = m_nodes[idx];
+        T perimeter = perimeter_of(node.bounds);
+        T combined  = perimeter_of(combine(node.bounds, leaf_bounds));
+        // cost of a new parent for this node and the leaf
+        T cost = T(2)*combined;
+        // minimum cost of pushing the leaf further down
+        T inheritance_cost = T(2)*(combined - perimeter);
+        auto cost_of_child = [this, &leaf_bounds, inheritance_cost](NodeIndex child_idx) {
+            const auto & child = m_nodes[child_idx];
+            T child_combined = perimeter_of(combine(child.bounds, leaf_bounds));
+            if (child.is_leaf()) return child_combined + inheritance_cost;
+            return child_combined - perimeter_of(child.bounds) + inheritance_cost;
+        };
+        T cost_a = cost_of_child(node.child_a);
+        T cost_b = cost_of_child(node.child_b);
+        if (cost < cost_a && cost < cost_b) break;
+        idx = cost_a < cost_b ? node.child_a : node.child_b;
+    }
+
+    // a new parent for the sibling and the leaf
+    auto sibling = idx;
+    auto old_parent = m_nodes[sibling].parent;
+    auto new_parent = allocate_node();
+    {
+    auto & parent   = m_nodes[new_parent];
+    parent.parent   = old_parent;
+    parent.bounds   = combine(leaf_bounds, m_nodes[sibling].bounds);
+    parent.height   = m_nodes[sibling].height + 1;
+    parent.child_a  = sibling;
+    parent.child_b  = leaf;
+    }
+    if (old_parent == k_null_node) {
+        m_root = new_parent;
+    } else {
+        auto & grand_parent = m_nodes[old_parent];
+        if (grand_parent.child_a == sibling) grand_parent.child_a = new_parent;
+        else                                 grand_parent.child_b = new_parent;
+    }
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf   ].parent = new_parent;
+    refit_from(m_nodes[leaf].parent);
+}
+
+template <typename T, typename Payload>
+/* private */ void DynamicAabbTree<T, Payload>::remove_leaf(NodeIndex leaf) {
+    if (leaf == m_root) {
+        m_root = k_null_node;
+        return;
+    }
+    auto parent = m_nodes[leaf].parent;
+    auto grand_parent = m_nodes[parent].parent;
+    auto sibling = m_nodes[parent].child_a == leaf ? m_nodes[parent].child_b
+                                                   : m_nodes[parent].child_a;
+    // sibling takes the parent's place
+    free_node(parent);
+    m_nodes[sibling].parent = grand_parent;
+    if (grand_parent == k_null_node) {
+        m_root = sibling;
+        return;
+    }
+    auto & gp_node = m_nodes[grand_parent];
+    if (gp_node.child_a == parent) gp_node.child_a = sibling;
+    else                           gp_node.child_b = sibling;
+    refit_from(grand_parent);
+}
+
+template <typename T, typename Payload>
+/* private */ void DynamicAabbTree<T, Payload>::refit_from(NodeIndex idx) {
+    while (idx != k_null_node) {
+        idx = balance(idx);
+        auto & node = m_nodes[idx];
+        const auto & child_a = m_nodes[node.child_a];
+        const auto & child_b = m_nodes[node.child_b];
+        node.height = 1 + std::max(child_a.height, child_b.height);
+        node.bounds = combine(child_a.bounds, child_b.bounds);
+        idx = node.parent;
+    }
+}
+
+template <typename T, typename Payload>
+/* private */ typename DynamicAabbTree<T, Payload>::NodeIndex
+    DynamicAabbTree<T, Payload>::balance(NodeIndex a_idx)
+{
+    /* Rotates a taller grandchild up, with "a" being the given node:
+     *
+     *       a                c
+     *      / \              / \
+     *     b   c     ->     a   f (the taller of f and g)
+     *        / \          / \
+     *       f   g        b   g
+     *
+     * (and the same with b and c swapped)
+     */
+    auto & a = m_nodes[a_idx];
+    if (a.is_leaf() || a.height < 2) return a_idx;
+
+    auto rotate_up = [this, a_idx](NodeIndex up_idx, NodeIndex other_idx) {
+        auto & a  = m_nodes[a_idx];
+        auto & up = m_nodes[up_idx];
+        auto f_idx = up.child_a;
+        auto g_idx = up.child_b;
+        // "up" takes a's place
+        up.child_a = a_idx;
+        up.parent  = a.parent;
+        a.parent   = up_idx;
+        if (up.parent == k_null_node) {
+            m_root = up_idx;
+        } else {
+            auto & up_parent = m_nodes[up.parent];
+            if (up_parent.child_a == a_idx) up_parent.child_a = up_idx;
+            else                            up_parent.child_b = up_idx;
+        }
+        // the taller of f and g stays with "up", the other goes to a
+        if (m_nodes[f_idx].height < m_nodes[g_idx].height) std::swap(f_idx, g_idx);
+        up.child_b = f_idx;
+        if (a.child_a == up_idx) a.child_a = g_idx;
+        else                     a.child_b = g_idx;
+        m_nodes[g_idx].parent = a_idx;
+
+        const auto & other = m_nodes[other_idx];
+        const auto & g     = m_nodes[g_idx];
+        const auto & f     = m_nodes[f_idx];
+        a.bounds  = combine(other.bounds, g.bounds);
+        a.height  = 1 + std::max(other.height, g.height);
+        up.bounds = combine(a.bounds, f.bounds);
+        up.height = 1 + std::max(a.height, f.height);
+        return up_idx;
+    };
+
+    auto b_idx = a.child_a;
+    auto c_idx = a.child_b;
+    int imbalance = m_nodes[c_idx].height - m_nodes[b_idx].height;
+    if (imbalance >  1) return rotate_up(c_idx, b_idx);
+    if (imbalance < -1) return rotate_up(b_idx, c_idx);
+    return a_idx;
+}
+
+template <typename T, typename Payload>
+template <typename TestNode, typename TestLeaf, typename Func>
+/* private */ void DynamicAabbTree<T, Payload>::traverse
+    (TestNode && test_node, TestLeaf && test_leaf, Func && f) const
+{
+    using namespace fc_signal;
+    if (m_root == k_null_node) return;
+    detail::TraversalStack<NodeIndex> stack;
+    stack.push(m_root);
+    while (!stack.is_empty()) {
+        auto idx = stack.pop();
+        const auto & node = m_nodes[idx];
+        if (!test_node(node.bounds)) continue;
+        if (node.is_leaf()) {
+            if (test_leaf(node.tight) && f(idx, node) == k_break) return;
+            continue;
+        }
+        stack.push(node.child_a);
+        stack.push(node.child_b);
+    }
+}
+
+} // end of cul namespace
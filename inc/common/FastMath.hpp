@@ -0,0 +1,241 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Util.hpp>
+
+#include <tuple>
+#include <type_traits>
+
+#include <cmath>
+
+namespace cul {
+
+/** @defgroup fastmath Fast Approximate Math
+ *
+ *  Polynomial approximations of trigonometric functions, for when a handful
+ *  of correct digits is plenty (e.g. anything that ends up as a pixel).
+ *
+ *  Maximum absolute errors, measured over their whole domain for doubles
+ *  (floats are limited by their own precision first):
+ *  - sin, cos, sincos: 1e-7, for |t| < 1e5 (range reduction loses precision
+ *    beyond that), and NaN for infinite or NaN t like std::sin
+ *  - atan, atan2: 2e-8
+ *  - acos: 5e-8
+ *
+ *  sqrt is provided for completeness, but simply calls std::sqrt, which is a
+ *  single instruction on any platform worth mentioning.
+ */
+
+namespace fast {
+
+/** @addtogroup fastmath
+ *  @{
+ */
+
+/** @returns (sin(t), cos(t)), sharing range reduction between the two */
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, std::tuple<T, T>> sincos(T t) noexcept;
+
+template <typename T>
+inline std::enable_if_t<std::is_floating_point_v<T>, T> sin(T t) noexcept
+    { return std::get<0>(sincos(t)); }
+
+template <typename T>
+inline std::enable_if_t<std::is_floating_point_v<T>, T> cos(T t) noexcept
+    { return std::get<1>(sincos(t)); }
+
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, T> atan(T t) noexcept;
+
+/** @note atan2(0, 0) is zero */
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, T> atan2(T y, T x) noexcept;
+
+/** @note t is clamped to [-1 1] */
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, T> acos(T t) noexcept;
+
+template <typename T>
+inline std::enable_if_t<std::is_floating_point_v<T>, T> sqrt(T t) noexcept
+    { return std::sqrt(t); }
+
+/** @}*/
+
+} // end of fast namespace -> into ::cul
+
+/** Math policy which calls standard library functions, unqualified, so that
+ *  overloads for other scalar types (like Fixed) are found too.
+ *
+ *  Results have whatever type those functions return, so integers are
+ *  promoted to double rather than cut down to whole numbers.
+ */
+struct PreciseMath {
+    template <typename T>
+    static auto sin(T t) { using std::sin; return sin(t); }
+
+    template <typename T>
+    static auto cos(T t) { using std::cos; return cos(t); }
+
+    template <typename T>
+    static auto sincos(T t)
+        { return std::make_tuple(sin(t), cos(t)); }
+
+    template <typename T>
+    static auto atan2(T y, T x) { using std::atan2; return atan2(y, x); }
+
+    template <typename T>
+    static auto acos(T t) { using std::acos; return acos(t); }
+
+    template <typename T>
+    static auto sqrt(T t) { using std::sqrt; return sqrt(t); }
+};
+
+/** Math policy which uses cul::fast functions for floating point types, and
+ *  falls back to PreciseMath for anything else.
+ */
+struct FastMath {
+    template <typename T>
+    static auto sin(T t) { return std::get<0>(sincos(t)); }
+
+    template <typename T>
+    static auto cos(T t) { return std::get<1>(sincos(t)); }
+
+    template <typename T>
+    static auto sincos(T t) {
+        if constexpr (std::is_floating_point_v<T>) return fast::sincos(t);
+        else return PreciseMath::sincos(t);
+    }
+
+    template <typename T>
+    static auto atan2(T y, T x) {
+        if constexpr (std::is_floating_point_v<T>) return fast::atan2(y, x);
+        else return PreciseMath::atan2(y, x);
+    }
+
+    template <typename T>
+    static auto acos(T t) {
+        if constexpr (std::is_floating_point_v<T>) return fast::acos(t);
+        else return PreciseMath::acos(t);
+    }
+
+    template <typename T>
+    static auto sqrt(T t) { return PreciseMath::sqrt(t); }
+};
+
+/** The math policy used by Vector2Util functions when none is given.
+ *
+ *  Defining MACRO_CUL_FAST_MATH switches every such call site over to the
+ *  fast approximations at once.
+ */
+#ifdef MACRO_CUL_FAST_MATH
+using DefaultMath = FastMath;
+#else
+using DefaultMath = PreciseMath;
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace fast {
+
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, std::tuple<T, T>> sincos(T t) noexcept {
+    // Cody-Waite style reduction to [-pi pi], two parts to 2pi so that the
+    // multiple taken away is (nearly) exact
+    constexpr const T k_inv_two_pi = T(0.159154943091895335768883763372514362);
+    constexpr const T k_two_pi_hi  = T(6.28318548202514648438);
+    constexpr const T k_two_pi_lo  = T(-1.74845553146951715461e-7);
+    constexpr const T k_pi         = k_pi_for_type<T>;
+    constexpr const T k_half_pi    = k_pi*T(0.5);
+
+    // rounded in T, a cast to an integer is undefined for non real or huge t
+    // (which then simply propagate NaNs)
+    T k = std::round(t*k_inv_two_pi);
+    t = (t - k*k_two_pi_hi) - k*k_two_pi_lo;
+
+    // sin is only evaluated in [-pi/2 pi/2], with:
+    // sin(t) = sin(pi - t), cos(t) = sin(pi/2 - |t|)
+    auto sin_part = [](T x) {
+        // Taylor series to the 11th degree, error < 6e-8 on [-pi/2 pi/2]
+        constexpr const T k_c3  = T(-1) / T(6);
+        constexpr const T k_c5  = T( 1) / T(120);
+        constexpr const T k_c7  = T(-1) / T(5040);
+        constexpr const T k_c9  = T( 1) / T(362880);
+        constexpr const T k_c11 = T(-1) / T(39916800);
+        T x2 = x*x;
+        return x*(T(1) + x2*(k_c3 + x2*(k_c5 + x2*(k_c7 + x2*(k_c9 + x2*k_c11)))));
+    };
+    T s_arg = t;
+    if      (t >  k_half_pi) s_arg =  k_pi - t;
+    else if (t < -k_half_pi) s_arg = -k_pi - t;
+    T c_arg = k_half_pi - (t < T(0) ? -t : t);
+    return std::make_tuple(sin_part(s_arg), sin_part(c_arg));
+}
+
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, T> atan(T t) noexcept {
+    // Abramowitz & Stegun 4.4.49, error < 2e-8 on [-1 1]
+    // outside of which: atan(t) = sign(t)*pi/2 - atan(1/t)
+    constexpr const T k_half_pi = k_pi_for_type<T>*T(0.5);
+    bool inverted = t > T(1) || t < T(-1);
+    T x  = inverted ? T(1) / t : t;
+    T x2 = x*x;
+    T rv = x*(T(1) + x2*(T(-0.3333314528) + x2*(T(0.1999355085)
+           + x2*(T(-0.1420889944) + x2*(T(0.1065626393) + x2*(T(-0.0752896400)
+           + x2*(T(0.0429096138) + x2*(T(-0.0161657367) + x2*T(0.0028662257)))))))));
+    if (!inverted) return rv;
+    return (t > T(0) ? k_half_pi : -k_half_pi) - rv;
+}
+
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, T> atan2(T y, T x) noexcept {
+    constexpr const T k_pi = k_pi_for_type<T>;
+    if (x == T(0)) {
+        if (y == T(0)) return T(0);
+        return y > T(0) ? k_pi*T(0.5) : -k_pi*T(0.5);
+    }
+    T rv = atan(y / x);
+    if (x > T(0)) return rv;
+    return y < T(0) ? rv - k_pi : rv + k_pi;
+}
+
+template <typename T>
+std::enable_if_t<std::is_floating_point_v<T>, T> acos(T t) noexcept {
+    // Abramowitz & Stegun 4.4.46, error < 2e-8 on [0 1]
+    // acos(-t) = pi - acos(t)
+    if (t >  T(1)) t = T( 1);
+    if (t < T(-1)) t = T(-1);
+    T x = t < T(0) ? -t : t;
+    T rv = std::sqrt(T(1) - x)*(T(1.5707963050) + x*(T(-0.2145988016)
+           + x*(T(0.0889789874) + x*(T(-0.0501743046) + x*(T(0.0308918810)
+           + x*(T(-0.0170881256) + x*(T(0.0066700901) + x*T(-0.0012624911))))))));
+    return t < T(0) ? k_pi_for_type<T> - rv : rv;
+}
+
+} // end of fast namespace -> into ::cul
+
+} // end of cul namespace
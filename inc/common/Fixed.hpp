@@ -0,0 +1,450 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Util.hpp>
+
+#include <limits>
+#include <type_traits>
+#include <tuple>
+#include <algorithm>
+#include <stdexcept>
+
+#include <cstdint>
+
+namespace cul {
+
+/** A fixed point scalar, with a 32-bit signed integer underneath.
+ *
+ *  All arithmetic, including square root and trigonometry, is done with
+ *  integers. Results are therefore identical on every machine, compiler and
+ *  set of floating point flags, which makes this type suitable for lockstep
+ *  simulations.
+ *
+ *  Vector2<Fixed<...>> may be used with every function in Vector2Util.hpp.
+ *
+ *  @note There are no infinities or NaNs, overflow wraps like the underlying
+ *        integer would (so choose integer bits with care)
+ *  @tparam kt_int_bits number of integer bits, including the sign bit
+ *  @tparam kt_frac_bits number of fractional bits
+ */
+template <int kt_int_bits, int kt_frac_bits>
+class Fixed {
+public:
+    static_assert(kt_int_bits > 0 && kt_frac_bits > 0,
+                  "Fixed needs at least one bit on each side of the point.");
+    static_assert(kt_int_bits + kt_frac_bits <= 32,
+                  "Fixed may use at most 32 bits.");
+
+    using Raw  = std::int32_t;
+    using Wide = std::int64_t;
+
+    static constexpr const int k_int_bits  = kt_int_bits ;
+    static constexpr const int k_frac_bits = kt_frac_bits;
+    static constexpr const Raw k_one = Raw(1) << kt_frac_bits;
+
+    constexpr Fixed() {}
+
+    /** Converts from any arithmetic type, rounding to the nearest
+     *  representable value.
+     *
+     *  Integers too large wrap (like any other overflow), floats too large
+     *  saturate at the underlying integer's limits, and NaN becomes zero.
+     *  @note Implicit, so that literals like "0.5" may be mixed in freely.
+     *        Converting from a float is deterministic, though the float
+     *        itself may not have been.
+     */
+    template <typename U, typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+    constexpr Fixed(U u): m_raw(to_raw(u)) {}
+
+    /** @returns a fixed point number whose underlying integer is exactly
+     *           the given value
+     */
+    static constexpr Fixed from_raw(Raw raw) {
+        Fixed rv;
+        rv.m_raw = raw;
+        return rv;
+    }
+
+    constexpr Raw raw() const noexcept { return m_raw; }
+
+    template <typename U, typename = std::enable_if_t<std::is_floating_point_v<U>>>
+    explicit constexpr operator U () const noexcept
+        { return U(m_raw) / U(k_one); }
+
+    /** Truncates toward zero, like converting a float to an integer. */
+    explicit constexpr operator int () const noexcept
+        { return int(m_raw / k_one); }
+
+    constexpr Fixed operator - () const noexcept
+        { return from_raw(wrap(URaw(0) - URaw(m_raw))); }
+
+    constexpr Fixed & operator += (Fixed rhs) noexcept
+        { return *this = *this + rhs; }
+
+    constexpr Fixed & operator -= (Fixed rhs) noexcept
+        { return *this = *this - rhs; }
+
+    constexpr Fixed & operator *= (Fixed rhs) noexcept
+        { return *this = *this * rhs; }
+
+    Fixed & operator /= (Fixed rhs)
+        { return *this = *this / rhs; }
+
+    friend constexpr Fixed operator + (Fixed lhs, Fixed rhs) noexcept
+        { return from_raw(wrap(URaw(lhs.m_raw) + URaw(rhs.m_raw))); }
+
+    friend constexpr Fixed operator - (Fixed lhs, Fixed rhs) noexcept
+        { return from_raw(wrap(URaw(lhs.m_raw) - URaw(rhs.m_raw))); }
+
+    /** Rounds to nearest. */
+    friend constexpr Fixed operator * (Fixed lhs, Fixed rhs) noexcept {
+        constexpr const Wide k_half = Wide(1) << (kt_frac_bits - 1);
+        return from_raw(Raw((Wide(lhs.m_raw)*Wide(rhs.m_raw) + k_half) >> kt_frac_bits));
+    }
+
+    /** Rounds to nearest.
+     *  @throws if rhs is zero
+     */
+    friend Fixed operator / (Fixed lhs, Fixed rhs) {
+        if (rhs.m_raw == 0) {
+            throw std::invalid_argument("Fixed::operator/: division by zero.");
+        }
+        auto num   = Wide(lhs.m_raw)*Wide(k_one);
+        auto denom = Wide(rhs.m_raw);
+        // integer division truncates, so push the numerator half a
+        // denominator away from zero first
+        auto half = (denom < 0 ? -denom : denom) / 2;
+        num += (num < 0) ? -half : half;
+        return from_raw(Raw(num / denom));
+    }
+
+    friend constexpr bool operator == (Fixed lhs, Fixed rhs) noexcept
+        { return lhs.m_raw == rhs.m_raw; }
+
+    friend constexpr bool operator != (Fixed lhs, Fixed rhs) noexcept
+        { return lhs.m_raw != rhs.m_raw; }
+
+    friend constexpr bool operator <  (Fixed lhs, Fixed rhs) noexcept
+        { return lhs.m_raw <  rhs.m_raw; }
+
+    friend constexpr bool operator >  (Fixed lhs, Fixed rhs) noexcept
+        { return lhs.m_raw >  rhs.m_raw; }
+
+    friend constexpr bool operator <= (Fixed lhs, Fixed rhs) noexcept
+        { return lhs.m_raw <= rhs.m_raw; }
+
+    friend constexpr bool operator >= (Fixed lhs, Fixed rhs) noexcept
+        { return lhs.m_raw >= rhs.m_raw; }
+
+private:
+    // signed overflow is undefined, so wrapping arithmetic is done unsigned
+    using URaw  = std::uint32_t;
+    using UWide = std::uint64_t;
+
+    static constexpr Raw wrap(UWide u) noexcept {
+        // two's complement, without relying on how out of range unsigned to
+        // signed conversions are done
+        auto low = URaw(u);
+        return low > URaw(std::numeric_limits<Raw>::max())
+            ? Raw(low - URaw(std::numeric_limits<Raw>::max()) - 1) + std::numeric_limits<Raw>::min()
+            : Raw(low);
+    }
+
+    template <typename U>
+    static constexpr Raw to_raw(U u) noexcept {
+        if constexpr (std::is_floating_point_v<U>) {
+            // 2^31, exact in every floating point type
+            constexpr const U k_raw_limit = U(2147483648.);
+            // std::round is not constexpr
+            auto scaled  = u*U(k_one);
+            auto rounded = scaled + (scaled < U(0) ? U(-0.5) : U(0.5));
+            // converting anything out of range is undefined
+            if (rounded != rounded) return 0;
+            if (rounded >=  k_raw_limit) return std::numeric_limits<Raw>::max();
+            if (rounded <= -k_raw_limit) return std::numeric_limits<Raw>::min();
+            return Raw(rounded);
+        } else {
+            return wrap(UWide(u)*UWide(k_one));
+        }
+    }
+
+    Raw m_raw = 0;
+};
+
+template <typename T>
+struct IsFixed : std::false_type {};
+
+template <int kt_int_bits, int kt_frac_bits>
+struct IsFixed<Fixed<kt_int_bits, kt_frac_bits>> : std::true_type {};
+
+template <typename T>
+constexpr const bool k_is_fixed = IsFixed<T>::value;
+
+// these all match the arithmetic versions in Util.hpp, and are found by ADL
+// by Vector2Util functions
+
+template <int kt_int_bits, int kt_frac_bits>
+constexpr bool is_real(Fixed<kt_int_bits, kt_frac_bits>) noexcept { return true; }
+
+template <int kt_int_bits, int kt_frac_bits>
+constexpr bool is_nan(Fixed<kt_int_bits, kt_frac_bits>) noexcept { return false; }
+
+template <int kt_int_bits, int kt_frac_bits>
+constexpr Fixed<kt_int_bits, kt_frac_bits>
+    magnitude(Fixed<kt_int_bits, kt_frac_bits> t) noexcept
+{ return t < 0 ? -t : t; }
+
+template <int kt_int_bits, int kt_frac_bits>
+constexpr bool are_within
+    (Fixed<kt_int_bits, kt_frac_bits> a, Fixed<kt_int_bits, kt_frac_bits> b,
+     Fixed<kt_int_bits, kt_frac_bits> error) noexcept
+{ return magnitude(a - b) < error; }
+
+template <int kt_int_bits, int kt_frac_bits>
+constexpr const Fixed<kt_int_bits, kt_frac_bits>
+    k_pi_for_type<Fixed<kt_int_bits, kt_frac_bits>>
+    = Fixed<kt_int_bits, kt_frac_bits>(3.141592653589793238462643383279);
+
+/** @returns the square root, exact to the last bit (rounded down)
+ *  @throws if t is negative
+ */
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> sqrt(Fixed<kt_int_bits, kt_frac_bits> t);
+
+/** @returns sine of t, computed with CORDIC
+ *  @note error is at most a few units in the last place (of the fraction)
+ */
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> sin(Fixed<kt_int_bits, kt_frac_bits> t) noexcept;
+
+/** @returns cosine of t, computed with CORDIC */
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> cos(Fixed<kt_int_bits, kt_frac_bits> t) noexcept;
+
+/** @returns angle of the vector (x, y) in [-pi pi], computed with CORDIC
+ *  @note atan2(0, 0) is zero
+ */
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> atan2
+    (Fixed<kt_int_bits, kt_frac_bits> y, Fixed<kt_int_bits, kt_frac_bits> x) noexcept;
+
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> atan(Fixed<kt_int_bits, kt_frac_bits> t) noexcept
+    { return atan2(t, Fixed<kt_int_bits, kt_frac_bits>(1)); }
+
+/** @returns arc cosine of t, t is clamped to [-1 1] */
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> acos(Fixed<kt_int_bits, kt_frac_bits> t);
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+/** CORDIC works in signed Q32 (32 fractional bits) regardless of the
+ *  fixed point format asked for.
+ */
+class FixedCordic {
+public:
+    using Q32 = std::int64_t;
+
+    static constexpr const Q32 k_pi      = 13493037705ll;
+    static constexpr const Q32 k_half_pi = 6746518852ll;
+    static constexpr const Q32 k_two_pi  = 26986075409ll;
+
+    /** @returns (cos, sin) of angle */
+    static std::tuple<Q32, Q32> sin_cos(Q32 angle) noexcept {
+        angle %= k_two_pi;
+        if (angle >  k_pi) angle -= k_two_pi;
+        if (angle < -k_pi) angle += k_two_pi;
+        // CORDIC only converges in [-pi/2 pi/2]
+        bool flip = false;
+        if (angle > k_half_pi) {
+            angle -= k_pi;
+            flip = true;
+        } else if (angle < -k_half_pi) {
+            angle += k_pi;
+            flip = true;
+        }
+        Q32 x = k_inverse_gain, y = 0;
+        for (int i = 0; i != k_iterations; ++i) {
+            auto nx = angle >= 0 ? x - (y >> i) : x + (y >> i);
+            auto ny = angle >= 0 ? y + (x >> i) : y - (x >> i);
+            angle  += angle >= 0 ? -k_angles[i] : k_angles[i];
+            x = nx;
+            y = ny;
+        }
+        return flip ? std::make_tuple(-x, -y) : std::make_tuple(x, y);
+    }
+
+    /** @param y any scale, so long as it matches x
+     *  @param x any scale, so long as it matches y
+     *  @returns angle in Q32
+     */
+    static Q32 atan2(Q32 y, Q32 x) noexcept {
+        if (x == 0 && y == 0) return 0;
+        Q32 angle = 0;
+        if (x < 0) {
+            angle = y >= 0 ? k_pi : -k_pi;
+            x = -x;
+            y = -y;
+        }
+        // make use of as many bits as possible, leaving room for CORDIC's
+        // gain (~1.65)
+        auto biggest = std::max(x, y < 0 ? -y : y);
+        // doubled rather than shifted, as y may be negative
+        while (biggest < (Q32(1) << 59)) {
+            biggest *= 2;
+            x *= 2;
+            y *= 2;
+        }
+        for (int i = 0; i != k_iterations; ++i) {
+            auto nx = y > 0 ? x + (y >> i) : x - (y >> i);
+            auto ny = y > 0 ? y - (x >> i) : y + (x >> i);
+            angle  += y > 0 ? k_angles[i] : -k_angles[i];
+            x = nx;
+            y = ny;
+        }
+        return angle;
+    }
+
+    static Q32 to_q32(std::int32_t raw, int frac_bits) noexcept
+        { return Q32(raw)*(Q32(1) << (32 - frac_bits)); }
+
+    static std::int32_t from_q32(Q32 q, int frac_bits) noexcept {
+        auto shift = 32 - frac_bits;
+        if (shift == 0) return std::int32_t(q);
+        return std::int32_t((q + (Q32(1) << (shift - 1))) >> shift);
+    }
+
+    static std::uint64_t integer_sqrt(std::uint64_t n) noexcept {
+        std::uint64_t rv  = 0;
+        std::uint64_t bit = std::uint64_t(1) << 62;
+        while (bit > n) bit >>= 2;
+        while (bit) {
+            if (n >= rv + bit) {
+                n  -= rv + bit;
+                rv  = (rv >> 1) + bit;
+            } else {
+                rv >>= 1;
+            }
+            bit >>= 2;
+        }
+        return rv;
+    }
+
+private:
+    static constexpr const int k_iterations = 32;
+
+    // product of 1/sqrt(1 + 2^(-2i)) for all iterations
+    static constexpr const Q32 k_inverse_gain = 2608131496ll;
+
+    // atan(2^-i) in Q32
+    static constexpr const Q32 k_angles[k_iterations] = {
+        3373259426ll, 1991351318ll, 1052175346ll, 534100635ll,
+        268086748ll, 134174063ll, 67103403ll, 33553749ll,
+        16777131ll, 8388597ll, 4194303ll, 2097152ll,
+        1048576ll, 524288ll, 262144ll, 131072ll,
+        65536ll, 32768ll, 16384ll, 8192ll,
+        4096ll, 2048ll, 1024ll, 512ll,
+        256ll, 128ll, 64ll, 32ll,
+        16ll, 8ll, 4ll, 2ll
+    };
+};
+
+} // end of detail namespace -> into ::cul
+
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> sqrt(Fixed<kt_int_bits, kt_frac_bits> t) {
+    using FixedT = Fixed<kt_int_bits, kt_frac_bits>;
+    if (t < 0) {
+        throw std::invalid_argument("sqrt: cannot take the square root of a "
+                                    "negative fixed point number.");
+    }
+    // sqrt(raw / 2^f)*2^f = sqrt(raw*2^f)
+    auto n = std::uint64_t(t.raw()) << kt_frac_bits;
+    return FixedT::from_raw(
+        typename FixedT::Raw(detail::FixedCordic::integer_sqrt(n)));
+}
+
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> sin(Fixed<kt_int_bits, kt_frac_bits> t) noexcept {
+    using Cordic = detail::FixedCordic;
+    auto y = std::get<1>(Cordic::sin_cos(Cordic::to_q32(t.raw(), kt_frac_bits)));
+    return Fixed<kt_int_bits, kt_frac_bits>::from_raw(Cordic::from_q32(y, kt_frac_bits));
+}
+
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> cos(Fixed<kt_int_bits, kt_frac_bits> t) noexcept {
+    using Cordic = detail::FixedCordic;
+    auto x = std::get<0>(Cordic::sin_cos(Cordic::to_q32(t.raw(), kt_frac_bits)));
+    return Fixed<kt_int_bits, kt_frac_bits>::from_raw(Cordic::from_q32(x, kt_frac_bits));
+}
+
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> atan2
+    (Fixed<kt_int_bits, kt_frac_bits> y, Fixed<kt_int_bits, kt_frac_bits> x) noexcept
+{
+    using Cordic = detail::FixedCordic;
+    auto angle = Cordic::atan2(y.raw(), x.raw());
+    return Fixed<kt_int_bits, kt_frac_bits>::from_raw(Cordic::from_q32(angle, kt_frac_bits));
+}
+
+template <int kt_int_bits, int kt_frac_bits>
+Fixed<kt_int_bits, kt_frac_bits> acos(Fixed<kt_int_bits, kt_frac_bits> t) {
+    using FixedT = Fixed<kt_int_bits, kt_frac_bits>;
+    if (t >  FixedT(1)) t = FixedT( 1);
+    if (t < FixedT(-1)) t = FixedT(-1);
+    return atan2(sqrt(FixedT(1) - t*t), t);
+}
+
+} // end of cul namespace
+
+namespace std {
+
+template <int kt_int_bits, int kt_frac_bits>
+class numeric_limits<cul::Fixed<kt_int_bits, kt_frac_bits>> {
+    using FixedT = cul::Fixed<kt_int_bits, kt_frac_bits>;
+    static constexpr const auto k_raw_max = typename FixedT::Raw(
+        (std::int64_t(1) << (kt_int_bits + kt_frac_bits - 1)) - 1);
+public:
+    static constexpr const bool is_specialized = true;
+    static constexpr const bool is_signed      = true;
+    static constexpr const bool is_integer     = false;
+    static constexpr const bool is_exact       = true;
+    static constexpr const bool has_infinity   = false;
+    static constexpr const bool has_quiet_NaN  = false;
+    static constexpr const int  digits         = kt_int_bits + kt_frac_bits - 1;
+
+    static constexpr FixedT min() noexcept { return lowest(); }
+    static constexpr FixedT lowest() noexcept { return FixedT::from_raw(-max().raw() - 1); }
+    static constexpr FixedT max() noexcept { return FixedT::from_raw(k_raw_max); }
+    /** smallest representable difference */
+    static constexpr FixedT epsilon() noexcept { return FixedT::from_raw(1); }
+};
+
+} // end of std namespace
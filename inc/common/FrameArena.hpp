@@ -0,0 +1,139 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cul {
+
+/** A bump allocator for memory which lives for no longer than a frame.
+ *
+ *  Allocations are carved out of large blocks, deallocation is (nearly) a
+ *  no-op and reset frees everything at once. Once the arena has seen its
+ *  busiest frame, later frames make no calls to the global heap at all.
+ *
+ *  Any std::pmr container may use it, as may cul::pmr::Grid, for example:
+ *  @code
+ *  cul::FrameArena arena;
+ *  std::pmr::vector<sf::Vertex> verticies(&arena);
+ *  // ... use verticies ...
+ *  // (verticies must be gone or cleared before reset)
+ *  arena.reset();
+ *  @endcode
+ *
+ *  @note like any memory resource, a single arena is not thread safe, worker
+ *        threads should allocate from local_arena() instead
+ *  @note unless NDEBUG is defined (as with assert), all freed memory is
+ *        overwritten with k_poison_byte on reset, so that use after reset is
+ *        easier to spot
+ */
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    static constexpr const std::size_t k_default_block_size = 1024*1024;
+    static constexpr const unsigned char k_poison_byte = 0xCD;
+
+    /** @param block_size size in bytes of each block taken from the global
+     *         heap
+     *  @param can_grow if false, running out of the first block throws
+     *         std::bad_alloc rather than taking another block
+     */
+    explicit FrameArena
+        (std::size_t block_size = k_default_block_size, bool can_grow = true);
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena & operator = (const FrameArena &) = delete;
+
+    ~FrameArena() override;
+
+    /** Frees all memory allocated from this arena and every local arena
+     *  since the last reset.
+     *
+     *  If the arena grew past its first block, the blocks are merged into
+     *  one large enough for the whole frame. Otherwise this is O(1) (plus the
+     *  local arenas), and no heap calls are made.
+     *
+     *  @warning nothing may still be using memory from this arena, and no
+     *           other thread may be allocating from its local arenas
+     */
+    void reset();
+
+    /** @returns an arena owned by this one, for the calling thread only
+     *
+     *  Local arenas are created on first use, and reset along with this
+     *  arena.
+     */
+    FrameArena & local_arena();
+
+    /** @returns bytes handed out since the last reset (including padding for
+     *           alignment), not counting local arenas
+     */
+    std::size_t bytes_in_use() const noexcept;
+
+    /** @returns total size of all blocks held by this arena */
+    std::size_t capacity() const noexcept;
+
+    /** @returns number of blocks held by this arena */
+    std::size_t block_count() const noexcept { return m_blocks.size(); }
+
+private:
+    struct Block {
+        std::byte * data;
+        std::size_t size;
+    };
+
+    static constexpr const std::size_t k_block_alignment = alignof(std::max_align_t);
+
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void *, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource &) const noexcept override;
+
+    /** @returns nullptr if the request does not fit in the current block */
+    void * bump(std::size_t bytes, std::size_t alignment) noexcept;
+
+    void push_block(std::size_t size);
+
+    void free_blocks() noexcept;
+
+    std::vector<Block> m_blocks;
+    std::size_t m_position = 0; // offset into the last (current) block
+    std::size_t m_block_size;
+    bool m_can_grow;
+
+    std::uint64_t m_id;
+    std::mutex m_locals_mutex;
+    std::vector<std::unique_ptr<FrameArena>> m_locals;
+};
+
+} // end of cul namespace
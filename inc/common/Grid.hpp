@@ -30,29 +30,40 @@
 #include <stdexcept>
 #include <utility>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 
 #include <common/Vector2.hpp>
+#include <common/Metrics.hpp>
 
 namespace cul {
 
 /** Container class meant to be like std::vector but laid out in two
  *  diminsions.
+ *
+ *  @tparam Allocator same as std::vector's, see cul::pmr::Grid for a grid
+ *          using polymorphic allocators (like FrameArena)
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Grid {
 public:
-    using Iterator           = typename std::vector<T>::iterator       ;
-    using ConstIterator      = typename std::vector<T>::const_iterator ;
-    using Element            = typename std::vector<T>::value_type     ;
-    using ReferenceType      = typename std::vector<T>::reference      ;
+    using ElementContainer   = std::vector<T, Allocator>;
+    using Iterator           = typename ElementContainer::iterator       ;
+    using ConstIterator      = typename ElementContainer::const_iterator ;
+    using Element            = typename ElementContainer::value_type     ;
+    using ReferenceType      = typename ElementContainer::reference      ;
     using IndexType          = int;
-    using ConstReferenceType = typename std::vector<T>::const_reference;
+    using ConstReferenceType = typename ElementContainer::const_reference;
     using Vector             = Vector2<IndexType>;
     using Size               = Size2<IndexType>;
+    using AllocatorType      = Allocator;
 
 
     Grid() {}
-    explicit Grid(std::initializer_list<std::initializer_list<T>>);
+    explicit Grid(const Allocator & alloc): m_elements(alloc) {}
+    explicit Grid(std::initializer_list<std::initializer_list<T>>,
+                  const Allocator & = Allocator());
     Grid(const Grid &) = default;
     Grid(Grid &&) = default;
     ~Grid() {}
@@ -166,11 +177,13 @@ public:
     
     void clear() { m_elements.clear(); }
 
-    void swap(Grid<T> &) noexcept;
+    void swap(Grid &) noexcept;
     
     /** same behavior as std::vector<T>::empty */
     bool is_empty() const noexcept;
 
+    Allocator get_allocator() const { return m_elements.get_allocator(); }
+
 protected:
     ReferenceType      element(int x, int y);
     ConstReferenceType element(int x, int y) const;
@@ -184,14 +197,18 @@ private:
 
     std::invalid_argument make_out_of_range_error() const noexcept;
 
-    std::vector<T> m_elements;
+    ElementContainer m_elements;
     int m_width = 0;
 };
 
 // ----------------------------------------------------------------------------
 
-template <typename T>
-Grid<T>::Grid(std::initializer_list<std::initializer_list<T>> init_list) {
+template <typename T, typename Allocator>
+Grid<T, Allocator>::Grid
+    (std::initializer_list<std::initializer_list<T>> init_list,
+     const Allocator & alloc):
+    m_elements(alloc)
+{
     static constexpr const int k_uninit = -1;
     int width_ = k_uninit;
     for (const auto & inner_list : init_list) {
@@ -212,72 +229,81 @@ Grid<T>::Grid(std::initializer_list<std::initializer_list<T>> init_list) {
     m_width = width_;
 }
 
-template <typename T>
-int Grid<T>::width() const noexcept { return m_width; }
+template <typename T, typename Allocator>
+int Grid<T, Allocator>::width() const noexcept { return m_width; }
 
-template <typename T>
-int Grid<T>::height() const noexcept
+template <typename T, typename Allocator>
+int Grid<T, Allocator>::height() const noexcept
     { return (m_elements.empty()) ? 0 : int(m_elements.size()) / m_width; }
 
-template <typename T>
-void Grid<T>::set_width(int width_, Element && obj)
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::set_width(int width_, Element && obj)
     { set_size(width_, height(), std::move(obj)); }
 
-template <typename T>
-void Grid<T>::set_width(int width_, const Element & obj)
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::set_width(int width_, const Element & obj)
     { set_size(width_, height(), obj); }
 
-template <typename T>
-void Grid<T>::set_height(int height_, Element && obj)
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::set_height(int height_, Element && obj)
     { set_size(width(), height_, std::move(obj)); }
 
-template <typename T>
-void Grid<T>::set_height(int height_, const Element & obj)
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::set_height(int height_, const Element & obj)
     { set_size(width(), height_, obj); }
 
-template <typename T>
-void Grid<T>::set_size(int width_, int height_, Element && obj)
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::set_size(int width_, int height_, Element && obj)
     { set_size(width_, height_, std::cref(obj)); }
 
-template <typename T>
-void Grid<T>::set_size(int width_, int height_, const Element & obj) {
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::set_size(int width_, int height_, const Element & obj) {
     if (width_ < 0 || height_ < 0) {
         throw std::invalid_argument("Grid::set_size: both dimensions must be non-negative integers.");
     }
+    auto old_capacity = m_elements.capacity();
     m_elements.resize(std::size_t(width_*height_), obj);
     m_width = width_;
+    auto & metrics = builtin_metrics();
+    metrics.grid_resizes.add();
+    if (old_capacity != m_elements.capacity()) metrics.grid_allocations.add();
 }
 
-template <typename T>
-void Grid<T>::reserve(std::size_t n) { m_elements.reserve(n); }
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::reserve(std::size_t n) {
+    auto old_capacity = m_elements.capacity();
+    m_elements.reserve(n);
+    if (old_capacity != m_elements.capacity())
+        { builtin_metrics().grid_allocations.add(); }
+}
 
-template <typename T>
-typename Grid<T>::ReferenceType Grid<T>::operator ()(const Vector & r)
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::ReferenceType Grid<T, Allocator>::operator ()(const Vector & r)
     { return element(r); }
 
-template <typename T>
-typename Grid<T>::ConstReferenceType
-    Grid<T>::operator () (const Vector & r) const
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::ConstReferenceType
+    Grid<T, Allocator>::operator () (const Vector & r) const
     { return element(r); }
 
-template <typename T>
-typename Grid<T>::ReferenceType Grid<T>::operator () (int x, int y)
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::ReferenceType Grid<T, Allocator>::operator () (int x, int y)
     { return element(x, y); }
 
-template <typename T>
-typename Grid<T>::ConstReferenceType Grid<T>::operator () (int x, int y) const
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::ConstReferenceType Grid<T, Allocator>::operator () (int x, int y) const
     { return element(x, y); }
 
-template <typename T>
-bool Grid<T>::has_position(int x, int y) const noexcept
+template <typename T, typename Allocator>
+bool Grid<T, Allocator>::has_position(int x, int y) const noexcept
     { return x >= 0 && y >= 0 && x < width() && y < height(); }
 
-template <typename T>
-bool Grid<T>::has_position(const Vector & r) const noexcept
+template <typename T, typename Allocator>
+bool Grid<T, Allocator>::has_position(const Vector & r) const noexcept
     { return has_position(r.x, r.y); }
 
-template <typename T>
-typename Grid<T>::Vector Grid<T>::next(const Vector & r) const noexcept {
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::Vector Grid<T, Allocator>::next(const Vector & r) const noexcept {
     // possible invalid argument (r is out of range)
     auto pos = r;
     if (++pos.x == width()) {
@@ -287,12 +313,12 @@ typename Grid<T>::Vector Grid<T>::next(const Vector & r) const noexcept {
     return pos;
 }
 
-template <typename T>
-typename Grid<T>::Vector Grid<T>::end_position() const noexcept
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::Vector Grid<T, Allocator>::end_position() const noexcept
     { return Vector(0, height()); }
 
-template <typename T>
-typename Grid<T>::Vector Grid<T>::position_of(ConstIterator itr) const {
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::Vector Grid<T, Allocator>::position_of(ConstIterator itr) const {
     if (is_empty() ? true : itr < begin() || itr > end()) {
         throw std::out_of_range("Grid::position_of: positions are only "
                                 "findable for iterators contained in this "
@@ -301,8 +327,8 @@ typename Grid<T>::Vector Grid<T>::position_of(ConstIterator itr) const {
     return to_position(std::ptrdiff_t(size()) - (end() - itr));
 }
 
-template <typename T>
-typename Grid<T>::Vector Grid<T>::position_of(const Element & obj) const {
+template <typename T, typename Allocator>
+typename Grid<T, Allocator>::Vector Grid<T, Allocator>::position_of(const Element & obj) const {
     static constexpr const char * const k_oor_msg = "Grid::position_of: "
         "positions are only findable for references contained in this "
         "container.";
@@ -320,56 +346,66 @@ typename Grid<T>::Vector Grid<T>::position_of(const Element & obj) const {
     }
 }
 
-template <typename T>
-void Grid<T>::swap(Grid<T> & other) noexcept {
+template <typename T, typename Allocator>
+void Grid<T, Allocator>::swap(Grid & other) noexcept {
     m_elements.swap(other.m_elements);
     std::swap(m_width, other.m_width);
 }
 
-template <typename T>
-bool Grid<T>::is_empty() const noexcept { return m_elements.empty(); }
+template <typename T, typename Allocator>
+bool Grid<T, Allocator>::is_empty() const noexcept { return m_elements.empty(); }
 
-template <typename T>
-/* protected */ typename Grid<T>::ReferenceType Grid<T>::element(int x, int y) {
+template <typename T, typename Allocator>
+/* protected */ typename Grid<T, Allocator>::ReferenceType Grid<T, Allocator>::element(int x, int y) {
     if (!has_position(x, y)) throw make_out_of_range_error();
     return m_elements[to_index(x, y)];
 }
 
-template <typename T>
-/* protected */ typename Grid<T>::ConstReferenceType
-    Grid<T>::element(int x, int y) const
+template <typename T, typename Allocator>
+/* protected */ typename Grid<T, Allocator>::ConstReferenceType
+    Grid<T, Allocator>::element(int x, int y) const
 {
     if (!has_position(x, y)) throw make_out_of_range_error();
     return m_elements[to_index(x, y)];
 }
 
-template <typename T>
-/* protected */ typename Grid<T>::ReferenceType
-    Grid<T>::element(const Vector & r)
+template <typename T, typename Allocator>
+/* protected */ typename Grid<T, Allocator>::ReferenceType
+    Grid<T, Allocator>::element(const Vector & r)
     { return element(r.x, r.y); }
 
-template <typename T>
-/* protected */ typename Grid<T>::ConstReferenceType
-    Grid<T>::element(const Vector & r) const
+template <typename T, typename Allocator>
+/* protected */ typename Grid<T, Allocator>::ConstReferenceType
+    Grid<T, Allocator>::element(const Vector & r) const
     { return element(r.x, r.y); }
 
 // keep these two functions together so that index/position conversion stays 
 // consistent
 
-template <typename T>
-/* private */ std::size_t Grid<T>::to_index(int x, int y) const noexcept
+template <typename T, typename Allocator>
+/* private */ std::size_t Grid<T, Allocator>::to_index(int x, int y) const noexcept
     { return std::size_t(x + y*width()); }
 
-template <typename T>
-/* private */ typename Grid<T>::Vector Grid<T>::to_position
+template <typename T, typename Allocator>
+/* private */ typename Grid<T, Allocator>::Vector Grid<T, Allocator>::to_position
     (std::ptrdiff_t r) const noexcept
 { return Vector(r % width(), r / width()); }
 
-template <typename T>
-/* private */ std::invalid_argument Grid<T>::make_out_of_range_error() const noexcept {
+template <typename T, typename Allocator>
+/* private */ std::invalid_argument Grid<T, Allocator>::make_out_of_range_error() const noexcept {
+    // only ever made to be thrown
+    builtin_metrics().bounds_check_throws.add();
     return std::invalid_argument("Grid::element: requested element is out of range, "
                                  "field size: width " + std::to_string(width()) +
                                  " height " + std::to_string(height()));
 }
 
+namespace pmr {
+
+/** Grid using a polymorphic allocator (e.g. with a FrameArena) */
+template <typename T>
+using Grid = cul::Grid<T, std::pmr::polymorphic_allocator<T>>;
+
+} // end of pmr namespace -> into ::cul
+
 } // end of cul namespace
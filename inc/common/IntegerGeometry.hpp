@@ -0,0 +1,302 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Util.hpp>
+
+#include <type_traits>
+
+#include <cstdint>
+#include <cassert>
+
+namespace cul {
+
+namespace detail {
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef          __int128 WideInt;
+__extension__ typedef unsigned __int128 WideUInt;
+#endif
+
+template <typename T>
+constexpr const bool k_is_exact_integer
+    = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+/** find_intersection for integer vectors, with the point rounded to the
+ *  nearest integers (throws without 128 bit integers).
+ *  @returns false if there is no intersection
+ */
+template <typename T>
+bool find_integer_intersection
+    (const Vector2<T> & a_first, const Vector2<T> & a_second,
+     const Vector2<T> & b_first, const Vector2<T> & b_second, Vector2<T> & out);
+
+} // end of detail namespace -> into ::cul
+
+#ifdef __SIZEOF_INT128__
+
+/** @defgroup integer_geometry Exact integer predicates
+ *
+ *  Geometric predicates on integer vectors, computed with wide (128 bit)
+ *  integers so that they are never rounded: no conversion to floating point,
+ *  and no results that depend on rounding.
+ *
+ *  Exact for 32 bit (and smaller) coordinates. For 64 bit coordinates, all
+ *  are exact for coordinates within 2^61 in magnitude.
+ *
+ *  Requires a compiler with 128 bit integers (GCC and Clang on 64 bit
+ *  platforms).
+ *
+ *  @{
+ */
+
+/** @returns 1 if c is to the left of (counter clockwise from) the directed
+ *           line from a to b, -1 if to the right, and 0 if all three are
+ *           collinear (in a y-up coordinate system)
+ */
+template <typename T>
+int orientation_of(const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c);
+
+/** @returns 1 if d is inside the circle through a, b, and c, -1 if outside,
+ *           and 0 if on it (a, b, and c must be counter clockwise, for
+ *           clockwise the sign is reversed)
+ */
+template <typename T>
+int incircle_of
+    (const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c,
+     const Vector2<T> & d);
+
+/** @returns true if segments a and b intersect, on the same terms as
+ *           find_intersection: touching end points do intersect, parallel
+ *           and collinear segments do not
+ */
+template <typename T>
+bool do_segments_intersect
+    (const Vector2<T> & a_first, const Vector2<T> & a_second,
+     const Vector2<T> & b_first, const Vector2<T> & b_second);
+
+/** @} */
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename T>
+void verify_exact_integer() {
+    static_assert(k_is_exact_integer<T>,
+                  "Exact integer predicates need integer coordinates of at "
+                  "most 64 bits.");
+}
+
+template <typename T>
+WideInt wide_cross
+    (const Vector2<T> & o, const Vector2<T> & a, const Vector2<T> & b) noexcept
+{
+    WideInt ax = WideInt(a.x) - o.x, ay = WideInt(a.y) - o.y;
+    WideInt bx = WideInt(b.x) - o.x, by = WideInt(b.y) - o.y;
+    return ax*by - ay*bx;
+}
+
+inline int sign_of(WideInt x) noexcept { return (x > 0) - (x < 0); }
+
+/** A 256 bit two's complement integer, just wide enough for sums of products
+ *  of two WideInts (as incircle needs).
+ */
+struct DoubleWideInt final {
+    WideUInt high = 0, low = 0;
+};
+
+inline DoubleWideInt operator + (const DoubleWideInt & lhs, const DoubleWideInt & rhs) noexcept {
+    DoubleWideInt rv;
+    rv.low  = lhs.low + rhs.low;
+    rv.high = lhs.high + rhs.high + WideUInt(rv.low < lhs.low);
+    return rv;
+}
+
+inline DoubleWideInt operator - (const DoubleWideInt & x) noexcept {
+    DoubleWideInt rv;
+    rv.low  = ~x.low + 1;
+    rv.high = ~x.high + WideUInt(rv.low == 0);
+    return rv;
+}
+
+inline DoubleWideInt operator - (const DoubleWideInt & lhs, const DoubleWideInt & rhs) noexcept
+    { return lhs + -rhs; }
+
+/** @returns a*b, which never overflows */
+inline DoubleWideInt double_wide_product(WideInt a, WideInt b) noexcept {
+    // schoolbook multiplication of magnitudes, in 64 bit halves
+    static constexpr const WideUInt k_half_mask = ~std::uint64_t(0);
+    WideUInt ua = a < 0 ? WideUInt(0) - WideUInt(a) : WideUInt(a);
+    WideUInt ub = b < 0 ? WideUInt(0) - WideUInt(b) : WideUInt(b);
+    WideUInt a_hi = ua >> 64, a_lo = ua & k_half_mask;
+    WideUInt b_hi = ub >> 64, b_lo = ub & k_half_mask;
+    WideUInt lo_lo = a_lo*b_lo, lo_hi = a_lo*b_hi, hi_lo = a_hi*b_lo;
+    WideUInt mid = (lo_lo >> 64) + (lo_hi & k_half_mask) + (hi_lo & k_half_mask);
+    DoubleWideInt rv;
+    rv.low  = (lo_lo & k_half_mask) | (mid << 64);
+    rv.high = a_hi*b_hi + (lo_hi >> 64) + (hi_lo >> 64) + (mid >> 64);
+    return (a < 0) != (b < 0) ? -rv : rv;
+}
+
+inline int sign_of(const DoubleWideInt & x) noexcept {
+    if (x.high >> 127) return -1;
+    return (x.high | x.low) != 0;
+}
+
+/** Parameters of the intersection of segments p to p + r and q to q + s, as
+ *  fractions with a shared, positive denominator.
+ *  @returns false if the segments do not intersect
+ */
+template <typename T>
+bool find_intersection_parameters
+    (const Vector2<T> & a_first, const Vector2<T> & a_second,
+     const Vector2<T> & b_first, const Vector2<T> & b_second,
+     WideInt & t_num, WideInt & denom) noexcept
+{
+    // same method as for floating point: p + t*r = q + u*s
+    WideInt r_x = WideInt(a_second.x) - a_first.x;
+    WideInt r_y = WideInt(a_second.y) - a_first.y;
+    WideInt s_x = WideInt(b_second.x) - b_first.x;
+    WideInt s_y = WideInt(b_second.y) - b_first.y;
+    WideInt q_sub_p_x = WideInt(b_first.x) - a_first.x;
+    WideInt q_sub_p_y = WideInt(b_first.y) - a_first.y;
+    denom = r_x*s_y - r_y*s_x;
+    if (denom == 0) return false;
+    t_num = q_sub_p_x*s_y - q_sub_p_y*s_x;
+    WideInt u_num = q_sub_p_x*r_y - q_sub_p_y*r_x;
+    if (denom < 0) {
+        denom = -denom;
+        t_num = -t_num;
+        u_num = -u_num;
+    }
+    return t_num >= 0 && t_num <= denom && u_num >= 0 && u_num <= denom;
+}
+
+/** @returns num*m / denom rounded to the nearest integer (halves away from
+ *           zero), for 0 <= num <= denom and denom positive, without
+ *           overflowing (num*m may be far too wide for 128 bits)
+ */
+inline WideInt scale_and_round(WideInt num, WideInt m, WideInt denom) noexcept {
+    assert(num >= 0 && num <= denom && denom > 0);
+    WideUInt unum = WideUInt(num), udenom = WideUInt(denom);
+    WideUInt um = m < 0 ? WideUInt(-m) : WideUInt(m);
+    // long multiplication by each bit of m, keeping only the remainder
+    // (always less than denom) and quotient
+    WideUInt quot = 0, rem = 0;
+    for (int bit = 127; bit >= 0; --bit) {
+        if ((um >> bit) == 0 && quot == 0 && rem == 0) continue;
+        quot <<= 1;
+        rem  <<= 1;
+        if ((um >> bit) & 1) rem += unum;
+        while (rem >= udenom) {
+            rem -= udenom;
+            ++quot;
+        }
+    }
+    if (rem*2 >= udenom) ++quot;
+    return m < 0 ? -WideInt(quot) : WideInt(quot);
+}
+
+template <typename T>
+bool find_integer_intersection
+    (const Vector2<T> & a_first, const Vector2<T> & a_second,
+     const Vector2<T> & b_first, const Vector2<T> & b_second, Vector2<T> & out)
+{
+    verify_exact_integer<T>();
+    WideInt t_num, denom;
+    if (!find_intersection_parameters(a_first, a_second, b_first, b_second, t_num, denom))
+        return false;
+    // the point is between a's end points, so it always fits T
+    out.x = T(a_first.x + scale_and_round(t_num, WideInt(a_second.x) - a_first.x, denom));
+    out.y = T(a_first.y + scale_and_round(t_num, WideInt(a_second.y) - a_first.y, denom));
+    return true;
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+int orientation_of(const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c) {
+    detail::verify_exact_integer<T>();
+    return detail::sign_of(detail::wide_cross(a, b, c));
+}
+
+template <typename T>
+int incircle_of
+    (const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c,
+     const Vector2<T> & d)
+{
+    using detail::WideInt;
+    detail::verify_exact_integer<T>();
+    // | ax - dx  ay - dy  (ax - dx)^2 + (ay - dy)^2 |
+    // | bx - dx  by - dy  ...                       |
+    // | cx - dx  cy - dy  ...                       |
+    WideInt ax = WideInt(a.x) - d.x, ay = WideInt(a.y) - d.y;
+    WideInt bx = WideInt(b.x) - d.x, by = WideInt(b.y) - d.y;
+    WideInt cx = WideInt(c.x) - d.x, cy = WideInt(c.y) - d.y;
+    WideInt a_lift = ax*ax + ay*ay;
+    WideInt b_lift = bx*bx + by*by;
+    WideInt c_lift = cx*cx + cy*cy;
+    // lifts and crosses fit 128 bits, their products may not
+    using detail::double_wide_product;
+    return detail::sign_of(
+          double_wide_product(a_lift, bx*cy - by*cx)
+        - double_wide_product(b_lift, ax*cy - ay*cx)
+        + double_wide_product(c_lift, ax*by - ay*bx));
+}
+
+template <typename T>
+bool do_segments_intersect
+    (const Vector2<T> & a_first, const Vector2<T> & a_second,
+     const Vector2<T> & b_first, const Vector2<T> & b_second)
+{
+    detail::verify_exact_integer<T>();
+    detail::WideInt t_num, denom;
+    return detail::find_intersection_parameters
+        (a_first, a_second, b_first, b_second, t_num, denom);
+}
+
+#else
+
+namespace detail {
+
+template <typename T>
+bool find_integer_intersection
+    (const Vector2<T> &, const Vector2<T> &, const Vector2<T> &,
+     const Vector2<T> &, Vector2<T> &)
+{
+    using namespace exceptions_abbr;
+    throw RtError("find_intersection: finding intersections on integer "
+                  "vectors needs a compiler with 128 bit integers.");
+}
+
+} // end of detail namespace -> into ::cul
+
+#endif
+
+} // end of cul namespace
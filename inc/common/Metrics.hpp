@@ -0,0 +1,256 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <utility>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace cul {
+
+namespace detail {
+
+/** @returns which shard the calling thread should use for sharded counters
+ *  (threads are handed shards round-robin on first use)
+ */
+inline std::size_t metrics_shard_index() noexcept;
+
+} // end of detail namespace -> into ::cul
+
+/** A counter cheap enough to always leave on.
+ *
+ *  Increments go to one of several cache line sized shards, picked by the
+ *  calling thread, so that threads do not fight over the same cache line.
+ *  Shards are summed on read.
+ *
+ *  Counters are constant initialized, so they may be used at any point in a
+ *  program's life (including from other static initializers).
+ */
+class Counter final {
+public:
+    static constexpr const std::size_t k_shard_count = 16;
+
+    constexpr Counter() noexcept {}
+
+    Counter(const Counter &) = delete;
+    Counter & operator = (const Counter &) = delete;
+
+    void add(std::uint64_t n = 1) noexcept {
+        m_shards[detail::metrics_shard_index()].value
+            .fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** @returns sum over all shards (not a snapshot, if other threads are
+     *           still adding)
+     */
+    std::uint64_t value() const noexcept {
+        std::uint64_t sum = 0;
+        for (const auto & shard : m_shards)
+            { sum += shard.value.load(std::memory_order_relaxed); }
+        return sum;
+    }
+
+    void reset() noexcept {
+        for (auto & shard : m_shards)
+            { shard.value.store(0, std::memory_order_relaxed); }
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value = 0;
+    };
+
+    Shard m_shards[k_shard_count];
+};
+
+namespace detail {
+
+// inline, so that header only users of counters (like Grid) need not link
+// anything
+inline std::size_t metrics_shard_index() noexcept {
+    static std::atomic<std::size_t> s_next_shard = 0;
+    thread_local const std::size_t t_shard
+        = s_next_shard.fetch_add(1, std::memory_order_relaxed) % Counter::k_shard_count;
+    return t_shard;
+}
+
+} // end of detail namespace -> into ::cul
+
+/** A histogram of non-negative integer values (typically nanoseconds) with
+ *  logarithmic buckets, in the manner of HDR histograms.
+ *
+ *  Each power of two is split into k_sub_bucket_count linear buckets, so a
+ *  value read back is within 1/k_sub_bucket_count (6.25%) of what was
+ *  recorded, whatever its magnitude. Values below k_sub_bucket_count are
+ *  kept exactly.
+ */
+class Histogram final {
+public:
+    static constexpr const int k_sub_bucket_bits  = 4;
+    static constexpr const int k_sub_bucket_count = 1 << k_sub_bucket_bits;
+    static constexpr const int k_bucket_count
+        = (64 - k_sub_bucket_bits + 1)*k_sub_bucket_count;
+
+    constexpr Histogram() noexcept {}
+
+    Histogram(const Histogram &) = delete;
+    Histogram & operator = (const Histogram &) = delete;
+
+    void record(std::uint64_t value) noexcept;
+
+    std::uint64_t count() const noexcept;
+
+    std::uint64_t sum() const noexcept
+        { return m_sum.load(std::memory_order_relaxed); }
+
+    std::uint64_t max() const noexcept
+        { return m_max.load(std::memory_order_relaxed); }
+
+    /** @returns the highest value in the bucket where fraction (in [0 1]) of
+     *           all recorded values have been seen, or zero if empty
+     */
+    std::uint64_t value_at(double fraction) const noexcept;
+
+    void reset() noexcept;
+
+    static int bucket_of(std::uint64_t value) noexcept;
+
+    /** @returns lowest value that falls into the given bucket */
+    static std::uint64_t lowest_in_bucket(int bucket) noexcept;
+
+    /** @returns highest value that falls into the given bucket */
+    static std::uint64_t highest_in_bucket(int bucket) noexcept;
+
+private:
+    std::atomic<std::uint64_t> m_buckets[k_bucket_count] = {};
+    std::atomic<std::uint64_t> m_sum = 0;
+    std::atomic<std::uint64_t> m_max = 0;
+};
+
+/** Records the time (in nanoseconds) between its construction and
+ *  destruction into a histogram.
+ */
+class ScopedLatency final {
+public:
+    explicit ScopedLatency(Histogram & histogram) noexcept:
+        m_histogram(histogram),
+        m_start(std::chrono::steady_clock::now())
+    {}
+
+    ScopedLatency(const ScopedLatency &) = delete;
+    ScopedLatency & operator = (const ScopedLatency &) = delete;
+
+    ~ScopedLatency() {
+        using namespace std::chrono;
+        auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - m_start);
+        m_histogram.record(std::uint64_t(elapsed.count()));
+    }
+
+private:
+    Histogram & m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/** Counters and histograms kept by the library itself. */
+struct BuiltinMetrics final {
+    Counter grid_allocations;
+    Counter grid_resizes;
+    Counter bounds_check_throws;
+    Counter text_verticies;
+    Counter line_verticies;
+    Counter string_to_number_failures;
+    Histogram task_graph_run_ns;
+};
+
+/** @returns the library's own metrics */
+inline BuiltinMetrics & builtin_metrics() noexcept {
+    // constant initialized, no guard needed
+    static BuiltinMetrics inst;
+    return inst;
+}
+
+/** Values of every metric at some point in time. */
+struct MetricsSnapshot final {
+    struct HistogramSummary {
+        std::string name;
+        std::uint64_t count = 0, sum = 0, max = 0;
+        std::uint64_t p50 = 0, p90 = 0, p99 = 0;
+    };
+
+    std::vector<std::pair<std::string, std::uint64_t>> counters;
+    std::vector<HistogramSummary> histograms;
+};
+
+/** Owns named counters and histograms, and collects everything (including
+ *  builtin_metrics()) into snapshots.
+ */
+class MetricsRegistry final {
+public:
+    static MetricsRegistry & instance();
+
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry & operator = (const MetricsRegistry &) = delete;
+
+    /** @returns counter of the given name, created on first request
+     *  @note the reference stays valid for the life of the program, look it
+     *        up once and keep it, rather than on every increment
+     */
+    Counter & counter(const std::string & name);
+
+    /** @returns histogram of the given name, created on first request
+     *  @note same as counter
+     */
+    Histogram & histogram(const std::string & name);
+
+    /** @returns all metrics, sorted by name */
+    MetricsSnapshot snapshot() const;
+
+    /** Resets every metric to zero. */
+    void reset();
+
+private:
+    MetricsRegistry() {}
+
+    struct Impl;
+    Impl & impl() const;
+};
+
+/** Writes one line per metric, "name value" for counters and
+ *  "name count=... p50=..." for histograms.
+ */
+void write_text(std::ostream &, const MetricsSnapshot &);
+
+/** Writes a single JSON object with "counters" and "histograms" members. */
+void write_json(std::ostream &, const MetricsSnapshot &);
+
+} // end of cul namespace
@@ -0,0 +1,351 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/SegmentIntersection.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace cul {
+
+/** The nearest segment of a sequence to some point. */
+template <typename T>
+struct NearestSegment {
+    static constexpr const std::size_t k_no_segment = std::size_t(-1);
+
+    /** index into the sequence, k_no_segment if there are no (real)
+     *  segments
+     */
+    std::size_t index = k_no_segment;
+    /** closest point on that segment */
+    Vector2<T> point = get_no_solution_sentinel<Vector2<T>>();
+    T distance_squared = std::numeric_limits<T>::infinity();
+};
+
+/** A prebuilt bounding volume hierarchy over a sequence of segments, for
+ *  finding nearest segments many times over with the same segments.
+ *
+ *  Segments are copied and sorted into leaves of a few segments each, split
+ *  at the median so that the tree is always balanced. Nearest searches visit
+ *  the nearer child first, and skip any box further than the nearest segment
+ *  found so far.
+ */
+template <typename T>
+class SegmentIndex final {
+public:
+    static_assert(std::is_floating_point_v<T>,
+                  "SegmentIndex: T must be a floating point type.");
+
+    SegmentIndex() {}
+
+    /** @throws if any component of any segment is not a real number */
+    SegmentIndex(const LineSegment<T> * first, const LineSegment<T> * last)
+        { assign(first, last); }
+
+    explicit SegmentIndex(const std::vector<LineSegment<T>> & segments):
+        SegmentIndex(segments.data(), segments.data() + segments.size())
+    {}
+
+    /** Rebuilds the index from a new sequence of segments.
+     *  @throws if any component of any segment is not a real number
+     */
+    void assign(const LineSegment<T> * first, const LineSegment<T> * last);
+
+    /** @returns nearest segment to the point, with its index into the
+     *           sequence this was built from
+     *  @throws if any component of the point is not a real number
+     */
+    NearestSegment<T> find_nearest(const Vector2<T> &) const;
+
+    std::size_t size() const noexcept { return m_indices.size(); }
+
+    bool is_empty() const noexcept { return m_indices.empty(); }
+
+private:
+    static constexpr const std::size_t k_leaf_size = 8;
+    // a balanced tree this deep could hold more segments than memory
+    static constexpr const std::size_t k_max_depth = 64;
+
+    struct Node {
+        T low_x, low_y, high_x, high_y;
+        // range into m_segments
+        std::size_t begin, end;
+        // the left child always immediately follows its parent, zero for
+        // leaves
+        std::size_t right_child;
+    };
+
+    std::size_t build(std::size_t begin, std::size_t end);
+
+    T distance_squared_to(const Node &, const Vector2<T> &) const noexcept;
+
+    std::vector<Node> m_nodes;
+    std::vector<LineSegment<T>> m_segments;
+    std::vector<std::size_t> m_indices;
+};
+
+/** Finds the nearest segment to a point by testing every segment.
+ *
+ *  The closest point on each segment is found by projecting and clamping
+ *  (without trig or square roots). Segments are measured in blocks with a
+ *  loop free of branches, so that the compiler may run it several segments at
+ *  a time.
+ *
+ *  Ties go to the lowest index; segments with non real components are never
+ *  nearest.
+ *  @throws if any component of the point is not a real number
+ */
+template <typename T>
+NearestSegment<T> nearest_segment
+    (const Vector2<T> & point, const LineSegment<T> * first,
+     const LineSegment<T> * last);
+
+template <typename T>
+NearestSegment<T> nearest_segment
+    (const Vector2<T> & point, const std::vector<LineSegment<T>> & segments)
+{ return nearest_segment(point, segments.data(), segments.data() + segments.size()); }
+
+/** Finds the nearest segment to a point using a prebuilt index, which is
+ *  much faster for many segments.
+ *
+ *  Unlike the linear search, any one of several equally near segments may be
+ *  found.
+ *  @throws if any component of the point is not a real number
+ */
+template <typename T>
+NearestSegment<T> nearest_segment
+    (const Vector2<T> & point, const SegmentIndex<T> & index)
+{ return index.find_nearest(point); }
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+/** @returns the parameter (0 to 1) along a segment from a to b of the
+ *           closest point to p
+ */
+template <typename T>
+T closest_parameter_on_segment
+    (T p_x, T p_y, T a_x, T a_y, T b_x, T b_y) noexcept
+{
+    T ab_x = b_x - a_x;
+    T ab_y = b_y - a_y;
+    T num   = (p_x - a_x)*ab_x + (p_y - a_y)*ab_y;
+    // for a point segment, num is also zero
+    T denom = std::max(ab_x*ab_x + ab_y*ab_y, std::numeric_limits<T>::min());
+    return std::min(std::max(num / denom, T(0)), T(1));
+}
+
+template <typename T>
+T distance_squared_to_segment
+    (T p_x, T p_y, const LineSegment<T> & segment) noexcept
+{
+    const auto & a = segment.a;
+    const auto & b = segment.b;
+    T t = closest_parameter_on_segment(p_x, p_y, a.x, a.y, b.x, b.y);
+    T d_x = a.x + t*(b.x - a.x) - p_x;
+    T d_y = a.y + t*(b.y - a.y) - p_y;
+    return d_x*d_x + d_y*d_y;
+}
+
+/** Linear nearest segment search, shared by nearest_segment and leaves of
+ *  SegmentIndex. Only replaces best if a segment is strictly nearer.
+ *  @returns true if best was replaced
+ */
+template <typename T>
+bool update_nearest_segment
+    (const Vector2<T> & point, const LineSegment<T> * first,
+     const LineSegment<T> * last, NearestSegment<T> & best,
+     const std::size_t * original_indices = nullptr)
+{
+    static constexpr const std::size_t k_block_size = 64;
+    T distances[k_block_size];
+    const T p_x = point.x, p_y = point.y;
+    std::size_t best_offset = NearestSegment<T>::k_no_segment;
+    T best_distance = best.distance_squared;
+    const auto * block = first;
+    while (block != last) {
+        auto count = std::min(k_block_size, std::size_t(last - block));
+        for (std::size_t i = 0; i != count; ++i)
+            { distances[i] = distance_squared_to_segment(p_x, p_y, block[i]); }
+
+        // "<" fails for NaN distances, so those are never chosen
+        std::size_t block_best = count;
+        for (std::size_t i = 0; i != count; ++i) {
+            bool nearer = distances[i] < best_distance;
+            best_distance = nearer ? distances[i] : best_distance;
+            block_best    = nearer ? i : block_best;
+        }
+        if (block_best != count)
+            { best_offset = std::size_t(block - first) + block_best; }
+        block += count;
+    }
+    if (best_offset == NearestSegment<T>::k_no_segment) return false;
+
+    const auto & seg = first[best_offset];
+    T t = closest_parameter_on_segment
+        (p_x, p_y, seg.a.x, seg.a.y, seg.b.x, seg.b.y);
+    best.index = original_indices ? original_indices[best_offset] : best_offset;
+    best.point = seg.a + (seg.b - seg.a)*t;
+    best.distance_squared = best_distance;
+    return true;
+}
+
+template <typename T>
+void verify_real_point(const char * caller, const Vector2<T> & point) {
+    using namespace exceptions_abbr;
+    if (is_real(point)) return;
+    throw InvArg(std::string(caller) + ": point must have real components.");
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+NearestSegment<T> nearest_segment
+    (const Vector2<T> & point, const LineSegment<T> * first,
+     const LineSegment<T> * last)
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "nearest_segment: T must be a floating point type.");
+    detail::verify_real_point("nearest_segment", point);
+    NearestSegment<T> rv;
+    detail::update_nearest_segment(point, first, last, rv);
+    return rv;
+}
+
+template <typename T>
+void SegmentIndex<T>::assign
+    (const LineSegment<T> * first, const LineSegment<T> * last)
+{
+    using namespace exceptions_abbr;
+    m_nodes.clear();
+    m_segments.assign(first, last);
+    m_indices.resize(m_segments.size());
+    std::iota(m_indices.begin(), m_indices.end(), std::size_t(0));
+    for (const auto & segment : m_segments) {
+        if (detail::is_real(segment)) continue;
+        m_segments.clear();
+        m_indices.clear();
+        throw InvArg("SegmentIndex::assign: all segments must have real "
+                     "components.");
+    }
+    if (m_segments.empty()) return;
+    m_nodes.reserve(2*(m_segments.size() / k_leaf_size) + 1);
+    build(0, m_segments.size());
+
+    // leaves own contiguous runs of segments
+    std::vector<LineSegment<T>> sorted;
+    sorted.reserve(m_segments.size());
+    for (auto i : m_indices) sorted.push_back(m_segments[i]);
+    m_segments.swap(sorted);
+}
+
+template <typename T>
+NearestSegment<T> SegmentIndex<T>::find_nearest(const Vector2<T> & point) const {
+    detail::verify_real_point("SegmentIndex::find_nearest", point);
+    NearestSegment<T> rv;
+    if (m_nodes.empty()) return rv;
+
+    std::size_t stack[k_max_depth + 1];
+    std::size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size) {
+        const auto & node = m_nodes[stack[--stack_size]];
+        if (!(distance_squared_to(node, point) < rv.distance_squared)) continue;
+        if (node.right_child == 0) {
+            detail::update_nearest_segment(
+                point, m_segments.data() + node.begin,
+                m_segments.data() + node.end, rv, m_indices.data() + node.begin);
+            continue;
+        }
+        // push the nearer child last, so that it is visited first
+        auto left  = std::size_t(&node - m_nodes.data()) + 1;
+        auto right = node.right_child;
+        if (distance_squared_to(m_nodes[left], point) <
+            distance_squared_to(m_nodes[right], point))
+        { std::swap(left, right); }
+        stack[stack_size++] = left;
+        stack[stack_size++] = right;
+    }
+    return rv;
+}
+
+template <typename T>
+/* private */ std::size_t SegmentIndex<T>::build
+    (std::size_t begin, std::size_t end)
+{
+    // segments are still in their given order, only indices are sorted
+    Node node;
+    node.begin = begin;
+    node.end   = end;
+    node.right_child = 0;
+    node.low_x  = node.low_y  =  std::numeric_limits<T>::infinity();
+    node.high_x = node.high_y = -std::numeric_limits<T>::infinity();
+    for (auto i = begin; i != end; ++i) {
+        const auto & seg = m_segments[m_indices[i]];
+        node.low_x  = std::min({node.low_x , seg.a.x, seg.b.x});
+        node.low_y  = std::min({node.low_y , seg.a.y, seg.b.y});
+        node.high_x = std::max({node.high_x, seg.a.x, seg.b.x});
+        node.high_y = std::max({node.high_y, seg.a.y, seg.b.y});
+    }
+    auto idx = m_nodes.size();
+    m_nodes.push_back(node);
+    if (end - begin <= k_leaf_size) return idx;
+
+    // split at the median of midpoints, along the longer side
+    bool split_x = node.high_x - node.low_x >= node.high_y - node.low_y;
+    auto key = [this, split_x](std::size_t i) {
+        const auto & seg = m_segments[i];
+        return split_x ? seg.a.x + seg.b.x : seg.a.y + seg.b.y;
+    };
+    auto mid = begin + (end - begin) / 2;
+    std::nth_element(m_indices.begin() + begin, m_indices.begin() + mid,
+        m_indices.begin() + end,
+        [&key](std::size_t lhs, std::size_t rhs) { return key(lhs) < key(rhs); });
+    build(begin, mid);
+    auto right = build(mid, end);
+    m_nodes[idx].right_child = right;
+    return idx;
+}
+
+template <typename T>
+/* private */ T SegmentIndex<T>::distance_squared_to
+    (const Node & node, const Vector2<T> & r) const noexcept
+{
+    T d_x = std::max({node.low_x - r.x, T(0), r.x - node.high_x});
+    T d_y = std::max({node.low_y - r.y, T(0), r.y - node.high_y});
+    return d_x*d_x + d_y*d_y;
+}
+
+} // end of cul namespace
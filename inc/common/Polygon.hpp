@@ -0,0 +1,257 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Util.hpp>
+
+#include <algorithm>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace cul {
+
+/** @defgroup polygon_functions Polygon functions
+ *
+ *  A polygon here is a sequence of its vertices, with an edge from each
+ *  vertex to the next and from the last back to the first. None of these
+ *  functions allocate, and their inner loops are free of branches, so that
+ *  the compiler may run them several edges or points at a time.
+ *
+ *  Signs and directions are those of a y-up coordinate system, for y-down
+ *  (like screen coordinates) "counter clockwise" reads as clockwise.
+ *
+ *  @{
+ */
+
+/** @returns the area of a polygon, positive if its vertices are counter
+ *           clockwise, and negative if clockwise
+ */
+template <typename T>
+T signed_area_of_polygon(const Vector2<T> * first, const Vector2<T> * last);
+
+template <typename T>
+T area_of_polygon(const Vector2<T> * first, const Vector2<T> * last)
+    { return magnitude(signed_area_of_polygon(first, last)); }
+
+/** @returns the center of mass of the polygon's area, or the "no solution"
+ *           sentinel if the polygon has no area
+ *  @see get_no_solution_sentinel
+ */
+template <typename T>
+Vector2<T> centroid_of_polygon(const Vector2<T> * first, const Vector2<T> * last);
+
+/** @returns the number of times a polygon winds counter clockwise around a
+ *           point (negative for clockwise)
+ *  @note points exactly on an edge may be counted either way
+ */
+template <typename T>
+int winding_number_of
+    (const Vector2<T> * first, const Vector2<T> * last, const Vector2<T> & point);
+
+/** @returns true if the point is inside the polygon by the "non zero" rule
+ *           (which counts inside any loops of a self intersecting polygon)
+ *  @note points exactly on an edge may be counted either way
+ */
+template <typename T>
+bool is_inside_polygon
+    (const Vector2<T> * first, const Vector2<T> * last, const Vector2<T> & point)
+{ return winding_number_of(first, last, point) != 0; }
+
+/** Tests many points for being inside a polygon.
+ *
+ *  Points are taken in small blocks, each polygon edge is tested against a
+ *  whole block before moving on to the next.
+ *
+ *  @param out one value for each point, true if inside the polygon (as
+ *         is_inside_polygon)
+ *  @returns number of points inside the polygon
+ */
+template <typename T>
+std::size_t is_inside_polygon
+    (const Vector2<T> * polygon_first, const Vector2<T> * polygon_last,
+     const Vector2<T> * points_first , const Vector2<T> * points_last, bool * out);
+
+/** Finds the convex hull of a set of points, with Andrew's monotone chain
+ *  algorithm.
+ *
+ *  @note points are sorted (by x and then y) in place
+ *  @param out hull vertices are written here counter clockwise, starting with
+ *         the left most point, there must be room for as many points as given
+ *         (no vertex is repeated, and points along the hull's edges are not
+ *         included)
+ *  @returns number of hull vertices written to out
+ */
+template <typename T>
+std::size_t find_convex_hull(Vector2<T> * first, Vector2<T> * last, Vector2<T> * out);
+
+/** @} */
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+// twice the signed area of the triangle a, b, c
+template <typename T>
+T doubled_signed_area(const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c)
+    { return (b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x); }
+
+// +1 if the edge a to b crosses upward to the right of r, -1 if it crosses
+// downward to the left, 0 otherwise
+template <typename T>
+int winding_of_edge(const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & r) {
+    // "&" instead of "&&" on purpose, everything is computed anyway
+    int up   = (a.y <= r.y) & (b.y >  r.y);
+    int down = (a.y >  r.y) & (b.y <= r.y);
+    T side   = doubled_signed_area(a, b, r);
+    return (up & (side > T(0))) - (down & (side < T(0)));
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+T signed_area_of_polygon(const Vector2<T> * first, const Vector2<T> * last) {
+    static_assert(std::is_floating_point_v<T>,
+                  "signed_area_of_polygon: T must be a floating point type.");
+    if (last - first < 3) return T(0);
+    // relative to the first vertex, to lose less precision far from the
+    // origin
+    const auto origin = *first;
+    T sum = 0;
+    for (auto itr = first + 1; itr + 1 != last; ++itr)
+        { sum += detail::doubled_signed_area(origin, *itr, *(itr + 1)); }
+    return sum / T(2);
+}
+
+template <typename T>
+Vector2<T> centroid_of_polygon(const Vector2<T> * first, const Vector2<T> * last) {
+    static_assert(std::is_floating_point_v<T>,
+                  "centroid_of_polygon: T must be a floating point type.");
+    if (last - first < 3) return get_no_solution_sentinel<Vector2<T>>();
+    // weighted sum of the centroids of the triangle fan from the first
+    // vertex
+    const auto origin = *first;
+    T doubled_area = 0, x_sum = 0, y_sum = 0;
+    for (auto itr = first + 1; itr + 1 != last; ++itr) {
+        T part = detail::doubled_signed_area(origin, *itr, *(itr + 1));
+        doubled_area += part;
+        x_sum += part*(itr->x + (itr + 1)->x - T(2)*origin.x);
+        y_sum += part*(itr->y + (itr + 1)->y - T(2)*origin.y);
+    }
+    if (doubled_area == T(0)) return get_no_solution_sentinel<Vector2<T>>();
+    return origin + Vector2<T>(x_sum, y_sum)*(T(1) / (T(3)*doubled_area));
+}
+
+template <typename T>
+int winding_number_of
+    (const Vector2<T> * first, const Vector2<T> * last, const Vector2<T> & point)
+{
+    if (first == last) return 0;
+    int winding = detail::winding_of_edge(*(last - 1), *first, point);
+    for (auto itr = first; itr + 1 != last; ++itr)
+        { winding += detail::winding_of_edge(*itr, *(itr + 1), point); }
+    return winding;
+}
+
+template <typename T>
+std::size_t is_inside_polygon
+    (const Vector2<T> * polygon_first, const Vector2<T> * polygon_last,
+     const Vector2<T> * points_first , const Vector2<T> * points_last, bool * out)
+{
+    static constexpr const std::size_t k_block_size = 64;
+    std::size_t count = 0;
+    while (points_first != points_last) {
+        auto block_size = std::min(k_block_size, std::size_t(points_last - points_first));
+        int windings[k_block_size] = {};
+        auto add_windings = [points_first, block_size, &windings]
+            (const Vector2<T> & a, const Vector2<T> & b)
+        {
+            for (std::size_t i = 0; i != block_size; ++i)
+                { windings[i] += detail::winding_of_edge(a, b, points_first[i]); }
+        };
+        if (polygon_first != polygon_last) {
+            for (auto itr = polygon_first; itr + 1 != polygon_last; ++itr)
+                { add_windings(*itr, *(itr + 1)); }
+            add_windings(*(polygon_last - 1), *polygon_first);
+        }
+        for (std::size_t i = 0; i != block_size; ++i) {
+            out[i] = windings[i] != 0;
+            count += out[i] ? 1 : 0;
+        }
+        points_first += block_size;
+        out          += block_size;
+    }
+    return count;
+}
+
+template <typename T>
+std::size_t find_convex_hull(Vector2<T> * first, Vector2<T> * last, Vector2<T> * out) {
+    std::sort(first, last, [](const Vector2<T> & lhs, const Vector2<T> & rhs)
+        { return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y); });
+    if (first == last) return 0;
+    const auto & left  = *first;
+    const auto & right = *(last - 1);
+    if (left == right) {
+        *out = left;
+        return 1;
+    }
+
+    // Each point strictly below the line from the left most to the right
+    // most point can only be on the lower hull, and each point strictly above
+    // only on the upper hull. Taking them separately keeps the two hulls from
+    // ever sharing points, which is how the hull fits in out.
+    using detail::doubled_signed_area;
+    std::size_t count = 0;
+    auto push_if_convex = [out, &count](std::size_t hull_start, const Vector2<T> & r) {
+        while (   count >= hull_start + 2
+               && doubled_signed_area(out[count - 2], out[count - 1], r) <= T(0))
+        { --count; }
+        out[count++] = r;
+    };
+
+    out[count++] = left;
+    for (auto itr = first + 1; itr + 1 != last; ++itr) {
+        if (doubled_signed_area(left, right, *itr) < T(0))
+            { push_if_convex(0, *itr); }
+    }
+    push_if_convex(0, right);
+    auto upper_start = count - 1;
+    for (auto itr = last - 1; itr != first + 1; --itr) {
+        const auto & r = *(itr - 1);
+        if (doubled_signed_area(left, right, r) > T(0))
+            { push_if_convex(upper_start, r); }
+    }
+    // the left most point closes the hull, without being repeated
+    while (   count >= upper_start + 2
+           && doubled_signed_area(out[count - 2], out[count - 1], left) <= T(0))
+    { --count; }
+    return count;
+}
+
+} // end of cul namespace
@@ -0,0 +1,319 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/NearestSegment.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace cul {
+
+enum PolylineSimplification_e {
+    /** removes points no further than the tolerance from the simplified
+     *  line, keeping sharp features
+     */
+    k_douglas_peucker,
+    /** removes points whose triangle with their neighbors has an area no
+     *  more than the tolerance, one smallest triangle at a time, giving
+     *  smoother results
+     */
+    k_visvalingam_whyatt
+};
+
+/** Removes nearly collinear points from polylines (like those from
+ *  for_bezier_points or contours of tiles).
+ *
+ *  Kept points are always a subsequence of the original points, including
+ *  the first and the last. All comparisons are done with squared distances or
+ *  doubled areas, so that no square roots are taken.
+ *
+ *  A simplifier holds onto its scratch space, so that simplifying many
+ *  polylines with the same simplifier does not need to allocate once its
+ *  buffers are large enough.
+ */
+template <typename T>
+class PolylineSimplifier final {
+public:
+    static_assert(std::is_floating_point_v<T>,
+                  "PolylineSimplifier: T must be a floating point type.");
+
+    PolylineSimplifier() {}
+
+    /** Grows scratch space for polylines of up to this many points. */
+    void reserve(std::size_t point_count);
+
+    /** Simplifies a polyline, writing kept points to out.
+     *
+     *  @param tolerance for Douglas–Peucker: the furthest any removed point
+     *         may be from the simplified line; for Visvalingam–Whyatt: the
+     *         largest area a triangle of a removed point and its neighbors
+     *         may have
+     *  @param out must have room for as many points as the polyline, and may
+     *         be first (simplifying in place)
+     *  @returns one past the last point written
+     *  @throws if tolerance is negative or not real, or if any component of
+     *          any point is not real
+     */
+    Vector2<T> * simplify
+        (const Vector2<T> * first, const Vector2<T> * last, T tolerance,
+         Vector2<T> * out, PolylineSimplification_e = k_douglas_peucker);
+
+    /** Simplifies a polyline, replacing out's contents with kept points.
+     *  out may be the same vector as points.
+     */
+    void simplify
+        (const std::vector<Vector2<T>> & points, T tolerance,
+         std::vector<Vector2<T>> & out,
+         PolylineSimplification_e = k_douglas_peucker);
+
+private:
+    static constexpr const std::size_t k_no_point = std::size_t(-1);
+
+    struct IndexRange {
+        std::size_t begin, end;
+    };
+
+    struct HeapEntry {
+        // doubled area, as it was when this entry was pushed
+        T area;
+        std::size_t index;
+    };
+
+    void mark_by_distance
+        (const Vector2<T> * points, std::size_t count, T tolerance);
+
+    void mark_by_area
+        (const Vector2<T> * points, std::size_t count, T tolerance);
+
+    // points with zero are removed
+    std::vector<unsigned char> m_keep;
+    // Douglas–Peucker only
+    std::vector<IndexRange> m_stack;
+    // Visvalingam–Whyatt only
+    std::vector<HeapEntry> m_heap;
+    std::vector<T> m_areas;
+    std::vector<std::size_t> m_previous;
+    std::vector<std::size_t> m_next;
+};
+
+/** Simplifies a polyline with a simplifier made just for this call.
+ *  @see PolylineSimplifier::simplify
+ */
+template <typename T>
+Vector2<T> * simplify_polyline
+    (const Vector2<T> * first, const Vector2<T> * last, T tolerance,
+     Vector2<T> * out, PolylineSimplification_e method = k_douglas_peucker)
+{ return PolylineSimplifier<T>{}.simplify(first, last, tolerance, out, method); }
+
+template <typename T>
+void simplify_polyline
+    (const std::vector<Vector2<T>> & points, T tolerance,
+     std::vector<Vector2<T>> & out,
+     PolylineSimplification_e method = k_douglas_peucker)
+{ PolylineSimplifier<T>{}.simplify(points, tolerance, out, method); }
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+/** @returns twice the area of the triangle abc (without sign) */
+template <typename T>
+T doubled_triangle_area
+    (const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c) noexcept
+{
+    T cross = (b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x);
+    return cross < T(0) ? -cross : cross;
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+void PolylineSimplifier<T>::reserve(std::size_t point_count) {
+    m_keep    .reserve(point_count);
+    // each range pushed splits off at least one point
+    m_stack   .reserve(point_count);
+    // each removal pushes at most two entries
+    m_heap    .reserve(point_count*3);
+    m_areas   .reserve(point_count);
+    m_previous.reserve(point_count);
+    m_next    .reserve(point_count);
+}
+
+template <typename T>
+Vector2<T> * PolylineSimplifier<T>::simplify
+    (const Vector2<T> * first, const Vector2<T> * last, T tolerance,
+     Vector2<T> * out, PolylineSimplification_e method)
+{
+    using namespace exceptions_abbr;
+    if (!is_real(tolerance) || tolerance < T(0)) {
+        throw InvArg("PolylineSimplifier::simplify: tolerance must be a non "
+                     "negative real number.");
+    }
+    for (auto itr = first; itr != last; ++itr) {
+        if (is_real(*itr)) continue;
+        throw InvArg("PolylineSimplifier::simplify: all points must have real "
+                     "components.");
+    }
+    std::size_t count = std::size_t(last - first);
+    if (count < 3) {
+        return std::copy(first, last, out);
+    }
+
+    switch (method) {
+    case k_douglas_peucker   : mark_by_distance(first, count, tolerance); break;
+    case k_visvalingam_whyatt: mark_by_area    (first, count, tolerance); break;
+    default: throw InvArg("PolylineSimplifier::simplify: unknown method.");
+    }
+
+    // kept points never move forward, so out may alias first
+    for (std::size_t i = 0; i != count; ++i) {
+        if (m_keep[i]) *out++ = first[i];
+    }
+    return out;
+}
+
+template <typename T>
+void PolylineSimplifier<T>::simplify
+    (const std::vector<Vector2<T>> & points, T tolerance,
+     std::vector<Vector2<T>> & out, PolylineSimplification_e method)
+{
+    // resizing first is harmless if out and points are the same vector
+    out.resize(points.size());
+    auto end = simplify(points.data(), points.data() + points.size(),
+                        tolerance, out.data(), method);
+    out.erase(out.begin() + (end - out.data()), out.end());
+}
+
+template <typename T>
+/* private */ void PolylineSimplifier<T>::mark_by_distance
+    (const Vector2<T> * points, std::size_t count, T tolerance)
+{
+    const T tolerance_squared = tolerance*tolerance;
+    m_keep.clear();
+    m_keep.resize(count, 0);
+    m_keep.front() = m_keep.back() = 1;
+
+    // an explicit stack, so that very long polylines cannot overflow the call
+    // stack
+    m_stack.clear();
+    m_stack.push_back(IndexRange{0, count - 1});
+    while (!m_stack.empty()) {
+        auto range = m_stack.back();
+        m_stack.pop_back();
+        const auto & a = points[range.begin];
+        const auto & b = points[range.end];
+        T furthest = T(0);
+        std::size_t furthest_index = k_no_point;
+        for (std::size_t i = range.begin + 1; i < range.end; ++i) {
+            const auto & p = points[i];
+            // measured to the segment rather than its line, so that a range
+            // whose ends meet (like a closed loop) still splits
+            T t = detail::closest_parameter_on_segment(p.x, p.y, a.x, a.y, b.x, b.y);
+            T d_x = a.x + t*(b.x - a.x) - p.x;
+            T d_y = a.y + t*(b.y - a.y) - p.y;
+            T distance_squared = d_x*d_x + d_y*d_y;
+            if (distance_squared > furthest) {
+                furthest       = distance_squared;
+                furthest_index = i;
+            }
+        }
+        if (furthest_index == k_no_point || furthest <= tolerance_squared)
+            { continue; }
+        m_keep[furthest_index] = 1;
+        m_stack.push_back(IndexRange{range.begin, furthest_index});
+        m_stack.push_back(IndexRange{furthest_index, range.end});
+    }
+}
+
+template <typename T>
+/* private */ void PolylineSimplifier<T>::mark_by_area
+    (const Vector2<T> * points, std::size_t count, T tolerance)
+{
+    // areas are compared doubled, as they come from cross products
+    const T doubled_tolerance = tolerance*T(2);
+    // a min heap, by area and then by index (so ties go in order)
+    auto later = [](const HeapEntry & lhs, const HeapEntry & rhs) {
+        if (lhs.area == rhs.area) return lhs.index > rhs.index;
+        return lhs.area > rhs.area;
+    };
+
+    m_keep.clear();
+    m_keep.resize(count, 1);
+    m_areas.clear();
+    m_areas.resize(count, T(0));
+    m_previous.resize(count);
+    m_next.resize(count);
+    m_heap.clear();
+    for (std::size_t i = 0; i != count; ++i) {
+        m_previous[i] = i - 1;
+        m_next    [i] = i + 1;
+    }
+    for (std::size_t i = 1; i + 1 < count; ++i) {
+        m_areas[i] = detail::doubled_triangle_area
+            (points[i - 1], points[i], points[i + 1]);
+        m_heap.push_back(HeapEntry{m_areas[i], i});
+    }
+    std::make_heap(m_heap.begin(), m_heap.end(), later);
+
+    auto update_area = [&](std::size_t i, T removed_area) {
+        // ends are never removed
+        if (i == 0 || i == count - 1) return;
+        T area = detail::doubled_triangle_area
+            (points[m_previous[i]], points[i], points[m_next[i]]);
+        // a point may not become cheaper to remove than one removed before
+        // it, which keeps removal order stable against small wiggles
+        m_areas[i] = std::max(area, removed_area);
+        m_heap.push_back(HeapEntry{m_areas[i], i});
+        std::push_heap(m_heap.begin(), m_heap.end(), later);
+    };
+
+    while (!m_heap.empty()) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), later);
+        auto entry = m_heap.back();
+        m_heap.pop_back();
+        // entries are never updated in place, only superseded
+        if (!m_keep[entry.index] || entry.area != m_areas[entry.index])
+            { continue; }
+        if (entry.area > doubled_tolerance) break;
+
+        auto i = entry.index;
+        m_keep[i] = 0;
+        auto previous = m_previous[i];
+        auto next     = m_next    [i];
+        m_next    [previous] = next;
+        m_previous[next    ] = previous;
+        update_area(previous, entry.area);
+        update_area(next    , entry.area);
+    }
+}
+
+} // end of cul namespace
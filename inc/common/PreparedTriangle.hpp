@@ -0,0 +1,247 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Vector2Array.hpp>
+#include <common/Util.hpp>
+
+#include <tuple>
+#include <algorithm>
+#include <type_traits>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace cul {
+
+/** A triangle prepared for testing many points against it.
+ *
+ *  Each edge is turned into an "edge function" once, which is positive on
+ *  the triangle's side of the edge. After that, testing a point costs six
+ *  multiplications and no divisions, and batches of points are tested
+ *  several at a time where the compiler can vectorize.
+ *
+ *  Points exactly on an edge are decided by the "top left" rule (as used in
+ *  rasterization, for y-down coordinates): a point on an edge shared by two
+ *  triangles is inside exactly one of them.
+ *
+ *  For integer types all arithmetic is exact (done in 64 bits), so long as
+ *  coordinates are within +/- 2^29. This is what contains_pixel_center is
+ *  for.
+ */
+template <typename T>
+class PreparedTriangle final {
+public:
+    static_assert(std::is_arithmetic_v<T>, "PreparedTriangle: T must be an arithmetic type.");
+
+    /** type used for edge functions, wide enough to be exact for integers */
+    using WideType = std::conditional_t<std::is_integral_v<T>, std::int64_t, T>;
+
+    /** a triangle which contains nothing */
+    PreparedTriangle() {}
+
+    /** Points may be in either winding order. */
+    PreparedTriangle(const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c);
+
+    /** @returns true if the point is inside the triangle */
+    bool contains(const Vector2<T> & r) const noexcept
+        { return contains_scaled(WideType(r.x), WideType(r.y), WideType(1)); }
+
+    /** Tests a sequence of points.
+     *  @param out one value for each point, true if inside
+     *  @returns number of points inside
+     */
+    std::size_t contains
+        (const Vector2<T> * first, const Vector2<T> * last, bool * out) const noexcept;
+
+    /** Tests an array of points, out must point to at least points.size()
+     *  values.
+     *  @returns number of points inside
+     */
+    std::size_t contains(const Vector2Array<T> & points, bool * out) const noexcept;
+
+    /** @returns true if the center of pixel (x, y), that is point
+     *           (x + 0.5, y + 0.5), is inside the triangle
+     *  @note only for integer types
+     */
+    bool contains_pixel_center(T x, T y) const noexcept;
+
+    /** @returns barycentric weights for a, b, and c (in the order given to the
+     *           constructor) at a point, which sum to one; they are all non
+     *           negative for points inside the triangle
+     *
+     *  Useful for interpolating any values given for each corner.
+     *  @note only for floating point types, and all weights are zero for
+     *        triangles with no area
+     */
+    std::tuple<T, T, T> barycentric_of(const Vector2<T> & r) const noexcept;
+
+    /** @returns twice the area of the triangle */
+    WideType doubled_area() const noexcept { return m_doubled_area; }
+
+    /** @returns true if the triangle has no area (and therefore contains
+     *           nothing)
+     */
+    bool is_degenerate() const noexcept { return m_doubled_area == WideType(0); }
+
+private:
+    struct EdgeFunctions {
+        WideType a[3] = {}, b[3] = {}, c[3] = {};
+        // edges owned by the "top left" rule
+        bool owns[3] = {};
+    };
+
+    // edge function i times scale, at point (x, y)/scale
+    WideType edge_value(int i, WideType x, WideType y, WideType scale) const noexcept
+        { return m_edges.a[i]*x + m_edges.b[i]*y + m_edges.c[i]*scale; }
+
+    bool is_on_inside(int i, WideType value) const noexcept
+        { return (value > WideType(0)) | ((value == WideType(0)) & m_edges.owns[i]); }
+
+    bool contains_scaled(WideType x, WideType y, WideType scale) const noexcept {
+        return   is_on_inside(0, edge_value(0, x, y, scale))
+               & is_on_inside(1, edge_value(1, x, y, scale))
+               & is_on_inside(2, edge_value(2, x, y, scale))
+               & !is_degenerate();
+    }
+
+    template <typename GetX, typename GetY>
+    std::size_t contains_each(std::size_t count, GetX && get_x, GetY && get_y, bool * out) const noexcept;
+
+    EdgeFunctions m_edges;
+    WideType m_doubled_area = 0;
+    // edge opposite each corner, in constructor order
+    int m_edge_opposite[3] = { 1, 2, 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+PreparedTriangle<T>::PreparedTriangle
+    (const Vector2<T> & a, const Vector2<T> & b, const Vector2<T> & c)
+{
+    using WideVec = Vector2<WideType>;
+    WideVec pts[3] = { WideVec(a), WideVec(b), WideVec(c) };
+    m_doubled_area = cross(pts[1] - pts[0], pts[2] - pts[0]);
+    if (m_doubled_area < WideType(0)) {
+        // make edge functions positive inside
+        std::swap(pts[1], pts[2]);
+        m_doubled_area = -m_doubled_area;
+        m_edge_opposite[0] = 1;
+        m_edge_opposite[1] = 0;
+        m_edge_opposite[2] = 2;
+    }
+    for (int i = 0; i != 3; ++i) {
+        // edge function for points r: cross(v1 - v0, r - v0)
+        const auto & v0 = pts[i];
+        const auto & v1 = pts[(i + 1) % 3];
+        auto dir = v1 - v0;
+        m_edges.a[i] = -dir.y;
+        m_edges.b[i] =  dir.x;
+        m_edges.c[i] = dir.y*v0.x - dir.x*v0.y;
+        m_edges.owns[i] = dir.y < WideType(0) || (dir.y == WideType(0) && dir.x > WideType(0));
+    }
+}
+
+template <typename T>
+std::size_t PreparedTriangle<T>::contains
+    (const Vector2<T> * first, const Vector2<T> * last, bool * out) const noexcept
+{
+    return contains_each(std::size_t(last - first),
+                    [first](std::size_t i) { return first[i].x; },
+                    [first](std::size_t i) { return first[i].y; }, out);
+}
+
+template <typename T>
+std::size_t PreparedTriangle<T>::contains
+    (const Vector2Array<T> & points, bool * out) const noexcept
+{
+    const T * x = points.x_data();
+    const T * y = points.y_data();
+    return contains_each(points.size(),
+                    [x](std::size_t i) { return x[i]; },
+                    [y](std::size_t i) { return y[i]; }, out);
+}
+
+template <typename T>
+bool PreparedTriangle<T>::contains_pixel_center(T x, T y) const noexcept {
+    static_assert(std::is_integral_v<T>,
+                  "PreparedTriangle::contains_pixel_center: only available for "
+                  "integer types.");
+    // everything is doubled to stay in integers
+    return contains_scaled(WideType(x)*2 + 1, WideType(y)*2 + 1, WideType(2));
+}
+
+template <typename T>
+std::tuple<T, T, T> PreparedTriangle<T>::barycentric_of
+    (const Vector2<T> & r) const noexcept
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "PreparedTriangle::barycentric_of: only available for floating "
+                  "point types.");
+    if (is_degenerate()) return std::make_tuple(T(0), T(0), T(0));
+    // the weight of a corner is the area of the triangle made by the point
+    // and the opposite edge
+    T inv_area = T(1) / m_doubled_area;
+    T weights[3];
+    for (int i = 0; i != 3; ++i)
+        { weights[i] = edge_value(m_edge_opposite[i], r.x, r.y, T(1))*inv_area; }
+    return std::make_tuple(weights[0], weights[1], weights[2]);
+}
+
+template <typename T>
+template <typename GetX, typename GetY>
+/* private */ std::size_t PreparedTriangle<T>::contains_each
+    (std::size_t count, GetX && get_x, GetY && get_y, bool * out) const noexcept
+{
+    if (is_degenerate()) {
+        std::fill(out, out + count, false);
+        return 0;
+    }
+    // copied to locals so that the compiler may keep them in registers
+    const auto edges = m_edges;
+    std::size_t inside_count = 0;
+    for (std::size_t i = 0; i != count; ++i) {
+        auto x = WideType(get_x(i));
+        auto y = WideType(get_y(i));
+        auto e0 = edges.a[0]*x + edges.b[0]*y + edges.c[0];
+        auto e1 = edges.a[1]*x + edges.b[1]*y + edges.c[1];
+        auto e2 = edges.a[2]*x + edges.b[2]*y + edges.c[2];
+        // "&" and "|" instead of "&&" and "||" on purpose, everything is
+        // computed anyway
+        bool inside =   ((e0 > WideType(0)) | ((e0 == WideType(0)) & edges.owns[0]))
+                      & ((e1 > WideType(0)) | ((e1 == WideType(0)) & edges.owns[1]))
+                      & ((e2 > WideType(0)) | ((e2 == WideType(0)) & edges.owns[2]));
+        out[i] = inside;
+        inside_count += inside ? 1 : 0;
+    }
+    return inside_count;
+}
+
+} // end of cul namespace
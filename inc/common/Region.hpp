@@ -0,0 +1,364 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Util.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace cul {
+
+/** A set of points in the plane, kept as disjoint rectangles (like X11
+ *  regions), for tracking areas that need redrawing or have changed.
+ *
+ *  Rectangles are grouped into horizontal bands, each band being a sorted
+ *  list of spans all of the same height. This form is canonical: bands never
+ *  overlap and are sorted top to bottom, spans within a band never touch,
+ *  empty bands are removed, and touching bands with identical spans are
+ *  merged. So the same set of points always has the same rectangles, and
+ *  rectangles are never duplicated however many times an area is added.
+ *
+ *  Set operations walk both regions' bands together, costing time linear in
+ *  the number of rectangles.
+ *
+ *  Like "is_contained_in", rectangles include their left and top edges but
+ *  not their right and bottom. Rectangles without area are ignored.
+ */
+template <typename T>
+class Region final {
+public:
+    static_assert(std::is_arithmetic_v<T>, "Region: T must be an arithmetic type.");
+
+    Region() {}
+
+    /** Implicit so that a rectangle may be used wherever a region is. */
+    Region(const Rectangle<T> &);
+
+    /** Region covering the union of all given rectangles. */
+    Region(const Rectangle<T> * first, const Rectangle<T> * last);
+
+    explicit Region(const std::vector<Rectangle<T>> & rects):
+        Region(rects.data(), rects.data() + rects.size())
+    {}
+
+    Region operator | (const Region & rhs) const
+        { return combine(*this, rhs, [](bool a, bool b) { return a || b; }); }
+
+    Region operator & (const Region & rhs) const
+        { return combine(*this, rhs, [](bool a, bool b) { return a && b; }); }
+
+    Region operator - (const Region & rhs) const
+        { return combine(*this, rhs, [](bool a, bool b) { return a && !b; }); }
+
+    /** symmetric difference */
+    Region operator ^ (const Region & rhs) const
+        { return combine(*this, rhs, [](bool a, bool b) { return a != b; }); }
+
+    Region & operator |= (const Region & rhs) { return (*this = *this | rhs); }
+
+    Region & operator &= (const Region & rhs) { return (*this = *this & rhs); }
+
+    Region & operator -= (const Region & rhs) { return (*this = *this - rhs); }
+
+    Region & operator ^= (const Region & rhs) { return (*this = *this ^ rhs); }
+
+    bool operator == (const Region & rhs) const;
+
+    bool operator != (const Region & rhs) const { return !(*this == rhs); }
+
+    bool contains(const Vector2<T> &) const;
+
+    /** @returns true if every point of the rectangle is in this region (true
+     *           for rectangles without area)
+     */
+    bool contains(const Rectangle<T> &) const;
+
+    /** @returns true if any point of the rectangle is in this region */
+    bool overlaps(const Rectangle<T> & rect) const
+        { return !(*this & rect).is_empty(); }
+
+    /** @returns smallest rectangle containing the whole region */
+    Rectangle<T> bounds() const;
+
+    /** Calls f(const Rectangle<T> &) for each rectangle, in row order (top to
+     *  bottom, and left to right within each band). f may return a
+     *  FlowControlSignal to stop early.
+     */
+    template <typename Func>
+    void for_each_rectangle(Func && f) const;
+
+    /** @returns all rectangles, in row order */
+    std::vector<Rectangle<T>> rectangles() const;
+
+    std::size_t rectangle_count() const noexcept { return m_spans.size(); }
+
+    bool is_empty() const noexcept { return m_bands.empty(); }
+
+    void clear();
+
+private:
+    struct Span {
+        T left, right;
+        bool operator == (const Span & rhs) const
+            { return left == rhs.left && right == rhs.right; }
+    };
+
+    struct Band {
+        T top, bottom;
+        // range into m_spans
+        std::size_t begin, end;
+    };
+
+    template <typename Func>
+    static Region combine(const Region & lhs, const Region & rhs, Func && f);
+
+    // adds spans from the end of m_spans (starting at begin) as a new band,
+    // or merges them into the last band if it touches and is identical
+    void finish_band(T top, T bottom, std::size_t begin);
+
+    static Region unite_all(const Rectangle<T> * first, const Rectangle<T> * last);
+
+    std::vector<Band> m_bands;
+    std::vector<Span> m_spans;
+};
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+/** Walks two sorted sequences of disjoint intervals together, calling
+ *  f(low, high, a_item, b_item) for each piece between consecutive end
+ *  points where either has an interval. Items are null where that sequence
+ *  has no interval.
+ */
+template <typename T, typename A, typename B, typename GetA, typename GetB, typename Func>
+void for_each_interval_piece
+    (const A * a, std::size_t a_count, const B * b, std::size_t b_count,
+     GetA && get_a, GetB && get_b, Func && f)
+{
+    std::size_t i = 0, j = 0;
+    if (a_count == 0 && b_count == 0) return;
+    T pos = a_count == 0 ? get_b(b[0]).first :
+            b_count == 0 ? get_a(a[0]).first :
+            std::min(get_a(a[0]).first, get_b(b[0]).first);
+    while (i != a_count || j != b_count) {
+        bool in_a = i != a_count && get_a(a[i]).first <= pos;
+        bool in_b = j != b_count && get_b(b[j]).first <= pos;
+        bool has_next = false;
+        T next = pos;
+        auto consider = [&has_next, &next](T value) {
+            if (!has_next || value < next) next = value;
+            has_next = true;
+        };
+        if (i != a_count) consider(in_a ? get_a(a[i]).second : get_a(a[i]).first);
+        if (j != b_count) consider(in_b ? get_b(b[j]).second : get_b(b[j]).first);
+        if (in_a || in_b)
+            { f(pos, next, in_a ? &a[i] : nullptr, in_b ? &b[j] : nullptr); }
+        pos = next;
+        if (i != a_count && get_a(a[i]).second <= pos) ++i;
+        if (j != b_count && get_b(b[j]).second <= pos) ++j;
+    }
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+Region<T>::Region(const Rectangle<T> & rect) {
+    if (!(rect.width > T(0)) || !(rect.height > T(0))) return;
+    m_spans.push_back(Span{rect.left, right_of(rect)});
+    m_bands.push_back(Band{rect.top, bottom_of(rect), 0, 1});
+}
+
+template <typename T>
+Region<T>::Region(const Rectangle<T> * first, const Rectangle<T> * last):
+    Region(unite_all(first, last))
+{}
+
+template <typename T>
+bool Region<T>::operator == (const Region & rhs) const {
+    // canonical, so equal sets have equal bands and spans
+    if (m_bands.size() != rhs.m_bands.size() || m_spans != rhs.m_spans)
+        return false;
+    for (std::size_t i = 0; i != m_bands.size(); ++i) {
+        const auto & a = m_bands[i];
+        const auto & b = rhs.m_bands[i];
+        if (a.top != b.top || a.bottom != b.bottom || a.begin != b.begin)
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool Region<T>::contains(const Vector2<T> & r) const {
+    auto band = std::upper_bound(m_bands.begin(), m_bands.end(), r.y,
+        [](T y, const Band & band) { return y < band.bottom; });
+    if (band == m_bands.end() || r.y < band->top) return false;
+    auto first = m_spans.begin() + band->begin;
+    auto last  = m_spans.begin() + band->end;
+    auto span = std::upper_bound(first, last, r.x,
+        [](T x, const Span & span) { return x < span.right; });
+    return span != last && span->left <= r.x;
+}
+
+template <typename T>
+bool Region<T>::contains(const Rectangle<T> & rect) const {
+    if (!(rect.width > T(0)) || !(rect.height > T(0))) return true;
+    const T right = right_of(rect), bottom = bottom_of(rect);
+    auto band = std::upper_bound(m_bands.begin(), m_bands.end(), rect.top,
+        [](T y, const Band & band) { return y < band.bottom; });
+    // covered only if each band over the rectangle's rows starts where the
+    // last ended, and has one span covering all its columns
+    T y = rect.top;
+    for (; y < bottom; ++band) {
+        if (band == m_bands.end() || y < band->top) return false;
+        auto first = m_spans.begin() + band->begin;
+        auto last  = m_spans.begin() + band->end;
+        auto span = std::upper_bound(first, last, rect.left,
+            [](T x, const Span & span) { return x < span.right; });
+        if (span == last || rect.left < span->left || span->right < right)
+            return false;
+        y = band->bottom;
+    }
+    return true;
+}
+
+template <typename T>
+Rectangle<T> Region<T>::bounds() const {
+    if (is_empty()) return Rectangle<T>();
+    T left = m_spans.front().left, right = m_spans.front().right;
+    for (const auto & band : m_bands) {
+        left  = std::min(left , m_spans[band.begin  ].left );
+        right = std::max(right, m_spans[band.end - 1].right);
+    }
+    T top = m_bands.front().top;
+    return Rectangle<T>(left, top, right - left, m_bands.back().bottom - top);
+}
+
+template <typename T>
+template <typename Func>
+void Region<T>::for_each_rectangle(Func && f) const {
+    for (const auto & band : m_bands) {
+        for (auto i = band.begin; i != band.end; ++i) {
+            const auto & span = m_spans[i];
+            Rectangle<T> rect(span.left, band.top, span.right - span.left,
+                              band.bottom - band.top);
+            if (adapt_to_flow_control_signal(f, rect) == fc_signal::k_break)
+                return;
+        }
+    }
+}
+
+template <typename T>
+std::vector<Rectangle<T>> Region<T>::rectangles() const {
+    std::vector<Rectangle<T>> rv;
+    rv.reserve(m_spans.size());
+    for_each_rectangle([&rv](const Rectangle<T> & rect) { rv.push_back(rect); });
+    return rv;
+}
+
+template <typename T>
+void Region<T>::clear() {
+    m_bands.clear();
+    m_spans.clear();
+}
+
+template <typename T>
+template <typename Func>
+/* private static */ Region<T> Region<T>::combine
+    (const Region & lhs, const Region & rhs, Func && f)
+{
+    Region rv;
+    rv.m_bands.reserve(lhs.m_bands.size() + rhs.m_bands.size());
+    rv.m_spans.reserve(lhs.m_spans.size() + rhs.m_spans.size());
+    auto get_rows = [](const Band & band) { return std::make_pair(band.top, band.bottom); };
+    auto get_columns = [](const Span & span) { return std::make_pair(span.left, span.right); };
+    auto spans_of = [](const Region & region, const Band * band) {
+        if (!band) return std::make_pair(static_cast<const Span *>(nullptr), std::size_t(0));
+        return std::make_pair(region.m_spans.data() + band->begin, band->end - band->begin);
+    };
+    detail::for_each_interval_piece<T>(
+        lhs.m_bands.data(), lhs.m_bands.size(), rhs.m_bands.data(), rhs.m_bands.size(),
+        get_rows, get_rows,
+        [&](T top, T bottom, const Band * a_band, const Band * b_band)
+    {
+        auto [a_spans, a_count] = spans_of(lhs, a_band);
+        auto [b_spans, b_count] = spans_of(rhs, b_band);
+        auto begin = rv.m_spans.size();
+        detail::for_each_interval_piece<T>(
+            a_spans, a_count, b_spans, b_count, get_columns, get_columns,
+            [&](T left, T right, const Span * a_span, const Span * b_span)
+        {
+            if (!f(a_span != nullptr, b_span != nullptr)) return;
+            auto & spans = rv.m_spans;
+            if (spans.size() != begin && spans.back().right == left) {
+                spans.back().right = right;
+            } else {
+                spans.push_back(Span{left, right});
+            }
+        });
+        rv.finish_band(top, bottom, begin);
+    });
+    return rv;
+}
+
+template <typename T>
+/* private */ void Region<T>::finish_band(T top, T bottom, std::size_t begin) {
+    auto end = m_spans.size();
+    if (begin == end) return;
+    if (!m_bands.empty()) {
+        auto & last = m_bands.back();
+        if (   last.bottom == top && last.end - last.begin == end - begin
+            && std::equal(m_spans.begin() + last.begin, m_spans.begin() + last.end,
+                          m_spans.begin() + begin))
+        {
+            last.bottom = bottom;
+            m_spans.resize(begin);
+            return;
+        }
+    }
+    m_bands.push_back(Band{top, bottom, begin, end});
+}
+
+template <typename T>
+/* private static */ Region<T> Region<T>::unite_all
+    (const Rectangle<T> * first, const Rectangle<T> * last)
+{
+    // halves keep the regions being merged similar in size
+    auto count = last - first;
+    if (count == 0) return Region();
+    if (count == 1) return Region(*first);
+    auto mid = first + count / 2;
+    return unite_all(first, mid) | unite_all(mid, last);
+}
+
+} // end of cul namespace
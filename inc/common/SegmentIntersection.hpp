@@ -0,0 +1,484 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Util.hpp>
+
+#include <vector>
+#include <queue>
+#include <unordered_set>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+
+namespace cul {
+
+/** A line segment between two points. */
+template <typename T>
+struct LineSegment {
+    LineSegment() {}
+
+    LineSegment(const Vector2<T> & a_, const Vector2<T> & b_):
+        a(a_), b(b_)
+    {}
+
+    Vector2<T> a, b;
+};
+
+/** One intersection found between two segments of a sequence. */
+template <typename T>
+struct SegmentIntersection {
+    Vector2<T> point;
+    /** indices into the sequence, first_index is always less than
+     *  second_index
+     */
+    std::size_t first_index = 0, second_index = 0;
+};
+
+/** Intersects one segment against a sequence of segments (e.g. one ray
+ *  against many walls).
+ *
+ *  Each result is the same as find_intersection would give (up to rounding),
+ *  written to out, one per segment in the sequence; the "no solution"
+ *  sentinel is written where there is no intersection.
+ *
+ *  Each segment is first tested against the bounding box of the given
+ *  segment, and the loop is free of branches so that the compiler may run it
+ *  several segments at a time.
+ *
+ *  @throws if any component of the given segment is not a real number;
+ *          segments in the sequence with non real components simply do not
+ *          intersect
+ *  @returns the number of intersections found
+ */
+template <typename T>
+std::size_t intersect_one_vs_many
+    (const LineSegment<T> & segment, const LineSegment<T> * first,
+     const LineSegment<T> * last, Vector2<T> * out);
+
+/** Finds all intersecting pairs in a sequence of segments, using a
+ *  Bentley-Ottmann sweep over n segments with k intersections.
+ *
+ *  Events are queued in O(log n) each, but the sweep line's status is a
+ *  sorted vector, so each update also moves up to s elements, for s segments
+ *  crossing the sweep line at once. Which is O((n + k)(log n + s)) overall,
+ *  and still far better than checking all pairs when s is small.
+ *
+ *  Like find_intersection, segments touching at an end point do intersect
+ *  (so consecutive segments of a polyline are always reported), and
+ *  collinear segments do not.
+ *
+ *  @throws if any component of any segment is not a real number
+ *  @returns every intersection exactly once, in no particular order
+ */
+template <typename T>
+std::vector<SegmentIntersection<T>> find_all_intersections
+    (const LineSegment<T> * first, const LineSegment<T> * last);
+
+template <typename T>
+std::vector<SegmentIntersection<T>> find_all_intersections
+    (const std::vector<LineSegment<T>> & segments)
+{ return find_all_intersections(segments.data(), segments.data() + segments.size()); }
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename T>
+bool is_real(const LineSegment<T> & segment)
+    { return cul::is_real(segment.a) && cul::is_real(segment.b); }
+
+/** Sweep state for find_all_intersections.
+ *
+ *  The sweep line moves left to right (ties broken bottom to top), the status
+ *  holds the segments crossing the sweep line ordered bottom to top. Event
+ *  points are kept in a min heap: segment starts, intersections, and segment
+ *  ends.
+ *
+ *  All segments passing through an intersection are found together (they
+ *  must be adjacent in the status), all their pairs reported, and then they
+ *  are reordered by slope which is their order just right of the point. This
+ *  is what handles several segments through one point, and segments
+ *  starting or ending on another.
+ *
+ *  Vertical segments have no place in the status, as they cross the sweep
+ *  line all at once. Instead, each is "open" between its start and end
+ *  events. Segments ending while it is open are checked against it, and
+ *  once it ends, so is every segment in the status within its y range.
+ *  (Two verticals are never checked, they can only be collinear.)
+ */
+template <typename T>
+class IntersectionSweep final {
+public:
+    using Vector = Vector2<T>;
+    using Result = SegmentIntersection<T>;
+
+    IntersectionSweep(const LineSegment<T> * first, const LineSegment<T> * last);
+
+    std::vector<Result> run();
+
+private:
+    // order of events at the same point matters: everything starting at a
+    // point must be in the status before anything ending there is removed
+    enum EventType { k_start_event, k_cross_event, k_end_event };
+
+    struct Segment {
+        Vector a, b; // a is always left of b (or below if vertical)
+        T slope;
+
+        bool is_vertical() const noexcept { return a.x == b.x; }
+    };
+
+    struct Event {
+        Vector point;
+        EventType type;
+        std::size_t segment, other;
+    };
+
+    struct EventOrder {
+        bool operator () (const Event & lhs, const Event & rhs) const {
+            // std::priority_queue puts the "greatest" first
+            if (lhs.point.x != rhs.point.x) return lhs.point.x > rhs.point.x;
+            if (lhs.point.y != rhs.point.y) return lhs.point.y > rhs.point.y;
+            if (lhs.type    != rhs.type   ) return lhs.type    > rhs.type   ;
+            if (lhs.segment != rhs.segment) return lhs.segment > rhs.segment;
+            return lhs.other > rhs.other;
+        }
+    };
+
+    static constexpr const T k_tolerance = std::numeric_limits<T>::epsilon()*T(128);
+
+    static bool are_very_close(T a, T b) noexcept {
+        using std::abs;
+        return abs(a - b) <= k_tolerance*std::max(T(1), std::max(abs(a), abs(b)));
+    }
+
+    static bool is_left_of(const Vector & a, const Vector & b) noexcept
+        { return a.x < b.x || (a.x == b.x && a.y < b.y); }
+
+    T y_at(std::size_t idx, const Vector & sweep_point) const noexcept;
+
+    bool is_below(std::size_t lhs, std::size_t rhs, const Vector & sweep_point) const noexcept;
+
+    bool passes_through(std::size_t idx, const Vector & point) const noexcept
+        { return are_very_close(y_at(idx, point), point.y); }
+
+    std::size_t position_of(std::size_t idx, const Vector & sweep_point) const;
+
+    void check_pair(std::size_t lhs, std::size_t rhs);
+
+    /** Checks the segment at pos against its neighbors, and against every
+     *  other segment passing through the point (rounding may have left any
+     *  of those between them).
+     */
+    void check_through(std::size_t pos, const Vector & point);
+
+    void on_start(const Event &);
+
+    void on_cross(const Event &);
+
+    void on_end(const Event &);
+
+    void on_vertical_end(std::size_t idx);
+
+    const LineSegment<T> * m_given_segments;
+    std::vector<Segment> m_segments;
+    std::vector<std::size_t> m_status;
+    // all share the sweep line's x
+    std::vector<std::size_t> m_open_verticals;
+    std::priority_queue<Event, std::vector<Event>, EventOrder> m_events;
+    std::unordered_set<std::size_t> m_found_pairs;
+    std::vector<Result> m_results;
+};
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+std::size_t intersect_one_vs_many
+    (const LineSegment<T> & segment, const LineSegment<T> * first,
+     const LineSegment<T> * last, Vector2<T> * out)
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "intersect_one_vs_many: T must be a floating point type.");
+    using namespace exceptions_abbr;
+    if (!detail::is_real(segment)) {
+        throw InvArg("intersect_one_vs_many: given segment must have real "
+                     "components.");
+    }
+    const auto no_solution = get_no_solution_sentinel<Vector2<T>>();
+    const auto p = segment.a;
+    const auto r = segment.b - segment.a;
+    const T low_x  = std::min(segment.a.x, segment.b.x);
+    const T high_x = std::max(segment.a.x, segment.b.x);
+    const T low_y  = std::min(segment.a.y, segment.b.y);
+    const T high_y = std::max(segment.a.y, segment.b.y);
+
+    std::size_t count = 0;
+    for (; first != last; ++first, ++out) {
+        const auto & other = *first;
+        // "&" instead of "&&" on purpose, everything is computed anyway
+        bool hit =   (std::max(other.a.x, other.b.x) >= low_x )
+                   & (std::min(other.a.x, other.b.x) <= high_x)
+                   & (std::max(other.a.y, other.b.y) >= low_y )
+                   & (std::min(other.a.y, other.b.y) <= high_y);
+
+        // same as find_intersection, but the range checks on t and u are
+        // made without dividing
+        T s_x = other.b.x - other.a.x;
+        T s_y = other.b.y - other.a.y;
+        T q_sub_p_x = other.a.x - p.x;
+        T q_sub_p_y = other.a.y - p.y;
+        T r_cross_s = r.x*s_y - r.y*s_x;
+        T t_num     = q_sub_p_x*s_y - q_sub_p_y*s_x;
+        T u_num     = q_sub_p_x*r.y - q_sub_p_y*r.x;
+        T sign      = r_cross_s < T(0) ? T(-1) : T(1);
+        T denom     = sign*r_cross_s;
+        t_num *= sign;
+        u_num *= sign;
+        hit &=   (denom != T(0))
+               & (t_num >= T(0)) & (t_num <= denom)
+               & (u_num >= T(0)) & (u_num <= denom);
+
+        T t = t_num / (hit ? denom : T(1));
+        out->x = hit ? p.x + t*r.x : no_solution.x;
+        out->y = hit ? p.y + t*r.y : no_solution.y;
+        count += hit ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T>
+std::vector<SegmentIntersection<T>> find_all_intersections
+    (const LineSegment<T> * first, const LineSegment<T> * last)
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "find_all_intersections: T must be a floating point type.");
+    using namespace exceptions_abbr;
+    if (!std::all_of(first, last, [](const LineSegment<T> & seg) { return detail::is_real(seg); })) {
+        throw InvArg("find_all_intersections: all segments must have real "
+                     "components.");
+    }
+    return detail::IntersectionSweep<T>(first, last).run();
+}
+
+namespace detail {
+
+template <typename T>
+IntersectionSweep<T>::IntersectionSweep
+    (const LineSegment<T> * first, const LineSegment<T> * last):
+    m_given_segments(first)
+{
+    m_segments.reserve(std::size_t(last - first));
+    for (; first != last; ++first) {
+        Segment seg;
+        seg.a = first->a;
+        seg.b = first->b;
+        if (is_left_of(seg.b, seg.a)) std::swap(seg.a, seg.b);
+        seg.slope = (seg.a.x == seg.b.x) ? std::numeric_limits<T>::infinity()
+                                         : (seg.b.y - seg.a.y) / (seg.b.x - seg.a.x);
+        auto idx = m_segments.size();
+        m_segments.push_back(seg);
+        // a single point never intersects anything (like find_intersection),
+        // and may only get in the way of finding other intersections
+        if (seg.a == seg.b) continue;
+        m_events.push(Event { seg.a, k_start_event, idx, idx });
+        m_events.push(Event { seg.b, k_end_event  , idx, idx });
+    }
+}
+
+template <typename T>
+std::vector<typename IntersectionSweep<T>::Result> IntersectionSweep<T>::run() {
+    while (!m_events.empty()) {
+        auto event = m_events.top();
+        m_events.pop();
+        switch (event.type) {
+        case k_start_event: on_start(event); break;
+        case k_cross_event: on_cross(event); break;
+        case k_end_event  : on_end  (event); break;
+        }
+    }
+    return std::move(m_results);
+}
+
+template <typename T>
+/* private */ T IntersectionSweep<T>::y_at
+    (std::size_t idx, const Vector & sweep_point) const noexcept
+{
+    const auto & seg = m_segments[idx];
+    assert(!seg.is_vertical());
+    if (sweep_point.x <= seg.a.x) return seg.a.y;
+    if (sweep_point.x >= seg.b.x) return seg.b.y;
+    return seg.a.y + (sweep_point.x - seg.a.x)*seg.slope;
+}
+
+template <typename T>
+/* private */ bool IntersectionSweep<T>::is_below
+    (std::size_t lhs, std::size_t rhs, const Vector & sweep_point) const noexcept
+{
+    T lhs_y = y_at(lhs, sweep_point);
+    T rhs_y = y_at(rhs, sweep_point);
+    if (!are_very_close(lhs_y, rhs_y)) return lhs_y < rhs_y;
+    // both pass through the same point, so their order is whatever it is
+    // just right of it
+    const auto & lhs_seg = m_segments[lhs];
+    const auto & rhs_seg = m_segments[rhs];
+    if (lhs_seg.slope != rhs_seg.slope) return lhs_seg.slope < rhs_seg.slope;
+    return lhs < rhs;
+}
+
+template <typename T>
+/* private */ std::size_t IntersectionSweep<T>::position_of
+    (std::size_t idx, const Vector & sweep_point) const
+{
+    // the status is sorted by y, so start looking just below where the
+    // segment should be
+    T y = y_at(idx, sweep_point);
+    auto itr = std::lower_bound(m_status.begin(), m_status.end(), y,
+        [this, &sweep_point](std::size_t other, T y)
+        { return y_at(other, sweep_point) < y && !are_very_close(y_at(other, sweep_point), y); });
+    auto found = std::find(itr, m_status.end(), idx);
+    if (found == m_status.end()) {
+        // rounding may make for a very slightly out of order status
+        found = std::find(m_status.begin(), itr, idx);
+        if (found == itr) return m_status.size();
+    }
+    return std::size_t(found - m_status.begin());
+}
+
+template <typename T>
+/* private */ void IntersectionSweep<T>::check_pair(std::size_t lhs, std::size_t rhs) {
+    if (lhs == rhs) return;
+    if (lhs > rhs) std::swap(lhs, rhs);
+    auto key = lhs*m_segments.size() + rhs;
+    if (m_found_pairs.count(key)) return;
+
+    // segments as given, so that results agree exactly with
+    // find_intersection
+    const auto & lhs_seg = m_given_segments[lhs];
+    const auto & rhs_seg = m_given_segments[rhs];
+    auto point = detail::find_intersection(lhs_seg.a, lhs_seg.b, rhs_seg.a, rhs_seg.b);
+    if (!is_real(point)) return;
+
+    m_found_pairs.insert(key);
+    m_results.push_back(Result { point, lhs, rhs });
+    // a vertical never changes the order of the status
+    if (m_segments[lhs].is_vertical() || m_segments[rhs].is_vertical()) return;
+    m_events.push(Event { point, k_cross_event, lhs, rhs });
+}
+
+template <typename T>
+/* private */ void IntersectionSweep<T>::check_through
+    (std::size_t pos, const Vector & point)
+{
+    auto low = pos, high = pos;
+    while (low > 0 && passes_through(m_status[low - 1], point)) --low;
+    while (high + 1 < m_status.size() && passes_through(m_status[high + 1], point)) ++high;
+    if (low > 0) --low;
+    if (high + 1 < m_status.size()) ++high;
+    for (auto i = low; i != high + 1; ++i) check_pair(m_status[pos], m_status[i]);
+}
+
+template <typename T>
+/* private */ void IntersectionSweep<T>::on_start(const Event & event) {
+    if (m_segments[event.segment].is_vertical()) {
+        m_open_verticals.push_back(event.segment);
+        return;
+    }
+    auto itr = std::lower_bound(m_status.begin(), m_status.end(), event.segment,
+        [this, &event](std::size_t lhs, std::size_t rhs)
+        { return is_below(lhs, rhs, event.point); });
+    itr = m_status.insert(itr, event.segment);
+    check_through(std::size_t(itr - m_status.begin()), event.point);
+}
+
+template <typename T>
+/* private */ void IntersectionSweep<T>::on_cross(const Event & event) {
+    auto lhs_pos = position_of(event.segment, event.point);
+    auto rhs_pos = position_of(event.other  , event.point);
+    // either may have already ended here
+    if (lhs_pos == m_status.size() || rhs_pos == m_status.size()) return;
+
+    auto low  = std::min(lhs_pos, rhs_pos);
+    auto high = std::max(lhs_pos, rhs_pos);
+    while (low > 0 && passes_through(m_status[low - 1], event.point)) --low;
+    while (high + 1 < m_status.size() && passes_through(m_status[high + 1], event.point)) ++high;
+
+    for (auto i = low; i != high + 1; ++i) {
+    for (auto j = i + 1; j != high + 1; ++j) {
+        check_pair(m_status[i], m_status[j]);
+    }}
+    std::sort(m_status.begin() + low, m_status.begin() + high + 1,
+        [this](std::size_t lhs, std::size_t rhs) {
+            const auto & lhs_seg = m_segments[lhs];
+            const auto & rhs_seg = m_segments[rhs];
+            if (lhs_seg.slope != rhs_seg.slope) return lhs_seg.slope < rhs_seg.slope;
+            return lhs < rhs;
+        });
+    if (low > 0) check_pair(m_status[low - 1], m_status[low]);
+    if (high + 1 < m_status.size()) check_pair(m_status[high], m_status[high + 1]);
+}
+
+template <typename T>
+/* private */ void IntersectionSweep<T>::on_end(const Event & event) {
+    if (m_segments[event.segment].is_vertical())
+        { return on_vertical_end(event.segment); }
+    for (auto vertical : m_open_verticals) check_pair(vertical, event.segment);
+    auto pos = position_of(event.segment, event.point);
+    if (pos == m_status.size()) return;
+    check_through(pos, event.point);
+    if (pos > 0 && pos + 1 < m_status.size())
+        { check_pair(m_status[pos - 1], m_status[pos + 1]); }
+    m_status.erase(m_status.begin() + pos);
+}
+
+template <typename T>
+/* private */ void IntersectionSweep<T>::on_vertical_end(std::size_t idx) {
+    // everything starting on the segment is in the status by now, and
+    // everything that ended on it was checked as it ended
+    const auto & seg = m_segments[idx];
+    auto is_under = [this, &seg](std::size_t other) {
+        T y = y_at(other, seg.b);
+        return y < seg.a.y && !are_very_close(y, seg.a.y);
+    };
+    auto itr = std::partition_point(m_status.begin(), m_status.end(), is_under);
+    for (; itr != m_status.end(); ++itr) {
+        T y = y_at(*itr, seg.b);
+        if (y > seg.b.y && !are_very_close(y, seg.b.y)) break;
+        check_pair(idx, *itr);
+    }
+    m_open_verticals.erase(std::find(m_open_verticals.begin(), m_open_verticals.end(), idx));
+}
+
+} // end of detail namespace -> into ::cul
+
+} // end of cul namespace
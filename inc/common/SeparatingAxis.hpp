@@ -0,0 +1,497 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2Array.hpp>
+#include <common/Polygon.hpp>
+
+#include <vector>
+#include <limits>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace cul {
+
+template <typename T>
+struct Circle {
+    Circle() {}
+
+    Circle(const Vector2<T> & center_, T radius_):
+        center(center_), radius(radius_)
+    {}
+
+    Vector2<T> center;
+    T radius = T(0);
+};
+
+/** Result of a separating axis test between two shapes. */
+template <typename T>
+struct MinimumTranslation {
+    bool is_overlapping = false;
+    /** unit direction to move the first shape out of the second */
+    Vector2<T> normal;
+    /** distance to move along normal, zero if not overlapping */
+    T depth = T(0);
+
+    /** @returns the minimum translation vector, for the first shape */
+    Vector2<T> translation() const { return normal*depth; }
+};
+
+/** A convex polygon, with the axes (edge normals) needed for separating axis
+ *  tests computed once when made.
+ *
+ *  Vertices and axes are kept as separate x and y arrays, so that projecting
+ *  a polygon onto an axis is one tight loop.
+ */
+template <typename T>
+class ConvexPolygon final {
+public:
+    static_assert(std::is_floating_point_v<T>,
+                  "ConvexPolygon: T must be a floating point type.");
+
+    ConvexPolygon() {}
+
+    /** @throws if there are fewer than three vertices, if any component is
+     *          not a real number, or if the polygon is not convex (vertices
+     *          may be in either winding)
+     */
+    ConvexPolygon(const Vector2<T> * first, const Vector2<T> * last);
+
+    explicit ConvexPolygon(const std::vector<Vector2<T>> & vertices):
+        ConvexPolygon(vertices.data(), vertices.data() + vertices.size())
+    {}
+
+    const Vector2Array<T> & vertices() const noexcept { return m_vertices; }
+
+    /** @returns unit normals of each edge (zero length edges have none) */
+    const Vector2Array<T> & axes() const noexcept { return m_axes; }
+
+    std::size_t size() const noexcept { return m_vertices.size(); }
+
+private:
+    Vector2Array<T> m_vertices;
+    Vector2Array<T> m_axes;
+};
+
+/** Many circles and convex polygons, all kept together in flat arrays of
+ *  separate x and y values, for testing many pairs at a time.
+ */
+template <typename T>
+class ConvexShapeSet final {
+public:
+    using ShapeIndex = std::size_t;
+    using ShapePair  = std::pair<ShapeIndex, ShapeIndex>;
+
+    /** @throws if any component of the circle is not real, or if its radius
+     *          is negative
+     */
+    ShapeIndex add(const Circle<T> &);
+
+    ShapeIndex add(const ConvexPolygon<T> &);
+
+    /** Removes all shapes, keeping all memory for reuse. */
+    void clear();
+
+    std::size_t size() const noexcept { return m_shapes.size(); }
+
+private:
+    template <typename U>
+    friend std::size_t find_minimum_translations
+        (const ConvexShapeSet<U> &, const typename ConvexShapeSet<U>::ShapePair *,
+         const typename ConvexShapeSet<U>::ShapePair *, MinimumTranslation<U> *);
+
+    struct ShapeRecord {
+        std::size_t vertices_begin, vertices_end;
+        std::size_t axes_begin, axes_end;
+        T radius;
+    };
+
+    Vector2Array<T> m_vertices;
+    Vector2Array<T> m_axes;
+    std::vector<ShapeRecord> m_shapes;
+};
+
+/** @defgroup separating_axis Separating axis tests
+ *
+ *  Exact overlap tests between convex shapes, which also find the shortest
+ *  translation which separates them. Shapes which only touch do not overlap
+ *  (as "overlaps" for rectangles).
+ *
+ *  @{
+ */
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const ConvexPolygon<T> &, const ConvexPolygon<T> &);
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const ConvexPolygon<T> &, const Circle<T> &);
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const Circle<T> &, const ConvexPolygon<T> &);
+
+/** @note concentric circles are separated along the x axis */
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const Circle<T> &, const Circle<T> &);
+
+/** Separating axis tests for many pairs of shapes (e.g. candidate pairs from
+ *  a broadphase).
+ *
+ *  @param out one result per pair
+ *  @returns number of overlapping pairs
+ */
+template <typename T>
+std::size_t find_minimum_translations
+    (const ConvexShapeSet<T> &, const typename ConvexShapeSet<T>::ShapePair * first,
+     const typename ConvexShapeSet<T>::ShapePair * last, MinimumTranslation<T> * out);
+
+/** @} */
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+/** Any shape for separating axis tests: the convex hull of some vertices
+ *  grown by a radius. Only single vertex shapes (circles) may have a radius.
+ */
+template <typename T>
+struct ConvexShapeView {
+    const T * x, * y;
+    std::size_t vertex_count;
+    const T * axis_x, * axis_y;
+    std::size_t axis_count;
+    T radius;
+};
+
+template <typename T>
+ConvexShapeView<T> make_shape_view
+    (const Vector2Array<T> & vertices, const Vector2Array<T> & axes,
+     std::size_t vertices_begin, std::size_t vertices_end,
+     std::size_t axes_begin, std::size_t axes_end, T radius) noexcept
+{
+    ConvexShapeView<T> rv;
+    rv.x = vertices.x_data() + vertices_begin;
+    rv.y = vertices.y_data() + vertices_begin;
+    rv.vertex_count = vertices_end - vertices_begin;
+    rv.axis_x = axes.x_data() + axes_begin;
+    rv.axis_y = axes.y_data() + axes_begin;
+    rv.axis_count = axes_end - axes_begin;
+    rv.radius = radius;
+    return rv;
+}
+
+template <typename T>
+ConvexShapeView<T> make_shape_view(const ConvexPolygon<T> & polygon) noexcept {
+    return make_shape_view(polygon.vertices(), polygon.axes(), 0,
+                           polygon.vertices().size(), 0, polygon.axes().size(), T(0));
+}
+
+template <typename T>
+ConvexShapeView<T> make_shape_view(const Circle<T> & circle) noexcept {
+    ConvexShapeView<T> rv;
+    rv.x = &circle.center.x;
+    rv.y = &circle.center.y;
+    rv.vertex_count = 1;
+    rv.axis_x = rv.axis_y = nullptr;
+    rv.axis_count = 0;
+    rv.radius = circle.radius;
+    return rv;
+}
+
+template <typename T>
+void verify_circle(const char * caller, const Circle<T> & circle) {
+    using namespace exceptions_abbr;
+    if (is_real(circle.center) && is_real(circle.radius) && circle.radius >= T(0))
+        return;
+    throw InvArg(std::string(caller) + ": circle must have a real center and a "
+                 "non-negative real radius.");
+}
+
+template <typename T>
+void project_shape
+    (const ConvexShapeView<T> & shape, T axis_x, T axis_y, T & low, T & high) noexcept
+{
+    low  =  std::numeric_limits<T>::infinity();
+    high = -std::numeric_limits<T>::infinity();
+    for (std::size_t i = 0; i != shape.vertex_count; ++i) {
+        T d = shape.x[i]*axis_x + shape.y[i]*axis_y;
+        low  = std::min(low , d);
+        high = std::max(high, d);
+    }
+    low  -= shape.radius;
+    high += shape.radius;
+}
+
+/** Projects both shapes onto an axis, keeping it in best if it has the least
+ *  overlap yet.
+ *  @returns false if this is a separating axis
+ */
+template <typename T>
+bool test_separating_axis
+    (const ConvexShapeView<T> & a, const ConvexShapeView<T> & b,
+     T axis_x, T axis_y, MinimumTranslation<T> & best) noexcept
+{
+    T low_a, high_a, low_b, high_b;
+    project_shape(a, axis_x, axis_y, low_a, high_a);
+    project_shape(b, axis_x, axis_y, low_b, high_b);
+    // a moving down along the axis, or up
+    T down = high_a - low_b;
+    T up   = high_b - low_a;
+    T overlap = std::min(down, up);
+    if (!(overlap > T(0))) return false;
+    if (overlap < best.depth) {
+        T sign = down < up ? T(-1) : T(1);
+        best.depth  = overlap;
+        best.normal = Vector2<T>(axis_x*sign, axis_y*sign);
+    }
+    return true;
+}
+
+/** Tests the axis from a circle's center to the nearest vertex of the other
+ *  shape.
+ */
+template <typename T>
+bool test_circle_axis
+    (const ConvexShapeView<T> & circle, const ConvexShapeView<T> & other,
+     const ConvexShapeView<T> & a, const ConvexShapeView<T> & b,
+     MinimumTranslation<T> & best) noexcept
+{
+    T cx = circle.x[0], cy = circle.y[0];
+    T best_dist = std::numeric_limits<T>::infinity();
+    T dx = T(0), dy = T(0);
+    for (std::size_t i = 0; i != other.vertex_count; ++i) {
+        T vx = other.x[i] - cx, vy = other.y[i] - cy;
+        T dist = vx*vx + vy*vy;
+        bool nearer = dist < best_dist;
+        best_dist = nearer ? dist : best_dist;
+        dx = nearer ? vx : dx;
+        dy = nearer ? vy : dy;
+    }
+    // nothing to learn from a vertex on the center
+    if (!(best_dist > T(0))) return true;
+    using std::sqrt;
+    T inv = T(1) / sqrt(best_dist);
+    return test_separating_axis(a, b, dx*inv, dy*inv, best);
+}
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const ConvexShapeView<T> & a, const ConvexShapeView<T> & b) noexcept
+{
+    MinimumTranslation<T> rv;
+    if (a.vertex_count == 0 || b.vertex_count == 0) return rv;
+    rv.depth = std::numeric_limits<T>::infinity();
+    auto fail = [&rv] {
+        rv = MinimumTranslation<T>();
+        return rv;
+    };
+    for (std::size_t i = 0; i != a.axis_count; ++i) {
+        if (!test_separating_axis(a, b, a.axis_x[i], a.axis_y[i], rv))
+            { return fail(); }
+    }
+    for (std::size_t i = 0; i != b.axis_count; ++i) {
+        if (!test_separating_axis(a, b, b.axis_x[i], b.axis_y[i], rv))
+            { return fail(); }
+    }
+    if (a.radius > T(0) && !test_circle_axis(a, b, a, b, rv)) return fail();
+    if (b.radius > T(0) && !test_circle_axis(b, a, a, b, rv)) return fail();
+    // only concentric circles (or points) have no axis to test
+    if (rv.depth == std::numeric_limits<T>::infinity() &&
+        !test_separating_axis(a, b, T(1), T(0), rv))
+    { return fail(); }
+    rv.is_overlapping = true;
+    return rv;
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+ConvexPolygon<T>::ConvexPolygon
+    (const Vector2<T> * first, const Vector2<T> * last)
+{
+    using namespace exceptions_abbr;
+    std::size_t count = std::size_t(last - first);
+    if (count < 3) {
+        throw InvArg("ConvexPolygon::ConvexPolygon: polygon must have at least "
+                     "three vertices.");
+    }
+    // convex: every turn is the same way (collinear vertices are fine)
+    bool has_left = false, has_right = false;
+    for (std::size_t i = 0; i != count; ++i) {
+        const auto & a = first[i];
+        if (!is_real(a)) {
+            throw InvArg("ConvexPolygon::ConvexPolygon: all vertices must have "
+                         "real components.");
+        }
+        T turn = detail::doubled_signed_area(
+            a, first[(i + 1) % count], first[(i + 2) % count]);
+        has_left  |= turn > T(0);
+        has_right |= turn < T(0);
+    }
+    // ...and it winds around only once (a star's turns all go the same way
+    // too), so edges reverse their horizontal/vertical direction at most
+    // twice each
+    auto reversals_of = [first, count](T Vector2<T>::*component) {
+        int rv = 0;
+        int last_sign = 0;
+        // twice around, so that the reversal across the wrap counts once
+        for (std::size_t i = 0; i != count*2; ++i) {
+            T delta = first[(i + 1) % count].*component - first[i % count].*component;
+            int sign = int(delta > T(0)) - int(delta < T(0));
+            if (sign == 0) continue;
+            if (i >= count && last_sign != 0 && sign != last_sign) ++rv;
+            last_sign = sign;
+        }
+        return rv;
+    };
+    if (   (has_left && has_right)
+        || reversals_of(&Vector2<T>::x) > 2 || reversals_of(&Vector2<T>::y) > 2)
+    {
+        throw InvArg("ConvexPolygon::ConvexPolygon: polygon must be convex.");
+    }
+
+    m_vertices.reserve(count);
+    m_axes.reserve(count);
+    for (std::size_t i = 0; i != count; ++i) {
+        const auto & a = first[i];
+        const auto & b = first[(i + 1) % count];
+        m_vertices.push_back(a);
+        if (a == b) continue;
+        m_axes.push_back(normalize(Vector2<T>(b.y - a.y, a.x - b.x)));
+    }
+}
+
+template <typename T>
+typename ConvexShapeSet<T>::ShapeIndex
+    ConvexShapeSet<T>::add(const Circle<T> & circle)
+{
+    detail::verify_circle("ConvexShapeSet::add", circle);
+    ShapeRecord rec;
+    rec.vertices_begin = m_vertices.size();
+    m_vertices.push_back(circle.center);
+    rec.vertices_end = m_vertices.size();
+    rec.axes_begin = rec.axes_end = m_axes.size();
+    rec.radius = circle.radius;
+    m_shapes.push_back(rec);
+    return m_shapes.size() - 1;
+}
+
+template <typename T>
+typename ConvexShapeSet<T>::ShapeIndex
+    ConvexShapeSet<T>::add(const ConvexPolygon<T> & polygon)
+{
+    ShapeRecord rec;
+    rec.vertices_begin = m_vertices.size();
+    for (std::size_t i = 0; i != polygon.vertices().size(); ++i)
+        { m_vertices.push_back(polygon.vertices()[i]); }
+    rec.vertices_end = m_vertices.size();
+    rec.axes_begin = m_axes.size();
+    for (std::size_t i = 0; i != polygon.axes().size(); ++i)
+        { m_axes.push_back(polygon.axes()[i]); }
+    rec.axes_end = m_axes.size();
+    rec.radius = T(0);
+    m_shapes.push_back(rec);
+    return m_shapes.size() - 1;
+}
+
+template <typename T>
+void ConvexShapeSet<T>::clear() {
+    m_vertices.clear();
+    m_axes.clear();
+    m_shapes.clear();
+}
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const ConvexPolygon<T> & a, const ConvexPolygon<T> & b)
+{
+    return detail::find_minimum_translation(
+        detail::make_shape_view(a), detail::make_shape_view(b));
+}
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const ConvexPolygon<T> & a, const Circle<T> & b)
+{
+    detail::verify_circle("find_minimum_translation", b);
+    return detail::find_minimum_translation(
+        detail::make_shape_view(a), detail::make_shape_view(b));
+}
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const Circle<T> & a, const ConvexPolygon<T> & b)
+{
+    detail::verify_circle("find_minimum_translation", a);
+    return detail::find_minimum_translation(
+        detail::make_shape_view(a), detail::make_shape_view(b));
+}
+
+template <typename T>
+MinimumTranslation<T> find_minimum_translation
+    (const Circle<T> & a, const Circle<T> & b)
+{
+    static_assert(std::is_floating_point_v<T>,
+                  "find_minimum_translation: T must be a floating point type.");
+    detail::verify_circle("find_minimum_translation", a);
+    detail::verify_circle("find_minimum_translation", b);
+    return detail::find_minimum_translation(
+        detail::make_shape_view(a), detail::make_shape_view(b));
+}
+
+template <typename T>
+std::size_t find_minimum_translations
+    (const ConvexShapeSet<T> & set, const typename ConvexShapeSet<T>::ShapePair * first,
+     const typename ConvexShapeSet<T>::ShapePair * last, MinimumTranslation<T> * out)
+{
+    using namespace exceptions_abbr;
+    auto view_of = [&set](std::size_t idx) {
+        if (idx >= set.m_shapes.size()) {
+            throw OorError("find_minimum_translations: shape index out of "
+                           "range.");
+        }
+        const auto & rec = set.m_shapes[idx];
+        return detail::make_shape_view(
+            set.m_vertices, set.m_axes, rec.vertices_begin, rec.vertices_end,
+            rec.axes_begin, rec.axes_end, rec.radius);
+    };
+    std::size_t count = 0;
+    for (; first != last; ++first, ++out) {
+        *out = detail::find_minimum_translation(view_of(first->first), view_of(first->second));
+        count += out->is_overlapping ? 1 : 0;
+    }
+    return count;
+}
+
+} // end of cul namespace
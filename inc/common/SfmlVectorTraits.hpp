@@ -42,12 +42,16 @@ struct Vector2Traits<T, sf::Vector2<T>> {
     static constexpr const bool k_should_define_operators = false;
 
     struct GetX {
-        T   operator () (const sf::Vector2<T> & r) const { return r.x; }
-        T & operator () (      sf::Vector2<T> & r) const { return r.x; }
+        constexpr T   operator () (const sf::Vector2<T> & r) const noexcept
+            { return r.x; }
+        constexpr T & operator () (      sf::Vector2<T> & r) const noexcept
+            { return r.x; }
     };
     struct GetY {
-        T   operator () (const sf::Vector2<T> & r) const { return r.y; }
-        T & operator () (      sf::Vector2<T> & r) const { return r.y; }
+        constexpr T   operator () (const sf::Vector2<T> & r) const noexcept
+            { return r.y; }
+        constexpr T & operator () (      sf::Vector2<T> & r) const noexcept
+            { return r.y; }
     };
 };
 
@@ -0,0 +1,282 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Util.hpp>
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <functional>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace cul {
+
+/** A stable reference to an element of a SlotMap.
+ *
+ *  Handles stay valid no matter how many other elements are inserted or
+ *  erased, and become stale (safely) once their own element is erased.
+ *  A default constructed handle is "null", and never refers to anything,
+ *  so handles may be stored in a Grid (or anything else that needs default
+ *  values).
+ */
+struct SlotMapHandle {
+    static constexpr const std::uint32_t k_null_index
+        = std::numeric_limits<std::uint32_t>::max();
+
+    constexpr SlotMapHandle() noexcept {}
+
+    constexpr SlotMapHandle(std::uint32_t index_, std::uint32_t generation_) noexcept:
+        index(index_), generation(generation_)
+    {}
+
+    constexpr bool is_null() const noexcept { return generation == 0; }
+
+    constexpr bool operator == (const SlotMapHandle & rhs) const noexcept
+        { return index == rhs.index && generation == rhs.generation; }
+
+    constexpr bool operator != (const SlotMapHandle & rhs) const noexcept
+        { return !(*this == rhs); }
+
+    std::uint32_t index      = k_null_index;
+    std::uint32_t generation = 0;
+};
+
+/** Container with stable handles to its elements, and contiguous storage for
+ *  fast iteration.
+ *
+ *  Insertion and erasure are O(1), erasure moves the last element into the
+ *  erased element's place (so order is not kept). Looking up an element by
+ *  handle costs two indirections.
+ *
+ *  @note a slot's generation wraps after 2^32 - 1 reuses, a handle kept
+ *        around for that long may refer to a newer element
+ */
+template <typename T>
+class SlotMap {
+public:
+    using Handle        = SlotMapHandle;
+    using Iterator      = typename std::vector<T>::iterator;
+    using ConstIterator = typename std::vector<T>::const_iterator;
+
+    Handle insert(const T & obj) { return emplace(obj); }
+
+    Handle insert(T && obj) { return emplace(std::move(obj)); }
+
+    template <typename ... Types>
+    Handle emplace(Types && ... args);
+
+    /** Erases the element referred to by the given handle.
+     *  @returns false if the handle is stale or null (and nothing is erased)
+     */
+    bool erase(Handle);
+
+    /** @returns element referred to by the handle, or nullptr if the handle
+     *           is stale or null
+     */
+    T * find(Handle) noexcept;
+
+    const T * find(Handle) const noexcept;
+
+    /** @throws if the handle is stale or null
+     *  @returns element referred to by the handle
+     */
+    T & at(Handle);
+
+    const T & at(Handle) const;
+
+    bool contains(Handle handle) const noexcept
+        { return find(handle) != nullptr; }
+
+    /** @returns handle to the element at the given position of iteration
+     *  @note positions are only stable until the next erase
+     */
+    Handle handle_of(ConstIterator) const;
+
+    /** Erases all elements, all handles become stale. */
+    void clear();
+
+    void reserve(std::size_t);
+
+    std::size_t size() const noexcept { return m_elements.size(); }
+
+    bool is_empty() const noexcept { return m_elements.empty(); }
+
+    Iterator begin() { return m_elements.begin(); }
+    Iterator end  () { return m_elements.end  (); }
+
+    ConstIterator begin() const { return m_elements.begin(); }
+    ConstIterator end  () const { return m_elements.end  (); }
+
+private:
+    struct Slot {
+        // index into elements for a live slot, or the next free slot
+        std::uint32_t element_or_next_free = Handle::k_null_index;
+        std::uint32_t generation = 1;
+    };
+
+    static constexpr const std::uint32_t k_no_slot = Handle::k_null_index;
+
+    const Slot * find_live_slot(Handle) const noexcept;
+
+    void retire_slot(std::uint32_t slot_index) noexcept;
+
+    std::vector<T> m_elements;
+    // element index -> owning slot index
+    std::vector<std::uint32_t> m_element_slots;
+    std::vector<Slot> m_slots;
+    std::uint32_t m_free_head = k_no_slot;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+template <typename ... Types>
+typename SlotMap<T>::Handle SlotMap<T>::emplace(Types && ... args) {
+    using namespace exceptions_abbr;
+    if (m_elements.size() >= k_no_slot - 1) {
+        throw RtError("SlotMap::emplace: cannot hold any more elements.");
+    }
+    auto element_index = std::uint32_t(m_elements.size());
+    m_elements.emplace_back(std::forward<Types>(args)...);
+    std::uint32_t slot_index = m_free_head;
+    try {
+        if (slot_index == k_no_slot) {
+            slot_index = std::uint32_t(m_slots.size());
+            m_slots.emplace_back();
+        }
+        m_element_slots.push_back(slot_index);
+    } catch (...) {
+        m_elements.pop_back();
+        throw;
+    }
+    auto & slot = m_slots[slot_index];
+    if (slot_index == m_free_head) m_free_head = slot.element_or_next_free;
+    slot.element_or_next_free = element_index;
+    return Handle(slot_index, slot.generation);
+}
+
+template <typename T>
+bool SlotMap<T>::erase(Handle handle) {
+    if (!find_live_slot(handle)) return false;
+    auto element_index = m_slots[handle.index].element_or_next_free;
+    auto last_index    = std::uint32_t(m_elements.size() - 1);
+    if (element_index != last_index) {
+        m_elements     [element_index] = std::move(m_elements.back());
+        m_element_slots[element_index] = m_element_slots.back();
+        m_slots[m_element_slots[element_index]].element_or_next_free = element_index;
+    }
+    m_elements.pop_back();
+    m_element_slots.pop_back();
+    retire_slot(handle.index);
+    return true;
+}
+
+template <typename T>
+T * SlotMap<T>::find(Handle handle) noexcept {
+    const auto * slot = find_live_slot(handle);
+    return slot ? &m_elements[slot->element_or_next_free] : nullptr;
+}
+
+template <typename T>
+const T * SlotMap<T>::find(Handle handle) const noexcept {
+    const auto * slot = find_live_slot(handle);
+    return slot ? &m_elements[slot->element_or_next_free] : nullptr;
+}
+
+template <typename T>
+T & SlotMap<T>::at(Handle handle) {
+    const auto & const_this = *this;
+    return const_cast<T &>(const_this.at(handle));
+}
+
+template <typename T>
+const T & SlotMap<T>::at(Handle handle) const {
+    using namespace exceptions_abbr;
+    if (const auto * obj = find(handle)) return *obj;
+    throw OorError("SlotMap::at: handle does not refer to a live element.");
+}
+
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::handle_of(ConstIterator itr) const {
+    using namespace exceptions_abbr;
+    if (itr < begin() || itr >= end()) {
+        throw OorError("SlotMap::handle_of: iterator must point to an element "
+                       "of this container.");
+    }
+    auto slot_index = m_element_slots[std::size_t(itr - begin())];
+    return Handle(slot_index, m_slots[slot_index].generation);
+}
+
+template <typename T>
+void SlotMap<T>::clear() {
+    for (auto slot_index : m_element_slots) retire_slot(slot_index);
+    m_elements.clear();
+    m_element_slots.clear();
+}
+
+template <typename T>
+void SlotMap<T>::reserve(std::size_t n) {
+    m_elements.reserve(n);
+    m_element_slots.reserve(n);
+    m_slots.reserve(n);
+}
+
+template <typename T>
+/* private */ const typename SlotMap<T>::Slot *
+    SlotMap<T>::find_live_slot(Handle handle) const noexcept
+{
+    // a free slot's generation is always ahead of any handle made for it
+    if (handle.index >= m_slots.size()) return nullptr;
+    const auto & slot = m_slots[handle.index];
+    return slot.generation == handle.generation ? &slot : nullptr;
+}
+
+template <typename T>
+/* private */ void SlotMap<T>::retire_slot(std::uint32_t slot_index) noexcept {
+    auto & slot = m_slots[slot_index];
+    // zero is reserved for null handles
+    if (++slot.generation == 0) slot.generation = 1;
+    slot.element_or_next_free = m_free_head;
+    m_free_head = slot_index;
+}
+
+} // end of cul namespace
+
+namespace std {
+
+template <>
+struct hash<cul::SlotMapHandle> {
+    std::size_t operator () (const cul::SlotMapHandle & handle) const noexcept {
+        return std::hash<std::uint64_t>()
+            ((std::uint64_t(handle.generation) << 32) | handle.index);
+    }
+};
+
+} // end of std namespace
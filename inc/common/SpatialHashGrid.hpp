@@ -0,0 +1,407 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Grid.hpp>
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Util.hpp>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+namespace cul {
+
+/** A uniform grid of cells over a world, for finding nearby or overlapping
+ *  objects when objects are packed densely and have similar sizes (where it
+ *  does better than a tree like DynamicAabbTree).
+ *
+ *  It is meant to be rebuilt whole, as often as each frame:
+ *  @code
+ *  grid.clear();
+ *  for (auto & obj : scene) grid.add(obj.bounds, obj.id);
+ *  grid.rebuild();
+ *  @endcode
+ *  Each object is binned by the cell containing its top left corner. A
+ *  rebuild is a counting sort (one pass to count objects per cell, one to
+ *  place them), so it is O(N), and once the grid has seen as many objects
+ *  before it makes no allocations.
+ *
+ *  Objects outside the world go into the nearest border cell, which still
+ *  works but makes border cells crowded. Objects larger than a cell are fine
+ *  too, but widen the neighborhood each query has to look through.
+ *
+ *  A world must be set (by constructor or set_world) before rebuild. Queries
+ *  are only valid after rebuild, and are exact: overlapping is as
+ *  "overlaps". Query callbacks may return a FlowControlSignal to stop
+ *  early.
+ *
+ *  @tparam Payload anything, stored with each object
+ */
+template <typename Payload>
+class SpatialHashGrid final {
+public:
+    using ObjectIndex = std::uint32_t;
+    using RectangleType = Rectangle<float>;
+    using VectorType = Vector2<float>;
+
+    /** Range of indices (into the grid's sorted objects) of one cell. */
+    struct CellRange {
+        std::uint32_t begin = 0, end = 0;
+    };
+
+    SpatialHashGrid() {}
+
+    /** @throws if the cell size is not positive or the world is empty */
+    SpatialHashGrid(const RectangleType & world_bounds, float cell_size)
+        { set_world(world_bounds, cell_size); }
+
+    /** Sets the world covered by cells, objects are kept but the grid must
+     *  be rebuilt.
+     *
+     *  @throws if the cell size is not positive or the world is empty
+     */
+    void set_world(const RectangleType & world_bounds, float cell_size);
+
+    /** Adds an object, which is not found by queries until the next rebuild.
+     *  @returns index of the object, valid until clear
+     */
+    ObjectIndex add(const RectangleType & bounds, Payload payload);
+
+    /** Removes all objects, keeping all memory for the next frame. */
+    void clear();
+
+    /** Sorts all objects into their cells.
+     *
+     *  Needs a world (see set_world), without one this does nothing and
+     *  queries find nothing.
+     */
+    void rebuild();
+
+    /** Reserves room for this many objects. */
+    void reserve(std::size_t);
+
+    std::size_t size() const noexcept { return m_bounds.size(); }
+
+    bool is_empty() const noexcept { return m_bounds.empty(); }
+
+    const RectangleType & bounds_of(ObjectIndex idx) const { return m_bounds[idx]; }
+
+    Payload & payload_of(ObjectIndex idx) { return m_payloads[idx]; }
+
+    const Payload & payload_of(ObjectIndex idx) const { return m_payloads[idx]; }
+
+    /** Calls f(ObjectIndex, const Payload &) for every object overlapping the
+     *  given rectangle.
+     */
+    template <typename Func>
+    void query(const RectangleType &, Func && f) const;
+
+    /** Finds up to k objects nearest to a point (by distance to the nearest
+     *  point on the object), searching outward ring by ring of cells.
+     *
+     *  @param out must have room for k indices, they are written nearest
+     *         first
+     *  @returns number of indices written, k unless there are fewer objects
+     */
+    std::size_t find_k_nearest(const VectorType &, std::size_t k, ObjectIndex * out) const;
+
+    /** Calls f(ObjectIndex, ObjectIndex) once for every pair of overlapping
+     *  objects, with the lesser index first. Only neighboring cells are
+     *  searched for each cell.
+     */
+    template <typename Func>
+    void for_each_overlapping_pair(Func && f) const;
+
+    /** @returns all cells, with ranges into sorted_objects */
+    const Grid<CellRange> & cells() const noexcept { return m_cells; }
+
+    /** @returns object indices, sorted by cell */
+    const std::vector<ObjectIndex> & sorted_objects() const noexcept { return m_sorted; }
+
+    float cell_size() const noexcept { return m_cell_size; }
+
+private:
+    using CellPosition = Vector2<int>;
+
+    CellPosition cell_position_of(float x, float y) const noexcept;
+
+    std::size_t to_cell_index(const CellPosition & r) const noexcept
+        { return std::size_t(r.x) + std::size_t(r.y)*std::size_t(m_cells.width()); }
+
+    // how many cells out from an object's own cell can overlap it
+    int neighborhood_radius() const noexcept;
+
+    // squared distance from a point to the nearest point on an object
+    float distance_squared_to(ObjectIndex, const VectorType &) const noexcept;
+
+    template <typename Func>
+    bool for_each_in_cells(const CellPosition & low, const CellPosition & high, Func && f) const;
+
+    std::vector<RectangleType> m_bounds;
+    std::vector<Payload> m_payloads;
+    // flat cell index of each object, from the last rebuild
+    std::vector<std::uint32_t> m_cell_of;
+    std::vector<ObjectIndex> m_sorted;
+    Grid<CellRange> m_cells;
+    VectorType m_origin;
+    float m_cell_size = 1.f;
+    float m_inv_cell_size = 1.f;
+    // largest object width and height, from the last rebuild
+    VectorType m_largest_size;
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename Payload>
+void SpatialHashGrid<Payload>::set_world
+    (const RectangleType & world_bounds, float cell_size)
+{
+    using namespace exceptions_abbr;
+    if (!(cell_size > 0.f)) {
+        throw InvArg("SpatialHashGrid::set_world: cell size must be a positive "
+                     "number.");
+    }
+    if (!(world_bounds.width > 0.f) || !(world_bounds.height > 0.f)) {
+        throw InvArg("SpatialHashGrid::set_world: world must have positive width "
+                     "and height.");
+    }
+    m_origin = top_left_of(world_bounds);
+    m_cell_size = cell_size;
+    m_inv_cell_size = 1.f / cell_size;
+    m_cells.set_size(std::max(1, int(std::ceil(world_bounds.width  / cell_size))),
+                     std::max(1, int(std::ceil(world_bounds.height / cell_size))));
+    std::fill(m_cells.begin(), m_cells.end(), CellRange());
+}
+
+template <typename Payload>
+typename SpatialHashGrid<Payload>::ObjectIndex
+    SpatialHashGrid<Payload>::add(const RectangleType & bounds, Payload payload)
+{
+    m_bounds.push_back(bounds);
+    m_payloads.push_back(std::move(payload));
+    return ObjectIndex(m_bounds.size() - 1);
+}
+
+template <typename Payload>
+void SpatialHashGrid<Payload>::clear() {
+    m_bounds.clear();
+    m_payloads.clear();
+    m_cell_of.clear();
+    m_sorted.clear();
+    std::fill(m_cells.begin(), m_cells.end(), CellRange());
+}
+
+template <typename Payload>
+void SpatialHashGrid<Payload>::rebuild() {
+    // no cells to bin into (like query, there is nothing to do)
+    if (m_cells.is_empty()) return;
+    auto cells = m_cells.begin();
+    std::fill(cells, m_cells.end(), CellRange());
+    m_cell_of.resize(m_bounds.size());
+    m_sorted.resize(m_bounds.size());
+    m_largest_size = VectorType();
+
+    // count, using "end" as each cell's count
+    for (std::size_t i = 0; i != m_bounds.size(); ++i) {
+        const auto & bounds = m_bounds[i];
+        auto cell_idx = to_cell_index(cell_position_of(bounds.left, bounds.top));
+        m_cell_of[i] = std::uint32_t(cell_idx);
+        ++cells[cell_idx].end;
+        m_largest_size.x = std::max(m_largest_size.x, bounds.width );
+        m_largest_size.y = std::max(m_largest_size.y, bounds.height);
+    }
+    // running sum of counts gives where each cell begins, "end" is then
+    // where the next object goes
+    std::uint32_t sum = 0;
+    for (auto itr = cells; itr != m_cells.end(); ++itr) {
+        auto count = itr->end;
+        itr->begin = itr->end = sum;
+        sum += count;
+    }
+    for (std::size_t i = 0; i != m_bounds.size(); ++i)
+        { m_sorted[cells[m_cell_of[i]].end++] = ObjectIndex(i); }
+}
+
+template <typename Payload>
+void SpatialHashGrid<Payload>::reserve(std::size_t n) {
+    m_bounds.reserve(n);
+    m_payloads.reserve(n);
+    m_cell_of.reserve(n);
+    m_sorted.reserve(n);
+}
+
+template <typename Payload>
+template <typename Func>
+void SpatialHashGrid<Payload>::query(const RectangleType & rect, Func && f) const {
+    using namespace fc_signal;
+    if (m_cells.is_empty()) return;
+    // objects are binned by top left, so those overlapping may start up to
+    // their size left and above of the rectangle
+    auto low  = cell_position_of(rect.left - m_largest_size.x, rect.top - m_largest_size.y);
+    auto high = cell_position_of(right_of(rect), bottom_of(rect));
+    for_each_in_cells(low, high, [this, &rect, &f](ObjectIndex idx) {
+        if (!overlaps(m_bounds[idx], rect)) return k_continue;
+        return adapt_to_flow_control_signal(f, idx, m_payloads[idx]);
+    });
+}
+
+template <typename Payload>
+std::size_t SpatialHashGrid<Payload>::find_k_nearest
+    (const VectorType & r, std::size_t k, ObjectIndex * out) const
+{
+    using namespace fc_signal;
+    k = std::min(k, m_sorted.size());
+    if (k == 0 || m_cells.is_empty()) return 0;
+
+    // out is used as a max heap by distance while searching
+    std::size_t count = 0;
+    auto is_nearer = [this, &r](ObjectIndex lhs, ObjectIndex rhs)
+        { return distance_squared_to(lhs, r) < distance_squared_to(rhs, r); };
+    auto center = cell_position_of(r.x, r.y);
+    float largest_size = std::max(m_largest_size.x, m_largest_size.y);
+    int max_ring = std::max(m_cells.width(), m_cells.height());
+    for (int ring = 0; ring <= max_ring; ++ring) {
+        if (count == k) {
+            // nearest any object binned in this ring could be
+            float ring_distance = float(ring - 1)*m_cell_size - largest_size;
+            if (   ring_distance > 0.f
+                && ring_distance*ring_distance > distance_squared_to(out[0], r))
+            { break; }
+        }
+        auto visit = [&](ObjectIndex idx) {
+            if (count < k) {
+                out[count++] = idx;
+                std::push_heap(out, out + count, is_nearer);
+            } else if (is_nearer(idx, out[0])) {
+                std::pop_heap(out, out + count, is_nearer);
+                out[count - 1] = idx;
+                std::push_heap(out, out + count, is_nearer);
+            }
+            return k_continue;
+        };
+        // each ring as four strips: top, bottom, left, right
+        CellPosition low (center.x - ring, center.y - ring);
+        CellPosition high(center.x + ring, center.y + ring);
+        for_each_in_cells(low, CellPosition(high.x, low.y), visit);
+        if (ring == 0) continue;
+        for_each_in_cells(CellPosition(low.x, high.y), high, visit);
+        for_each_in_cells(CellPosition(low.x , low.y + 1), CellPosition(low.x , high.y - 1), visit);
+        for_each_in_cells(CellPosition(high.x, low.y + 1), CellPosition(high.x, high.y - 1), visit);
+    }
+    std::sort_heap(out, out + count, is_nearer);
+    return count;
+}
+
+template <typename Payload>
+template <typename Func>
+void SpatialHashGrid<Payload>::for_each_overlapping_pair(Func && f) const {
+    using namespace fc_signal;
+    const auto cells = m_cells.begin();
+    const int radius = neighborhood_radius();
+    const int width  = m_cells.width();
+    const int height = m_cells.height();
+    auto report = [this, &f](ObjectIndex a, ObjectIndex b) {
+        if (!overlaps(m_bounds[a], m_bounds[b])) return k_continue;
+        return adapt_to_flow_control_signal(f, std::min(a, b), std::max(a, b));
+    };
+    for (int y = 0; y != height; ++y) {
+    for (int x = 0; x != width ; ++x) {
+        const auto & cell = cells[to_cell_index(CellPosition(x, y))];
+        for (auto i = cell.begin; i != cell.end; ++i) {
+            auto a = m_sorted[i];
+            // pairs within the cell
+            for (auto j = i + 1; j != cell.end; ++j) {
+                if (report(a, m_sorted[j]) == k_break) return;
+            }
+            // each pair of different cells is only visited from one of them:
+            // this cell's row to its right, and whole rows below
+            auto report_with_a = [&report, a](ObjectIndex b) { return report(a, b); };
+            if (   !for_each_in_cells(CellPosition(x + 1, y), CellPosition(x + radius, y), report_with_a)
+                || (radius > 0 && y + 1 < height && !for_each_in_cells(
+                        CellPosition(x - radius, y + 1), CellPosition(x + radius, y + radius), report_with_a)))
+            { return; }
+        }
+    }}
+}
+
+template <typename Payload>
+/* private */ typename SpatialHashGrid<Payload>::CellPosition
+    SpatialHashGrid<Payload>::cell_position_of(float x, float y) const noexcept
+{
+    // clamped before converting to int, very far objects would overflow
+    auto to_cell = [this](float pos, float origin, int cell_count) {
+        float cell = std::floor((pos - origin)*m_inv_cell_size);
+        return int(std::clamp(cell, 0.f, float(cell_count - 1)));
+    };
+    return CellPosition(to_cell(x, m_origin.x, m_cells.width ()),
+                        to_cell(y, m_origin.y, m_cells.height()));
+}
+
+template <typename Payload>
+/* private */ int SpatialHashGrid<Payload>::neighborhood_radius() const noexcept {
+    float largest = std::max(m_largest_size.x, m_largest_size.y);
+    float cells = std::ceil(largest*m_inv_cell_size);
+    return int(std::min(cells, float(std::max(m_cells.width(), m_cells.height()))));
+}
+
+template <typename Payload>
+/* private */ float SpatialHashGrid<Payload>::distance_squared_to
+    (ObjectIndex idx, const VectorType & r) const noexcept
+{
+    const auto & bounds = m_bounds[idx];
+    float dx = std::max(0.f, std::max(bounds.left - r.x, r.x - right_of (bounds)));
+    float dy = std::max(0.f, std::max(bounds.top  - r.y, r.y - bottom_of(bounds)));
+    return dx*dx + dy*dy;
+}
+
+template <typename Payload>
+template <typename Func>
+/* private */ bool SpatialHashGrid<Payload>::for_each_in_cells
+    (const CellPosition & low, const CellPosition & high, Func && f) const
+{
+    using namespace fc_signal;
+    const auto cells = m_cells.begin();
+    int low_x  = std::max(low.x , 0), low_y  = std::max(low.y , 0);
+    int high_x = std::min(high.x, m_cells.width () - 1);
+    int high_y = std::min(high.y, m_cells.height() - 1);
+    for (int y = low_y; y <= high_y; ++y) {
+    for (int x = low_x; x <= high_x; ++x) {
+        const auto & cell = cells[to_cell_index(CellPosition(x, y))];
+        for (auto i = cell.begin; i != cell.end; ++i) {
+            if (f(m_sorted[i]) == k_break) return false;
+        }
+    }}
+    return true;
+}
+
+} // end of cul namespace
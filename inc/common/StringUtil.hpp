@@ -32,6 +32,7 @@
 #include <limits>
 
 #include <common/Util.hpp>
+#include <common/Metrics.hpp>
 
 namespace cul {
 
@@ -62,6 +63,18 @@ using EnableStrToNum = typename std::enable_if<
 bool
 >;
 
+namespace detail {
+
+/** Counts a failed string to number conversion (see builtin_metrics).
+ *  @returns false
+ */
+inline bool string_to_number_failed() noexcept {
+    builtin_metrics().string_to_number_failures.add();
+    return false;
+}
+
+} // end of detail namespace -> into ::cul
+
 // <---------------------------- String Utilities ---------------------------->
 
 // These utilities should cover functionality that is NOT easily done via the 
@@ -268,7 +281,7 @@ typename EnableStrToNum<IterType, RealType>::type
      const int k_base) noexcept
 {
     if (k_base < 2 || k_base > 16) {
-        return false;
+        return detail::string_to_number_failed();
 #       if 0
         throw std::runtime_error("bool string_to_number(...): "
                                  "This function supports only bases 2 to 16.");
@@ -290,7 +303,7 @@ typename EnableStrToNum<IterType, RealType>::type
     do {
         switch (*--end) {
         case CharType('.'):
-            if (found_dot) return false;
+            if (found_dot) return detail::string_to_number_failed();
             found_dot = true;
             if (k_is_integer) {
                 if (adder <= k_sign_fix*k_base / RealType(2))
@@ -317,13 +330,13 @@ typename EnableStrToNum<IterType, RealType>::type
         case CharType('D'): case CharType('E'): case CharType('F'):
             adder = k_sign_fix*RealType(*end - 'A' + 10);
             break;
-        default: return false;
+        default: return detail::string_to_number_failed();
         }
-        if (k_sign_fix*adder >= RealType(k_base)) return false;
+        if (k_sign_fix*adder >= RealType(k_base)) return detail::string_to_number_failed();
         // detect overflow
         RealType temp = working + adder*multi;
-        if ( k_is_signed && temp > working) return false;
-        if (!k_is_signed && temp < working) return false;
+        if ( k_is_signed && temp > working) return detail::string_to_number_failed();
+        if (!k_is_signed && temp < working) return detail::string_to_number_failed();
         multi *= RealType(k_base);
         working = temp;
     }
@@ -347,7 +360,7 @@ typename EnableStrToNum<IterType, RealType>::type
     static constexpr bool k_is_integer = !std::is_floating_point<RealType>::value;
     
     if (is_negative) {
-        if (!k_is_signed) return false;
+        if (!k_is_signed) return detail::string_to_number_failed();
         ++begin;
     }
     
@@ -370,7 +383,7 @@ typename EnableStrToNum<IterType, RealType>::type
     }
     if (!is_negative && k_is_signed) {
         if (k_is_integer && temp == std::numeric_limits<RealType>::min()) {
-            return false;
+            return detail::string_to_number_failed();
         }
         temp *= RealType(-1);
     }
@@ -389,7 +402,7 @@ typename EnableStrToNum<IterType, RealType>::type
     static constexpr bool k_is_integer = !std::is_floating_point<RealType>::value;
     
     if (is_negative) {
-        if (!k_is_signed) return false;
+        if (!k_is_signed) return detail::string_to_number_failed();
         ++begin;
     }
     
@@ -401,7 +414,7 @@ typename EnableStrToNum<IterType, RealType>::type
         // is signed non-negative integer whose temp value is the min int...
         // this will result in an overflow!
         if (k_is_integer && temp == std::numeric_limits<RealType>::min()) {
-            return false;
+            return detail::string_to_number_failed();
         }
         temp *= RealType(-1);
     }
@@ -726,6 +726,7 @@ template <bool k_is_const_t, typename T>
     verify_position_ok(int x, int y) const
 {
     if (has_position(x, y)) return;
+    builtin_metrics().bounds_check_throws.add();
     throw std::out_of_range("Position out of range.");
 }
 
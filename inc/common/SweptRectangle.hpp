@@ -0,0 +1,311 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Util.hpp>
+
+#include <vector>
+#include <tuple>
+#include <string>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace cul {
+
+/** Where a moving rectangle first touches an obstacle. */
+template <typename T>
+struct SweepHit {
+    static constexpr const T k_no_impact = std::numeric_limits<T>::infinity();
+
+    /** fraction (0 to 1) of the displacement traveled before touching,
+     *  k_no_impact if the obstacle is never touched
+     */
+    T time_of_impact = k_no_impact;
+
+    /** unit normal of the obstacle's side which was hit (pointing out of the
+     *  obstacle), the zero vector if there is no hit or if the rectangles
+     *  already overlap
+     */
+    Vector2<T> normal;
+
+    bool is_hit() const noexcept { return time_of_impact != k_no_impact; }
+};
+
+/** Result of sliding a rectangle along obstacles. */
+template <typename T>
+struct SlideResult {
+    /** the moved rectangle */
+    Rectangle<T> rectangle;
+
+    /** normal of the last obstacle hit, the zero vector if none was hit */
+    Vector2<T> last_normal;
+
+    /** number of times the displacement was redirected by an obstacle */
+    std::size_t hit_count = 0;
+};
+
+/** Sweeps a moving rectangle along a displacement against one obstacle
+ *  (continuous collision detection), so that thin or small obstacles cannot
+ *  be passed through between discrete positions.
+ *
+ *  Rectangles are hit on the same terms as "overlaps": merely touching is not
+ *  a hit, so sliding along an obstacle's side or moving away from it is not
+ *  either. Moving into a side already touched hits at time zero.
+ *
+ *  @throws if moving or displacement have non real components; obstacles
+ *          with non real components are never hit
+ *  @returns a hit with time of impact zero and a zero normal if the
+ *           rectangles already overlap
+ */
+template <typename T>
+SweepHit<T> sweep
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> & obstacle);
+
+/** Sweeps a moving rectangle against a sequence of obstacles.
+ *
+ *  Obstacles outside of the bounds swept by the rectangle are rejected
+ *  without further work, and the search ends early if any hit at time zero.
+ *
+ *  @throws if moving or displacement have non real components
+ *  @returns the earliest hit (the first obstacle for ties), and the index of
+ *           that obstacle (only meaningful if there is a hit)
+ */
+template <typename T>
+Tuple<SweepHit<T>, std::size_t> sweep
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> * first, const Rectangle<T> * last);
+
+template <typename T>
+Tuple<SweepHit<T>, std::size_t> sweep
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const std::vector<Rectangle<T>> & obstacles)
+{ return sweep(moving, displacement, obstacles.data(), obstacles.data() + obstacles.size()); }
+
+/** Moves a rectangle along a displacement, and whenever it hits an obstacle
+ *  "slides" along that obstacle with what is left of the displacement (the
+ *  part into the obstacle is removed).
+ *
+ *  This repeats until the displacement is consumed, or until max_hits
+ *  obstacles are hit (stopping against the last one). A max_hits of zero
+ *  behaves like one, the rectangle never moves into an obstacle. The
+ *  rectangle is placed exactly against sides hit, so that later sweeps do
+ *  not start inside obstacles. Obstacles which the rectangle already
+ *  overlaps are ignored, so that it may move out of them.
+ *
+ *  @throws if moving or displacement have non real components
+ */
+template <typename T>
+SlideResult<T> slide
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> * first, const Rectangle<T> * last,
+     std::size_t max_hits = 4);
+
+template <typename T>
+SlideResult<T> slide
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const std::vector<Rectangle<T>> & obstacles, std::size_t max_hits = 4)
+{
+    return slide(moving, displacement, obstacles.data(),
+                 obstacles.data() + obstacles.size(), max_hits);
+}
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+/** Times (as fractions of d) during which point p is inside the open
+ *  interval (low, high) on one axis.
+ *  @returns false if it never is
+ */
+template <typename T>
+bool find_sweep_interval
+    (T p, T d, T low, T high, T & enter, T & exit) noexcept
+{
+    if (d == T(0)) {
+        enter = -std::numeric_limits<T>::infinity();
+        exit  =  std::numeric_limits<T>::infinity();
+        return low < p && p < high;
+    }
+    T t_low  = (low  - p) / d;
+    T t_high = (high - p) / d;
+    enter = std::min(t_low, t_high);
+    exit  = std::max(t_low, t_high);
+    return true;
+}
+
+/** sweep, with all arguments known to be real */
+template <typename T>
+SweepHit<T> find_sweep_hit
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> & obstacle) noexcept
+{
+    // the obstacle is grown by the moving rectangle's size, which shrinks the
+    // moving rectangle to its top left point, tracing a ray
+    SweepHit<T> rv;
+    T enter_x, exit_x, enter_y, exit_y;
+    if (!find_sweep_interval(moving.left, displacement.x,
+                             obstacle.left - moving.width, right_of(obstacle),
+                             enter_x, exit_x))
+    { return rv; }
+    if (!find_sweep_interval(moving.top, displacement.y,
+                             obstacle.top - moving.height, bottom_of(obstacle),
+                             enter_y, exit_y))
+    { return rv; }
+
+    T enter = std::max(enter_x, enter_y);
+    T exit  = std::min(exit_x , exit_y );
+    if (!(enter < exit) || enter > T(1) || !(exit > T(0))) return rv;
+    if (enter < T(0)) {
+        // already overlapping
+        rv.time_of_impact = T(0);
+        return rv;
+    }
+    rv.time_of_impact = enter;
+    if (enter_x >= enter_y) {
+        rv.normal.x = displacement.x > T(0) ? T(-1) : T(1);
+    } else {
+        rv.normal.y = displacement.y > T(0) ? T(-1) : T(1);
+    }
+    return rv;
+}
+
+template <typename T>
+bool is_real(const Rectangle<T> & rect) noexcept {
+    return    cul::is_real(rect.left ) && cul::is_real(rect.top   )
+           && cul::is_real(rect.width) && cul::is_real(rect.height);
+}
+
+template <typename T>
+void verify_sweep_arguments
+    (const char * caller, const Rectangle<T> & moving,
+     const Vector2<T> & displacement)
+{
+    using namespace exceptions_abbr;
+    static_assert(std::is_floating_point_v<T>,
+                  "sweep: T must be a floating point type.");
+    if (is_real(moving) && cul::is_real(displacement)) return;
+    throw InvArg(std::string(caller) + ": moving rectangle and displacement "
+                 "must have real components.");
+}
+
+template <typename T>
+Tuple<SweepHit<T>, std::size_t> find_earliest_sweep_hit
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> * first, const Rectangle<T> * last,
+     bool ignore_overlapping) noexcept
+{
+    // everything the moving rectangle passes over, the "&"s are on purpose:
+    // NaN obstacles fail any of these comparisons
+    const T low_x  = moving.left + std::min(displacement.x, T(0));
+    const T low_y  = moving.top  + std::min(displacement.y, T(0));
+    const T high_x = right_of (moving) + std::max(displacement.x, T(0));
+    const T high_y = bottom_of(moving) + std::max(displacement.y, T(0));
+
+    SweepHit<T> best;
+    std::size_t best_index = 0;
+    for (auto itr = first; itr != last; ++itr) {
+        const auto & obstacle = *itr;
+        bool near =   (right_of (obstacle) >= low_x) & (obstacle.left <= high_x)
+                    & (bottom_of(obstacle) >= low_y) & (obstacle.top  <= high_y);
+        if (!near) continue;
+        auto hit = find_sweep_hit(moving, displacement, obstacle);
+        if (ignore_overlapping && hit.time_of_impact == T(0) && hit.normal == Vector2<T>())
+            { continue; }
+        if (!(hit.time_of_impact < best.time_of_impact)) continue;
+        best = hit;
+        best_index = std::size_t(itr - first);
+        // nothing can be hit any earlier
+        if (best.time_of_impact == T(0)) break;
+    }
+    return std::make_tuple(best, best_index);
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+SweepHit<T> sweep
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> & obstacle)
+{
+    detail::verify_sweep_arguments("sweep", moving, displacement);
+    if (!detail::is_real(obstacle)) return SweepHit<T>();
+    return detail::find_sweep_hit(moving, displacement, obstacle);
+}
+
+template <typename T>
+Tuple<SweepHit<T>, std::size_t> sweep
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> * first, const Rectangle<T> * last)
+{
+    detail::verify_sweep_arguments("sweep", moving, displacement);
+    return detail::find_earliest_sweep_hit(moving, displacement, first, last, false);
+}
+
+template <typename T>
+SlideResult<T> slide
+    (const Rectangle<T> & moving, const Vector2<T> & displacement,
+     const Rectangle<T> * first, const Rectangle<T> * last,
+     std::size_t max_hits)
+{
+    detail::verify_sweep_arguments("slide", moving, displacement);
+    SlideResult<T> rv;
+    rv.rectangle = moving;
+    auto & rect = rv.rectangle;
+    auto remaining = displacement;
+    while (remaining != Vector2<T>()) {
+        auto [hit, idx] = detail::find_earliest_sweep_hit(rect, remaining, first, last, true);
+        if (!hit.is_hit()) {
+            rect.left += remaining.x;
+            rect.top  += remaining.y;
+            break;
+        }
+        ++rv.hit_count;
+        rv.last_normal = hit.normal;
+        rect.left += remaining.x*hit.time_of_impact;
+        rect.top  += remaining.y*hit.time_of_impact;
+        remaining  = remaining*(T(1) - hit.time_of_impact);
+        // place exactly against the side hit, and slide along it
+        const auto & obstacle = first[idx];
+        if (hit.normal.x != T(0)) {
+            rect.left = hit.normal.x < T(0) ? obstacle.left - rect.width : right_of(obstacle);
+            remaining.x = T(0);
+        } else {
+            rect.top = hit.normal.y < T(0) ? obstacle.top - rect.height : bottom_of(obstacle);
+            remaining.y = T(0);
+        }
+        if (rv.hit_count >= max_hits) break;
+    }
+    return rv;
+}
+
+} // end of cul namespace
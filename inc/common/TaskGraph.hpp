@@ -0,0 +1,157 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/ThreadPool.hpp>
+
+#include <functional>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <exception>
+
+namespace cul {
+
+/** A reusable graph of tasks, meant to be built once and run every frame.
+ *
+ *  Tasks may be ordered explicitly with "add_dependency", or implicitly by
+ *  declaring which resources they read and write. Implied ordering follows
+ *  the order tasks were added: a task that reads a resource runs after the
+ *  last task (added before it) that writes it, a task that writes a resource
+ *  runs after every earlier reader and writer of it. Tasks with no ordering
+ *  between them may run at the same time.
+ *
+ *  Tasks with "main thread" affinity are only ever run by the thread that
+ *  calls "run" (e.g. SFML draw submission), all others are run on the pool.
+ *
+ *  Once the graph is prepared (which "run" does on demand), running it again
+ *  does not allocate.
+ *
+ *  @code
+TaskGraph graph;
+auto upd = graph.add_task([&] { update(et); });
+auto geo = graph.add_task([&] { rebuild_text(); });
+auto drw = graph.add_task([&] { draw_to(window); }, TaskGraph::k_main_thread);
+graph.add_write(upd, &world);
+graph.add_read (geo, &world);
+graph.add_write(geo, &text);
+graph.add_read (drw, &text);
+while (window.isOpen()) graph.run();
+ *  @endcode
+ */
+class TaskGraph final {
+public:
+    using TaskId   = int;
+    using Resource = const void *;
+
+    enum Affinity { k_any_thread, k_main_thread };
+
+    TaskGraph() {}
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph & operator = (const TaskGraph &) = delete;
+
+    /** Adds a task to the graph.
+     *  @param f called once each time the graph is run
+     *  @returns id used to refer to this task
+     */
+    TaskId add_task(std::function<void()> && f, Affinity = k_any_thread);
+
+    /** "after" will not start until "before" has finished.
+     *  @throws if either id is not in the graph, or they are the same task
+     */
+    void add_dependency(TaskId before, TaskId after);
+
+    /** Declares that a task reads some resource. */
+    void add_read(TaskId, Resource);
+
+    /** Declares that a task writes (or reads and writes) some resource. */
+    void add_write(TaskId, Resource);
+
+    /** @returns the number of tasks in the graph */
+    int task_count() const noexcept { return int(m_nodes.size()); }
+
+    /** Works out every dependency and prepares storage needed to run the
+     *  graph. Called automatically by run if the graph has changed.
+     *  @throws if there is a dependency cycle
+     */
+    void prepare();
+
+    /** Runs every task once, returning after all are finished. The calling
+     *  thread runs main thread tasks and helps the pool otherwise.
+     *
+     *  If a task throws, tasks not yet started are skipped, and the first
+     *  exception is rethrown once the graph has settled.
+     */
+    void run(ThreadPool &);
+
+    /** Runs the graph with the default pool. */
+    void run() { run(ThreadPool::default_instance()); }
+
+private:
+    struct Node final : public Task {
+        TaskGraph * parent = nullptr;
+        TaskId id = 0;
+        std::function<void()> function;
+        Affinity affinity = k_any_thread;
+        std::vector<TaskId> explicit_successors;
+        std::vector<Resource> reads, writes;
+
+        // set by prepare
+        int successors_begin = 0, successors_end = 0;
+        int dependency_count = 0;
+        std::atomic<int> remaining_dependencies = 0;
+    };
+
+    static void execute_node(Task &);
+
+    void verify_id(const char * caller, TaskId) const;
+
+    void add_edge(TaskId before, TaskId after);
+
+    void run_node(Node &);
+
+    void schedule(Node &);
+
+    std::vector<std::unique_ptr<Node>> m_nodes;
+    bool m_is_prepared = false;
+
+    // flattened successor lists, indexed by successors_begin/end
+    std::vector<TaskId> m_successors;
+    std::vector<TaskId> m_roots;
+
+    ThreadPool * m_pool = nullptr;
+    TaskGroup m_group;
+    std::atomic<int> m_unfinished = 0;
+    std::atomic<bool> m_has_failed = false;
+    std::exception_ptr m_exception;
+    std::mutex m_exception_mutex;
+
+    std::mutex m_main_mutex;
+    std::vector<TaskId> m_main_ready;
+};
+
+} // end of cul namespace
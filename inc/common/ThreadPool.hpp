@@ -0,0 +1,404 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <memory>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include <cstdint>
+
+namespace cul {
+
+class ThreadPool;
+class TaskGroup;
+
+/** A single unit of work that may be handed to a ThreadPool.
+ *
+ *  Tasks are not owned by the pool. Whoever submits the task is responsible
+ *  for keeping it alive until it has been executed (the TaskGroup it belongs
+ *  to tells when that is).
+ */
+struct Task {
+    /** called exactly once per time the task is submitted */
+    void (*execute)(Task &) = nullptr;
+    /** group which is notified when this task finishes, may not be null */
+    TaskGroup * group = nullptr;
+};
+
+/** Counts unfinished tasks, used to "join" on some set of tasks.
+ *
+ *  If any task in the group throws, the first exception is kept and rethrown
+ *  by ThreadPool::wait.
+ */
+class TaskGroup {
+public:
+    TaskGroup() {}
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup & operator = (const TaskGroup &) = delete;
+
+    /** @returns true if every task submitted with this group has finished */
+    bool is_done() const noexcept
+        { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class ThreadPool;
+
+    void add_pending(int n) noexcept
+        { m_pending.fetch_add(n, std::memory_order_relaxed); }
+
+    void finish_one() noexcept
+        { m_pending.fetch_sub(1, std::memory_order_acq_rel); }
+
+    void keep_exception(std::exception_ptr) noexcept;
+
+    void rethrow_kept_exception();
+
+    std::atomic<int> m_pending = 0;
+    std::atomic_flag m_has_exception = ATOMIC_FLAG_INIT;
+    std::exception_ptr m_exception;
+};
+
+namespace detail {
+
+/** Chase-Lev work stealing deque of task pointers.
+ *
+ *  Only the owning thread may push and pop (at the "bottom"), any thread may
+ *  steal (from the "top"). Grows as needed, old buffers are kept until
+ *  destruction since a thief may still be reading them.
+ *
+ *  Memory orderings follow "Correct and Efficient Work-Stealing for Weak
+ *  Memory Models" (Le, Pop, Cohen, Nardelli 2013).
+ */
+class TaskDeque final {
+public:
+    TaskDeque();
+    TaskDeque(const TaskDeque &) = delete;
+    TaskDeque & operator = (const TaskDeque &) = delete;
+    ~TaskDeque();
+
+    /** owner only */
+    void push(Task *);
+
+    /** owner only, @returns nullptr if empty */
+    Task * pop() noexcept;
+
+    /** any thread, @returns nullptr if empty or if the steal was lost to
+     *  another thread
+     */
+    Task * steal() noexcept;
+
+private:
+    struct Buffer {
+        explicit Buffer(std::int64_t capacity_);
+        Task * get(std::int64_t i) const noexcept
+            { return slots[std::size_t(i & mask)].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, Task * task) noexcept
+            { slots[std::size_t(i & mask)].store(task, std::memory_order_relaxed); }
+
+        std::int64_t capacity, mask;
+        std::unique_ptr<std::atomic<Task *>[]> slots;
+    };
+
+    static constexpr const std::int64_t k_initial_capacity = 256;
+
+    Buffer * grow(Buffer *, std::int64_t top, std::int64_t bottom);
+
+    alignas(64) std::atomic<std::int64_t> m_top    = 0;
+    alignas(64) std::atomic<std::int64_t> m_bottom = 0;
+    std::atomic<Buffer *> m_buffer;
+    // owner only
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+};
+
+} // end of detail namespace -> into ::cul
+
+/** A pool of worker threads with work stealing.
+ *
+ *  Each worker owns a Chase-Lev deque, tasks submitted from a worker go onto
+ *  its own deque, tasks submitted from any other thread go onto a shared
+ *  queue. Idle workers steal from each other before going to sleep.
+ *
+ *  Waiting on a task group with "wait" does not block idly, the waiting
+ *  thread runs tasks until the group is done. This makes it safe (and
+ *  encouraged) to wait from inside a task.
+ */
+class ThreadPool final {
+public:
+    /** Creates a pool with the given number of worker threads.
+     *  @note zero workers is allowed, in which case all tasks are run by
+     *        threads that call "wait"
+     *  @throws if worker_count is negative
+     */
+    explicit ThreadPool(int worker_count);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool(ThreadPool &&) = delete;
+
+    /** Stops and joins all workers. Any outstanding tasks must be waited on
+     *  before destruction.
+     */
+    ~ThreadPool();
+
+    ThreadPool & operator = (const ThreadPool &) = delete;
+    ThreadPool & operator = (ThreadPool &&) = delete;
+
+    /** @returns process wide pool, created on first call with one less
+     *           worker than the hardware concurrency (the caller of "wait"
+     *           makes up the difference)
+     */
+    static ThreadPool & default_instance();
+
+    /** @returns number of worker threads (not including waiting threads) */
+    int worker_count() const noexcept { return int(m_workers.size()); }
+
+    /** Submits a task which must survive until it is executed.
+     *  @note the task's group must be set
+     */
+    void submit(Task &);
+
+    /** Submits the same task n times, it will be executed n times possibly
+     *  concurrently.
+     */
+    void submit(Task &, int times);
+
+    /** Submits a function object, it is moved into storage owned by the pool
+     *  until it is executed.
+     */
+    template <typename Func>
+    void submit(TaskGroup &, Func &&);
+
+    /** Runs tasks on the calling thread until the given group is done.
+     *  @throws the first exception thrown by any task in the group
+     */
+    void wait(TaskGroup &);
+
+    /** Runs at most one pending task on the calling thread.
+     *  @returns true if a task was run
+     */
+    bool run_pending_task();
+
+private:
+    template <typename Func>
+    struct FunctionTask final : public Task {
+        explicit FunctionTask(Func && f_): f(std::forward<Func>(f_)) {}
+        std::decay_t<Func> f;
+    };
+
+    struct Worker {
+        detail::TaskDeque deque;
+        std::thread thread;
+    };
+
+    void run_worker(int index);
+
+    void enqueue(Task *, int times);
+
+    bool try_run_one(int own_index);
+
+    Task * find_task(int own_index);
+
+    static void execute(Task *);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::mutex m_shared_mutex;
+    std::vector<Task *> m_shared_queue;
+    // allows idle threads to skip the lock when there's nothing shared
+    std::atomic<int> m_shared_size = 0;
+
+    std::atomic<int> m_queued   = 0;
+    std::atomic<int> m_sleepers = 0;
+    std::atomic<bool> m_stopping = false;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+};
+
+/** Calls f(i) for every i in [first last), in parallel using the given pool.
+ *
+ *  The range is handed out in chunks of "grain" indices, so per index work
+ *  that is very cheap should use a larger grain. Returns once every call has
+ *  finished.
+ *
+ *  @throws if grain is not positive, or the first exception thrown by f
+ */
+template <typename IndexType, typename Func>
+void parallel_for
+    (ThreadPool &, IndexType first, IndexType last, IndexType grain, Func && f);
+
+/** parallel_for using the default pool */
+template <typename IndexType, typename Func>
+void parallel_for(IndexType first, IndexType last, IndexType grain, Func && f)
+    { parallel_for(ThreadPool::default_instance(), first, last, grain, std::forward<Func>(f)); }
+
+/** Maps every i in [first last) with "map" and combines the results with
+ *  "reduce", in parallel.
+ *
+ *  Chunks are reduced in order of index, and the chunk results are combined
+ *  in order too, so the result is the same as a serial left fold as long as
+ *  "reduce" is associative.
+ *
+ *  @param identity starting value for each chunk
+ *  @param map must take the form: T(IndexType)
+ *  @param reduce must take the form: T(T, T)
+ */
+template <typename T, typename IndexType, typename MapFunc, typename ReduceFunc>
+T parallel_reduce
+    (ThreadPool &, IndexType first, IndexType last, IndexType grain,
+     T identity, MapFunc && map, ReduceFunc && reduce);
+
+/** parallel_reduce using the default pool */
+template <typename T, typename IndexType, typename MapFunc, typename ReduceFunc>
+T parallel_reduce
+    (IndexType first, IndexType last, IndexType grain,
+     T identity, MapFunc && map, ReduceFunc && reduce)
+{
+    return parallel_reduce(ThreadPool::default_instance(), first, last, grain,
+                           std::move(identity), std::forward<MapFunc>(map),
+                           std::forward<ReduceFunc>(reduce));
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename Func>
+void ThreadPool::submit(TaskGroup & group, Func && f) {
+    auto * task = new FunctionTask<Func>(std::forward<Func>(f));
+    task->group   = &group;
+    task->execute = [](Task & task_) {
+        std::unique_ptr<FunctionTask<Func>> owned
+            (static_cast<FunctionTask<Func> *>(&task_));
+        owned->f();
+    };
+    submit(*task);
+}
+
+namespace detail {
+
+template <typename IndexType>
+IndexType chunk_count_of(IndexType first, IndexType last, IndexType grain) {
+    if (grain <= IndexType(0)) {
+        throw std::invalid_argument("chunk_count_of: grain must be a positive "
+                                    "integer.");
+    }
+    if (last <= first) return IndexType(0);
+    return (last - first) / grain + ((last - first) % grain ? 1 : 0);
+}
+
+/** Shared by every chunk of a parallel loop, lives on the caller's stack. */
+template <typename IndexType, typename Func>
+struct ParallelChunkTask final : public Task {
+    ParallelChunkTask(IndexType chunk_count_, Func & f_):
+        chunk_count(chunk_count_), f(f_)
+    {
+        execute = [](Task & task_) {
+            auto & self = static_cast<ParallelChunkTask &>(task_);
+            IndexType chunk;
+            while ((chunk = self.next_chunk.fetch_add(1, std::memory_order_relaxed))
+                   < self.chunk_count)
+            { self.f(chunk); }
+        };
+    }
+
+    IndexType chunk_count;
+    std::atomic<IndexType> next_chunk = IndexType(0);
+    Func & f;
+};
+
+// a partial result of parallel_reduce, on its own cache line so that
+// workers finishing neighboring chunks do not share lines
+template <typename T>
+struct alignas(64) ReduceSlot {
+    // T need not be default constructible
+    std::optional<T> value;
+};
+
+template <typename IndexType, typename ChunkFunc>
+void run_chunks
+    (ThreadPool & pool, IndexType chunk_count, ChunkFunc && on_chunk)
+{
+    if (chunk_count == IndexType(0)) return;
+    TaskGroup group;
+    ParallelChunkTask<IndexType, ChunkFunc> task(chunk_count, on_chunk);
+    task.group = &group;
+    // the calling thread also takes chunks when it waits
+    auto helpers = std::min(IndexType(pool.worker_count() + 1), chunk_count);
+    pool.submit(task, int(helpers));
+    pool.wait(group);
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename IndexType, typename Func>
+void parallel_for
+    (ThreadPool & pool, IndexType first, IndexType last, IndexType grain, Func && f)
+{
+    static_assert(std::is_integral_v<IndexType>, "IndexType must be an integer.");
+    auto chunk_count = detail::chunk_count_of(first, last, grain);
+    detail::run_chunks(pool, chunk_count, [first, last, grain, &f](IndexType chunk) {
+        auto chunk_first = first + chunk*grain;
+        auto chunk_last  = std::min(last, chunk_first + grain);
+        for (auto i = chunk_first; i != chunk_last; ++i) f(i);
+    });
+}
+
+template <typename T, typename IndexType, typename MapFunc, typename ReduceFunc>
+T parallel_reduce
+    (ThreadPool & pool, IndexType first, IndexType last, IndexType grain,
+     T identity, MapFunc && map, ReduceFunc && reduce)
+{
+    static_assert(std::is_integral_v<IndexType>, "IndexType must be an integer.");
+    auto chunk_count = detail::chunk_count_of(first, last, grain);
+    // one padded slot per chunk, rather than a std::vector<T> (which would
+    // be packed bits for bool)
+    std::vector<detail::ReduceSlot<T>> partials(static_cast<std::size_t>(chunk_count));
+    detail::run_chunks(pool, chunk_count,
+        [first, last, grain, &identity, &partials, &map, &reduce](IndexType chunk)
+    {
+        auto chunk_first = first + chunk*grain;
+        auto chunk_last  = std::min(last, chunk_first + grain);
+        // accumulated locally and stored once
+        T partial = identity;
+        for (auto i = chunk_first; i != chunk_last; ++i)
+            partial = reduce(std::move(partial), map(i));
+        partials[std::size_t(chunk)].value = std::move(partial);
+    });
+    T rv = std::move(identity);
+    for (auto & partial : partials)
+        rv = reduce(std::move(rv), std::move(*partial.value));
+    return rv;
+}
+
+} // end of cul namespace
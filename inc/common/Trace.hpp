@@ -0,0 +1,132 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <iosfwd>
+#include <chrono>
+
+#include <cstddef>
+#include <cstdint>
+
+/** @file
+ *  Scoped tracing, for seeing where frame time goes.
+ *
+ *  With MACRO_CUL_ENABLE_TRACING defined, each CUL_TRACE_SCOPE records one
+ *  event into a ring buffer belonging to the calling thread, and
+ *  cul::trace::write_chrome_trace writes all of them out in Chrome's trace
+ *  event format (load it with chrome://tracing or ui.perfetto.dev).
+ *
+ *  Without the macro, CUL_TRACE_SCOPE expands to nothing at all.
+ *
+ *  @note scopes inside of the compiled library are only recorded if the
+ *        library itself was built with the macro defined
+ *
+ *  @warning since CUL_TRACE_SCOPE expands differently with and without the
+ *           macro, never place it in an inline function or template that is
+ *           shared between translation units (e.g. in a header), unless every
+ *           one of them is built with the same setting. Otherwise the
+ *           program has conflicting definitions of the same function (an ODR
+ *           violation). This library's own headers do not use it for exactly
+ *           this reason; only its sources do.
+ */
+
+#ifdef MACRO_CUL_ENABLE_TRACING
+#   define MACRO_CUL_TRACE_CONCAT_IMPL(a, b) a ## b
+#   define MACRO_CUL_TRACE_CONCAT(a, b) MACRO_CUL_TRACE_CONCAT_IMPL(a, b)
+    /** Traces the rest of the enclosing scope.
+     *  @param name must be a string with static storage (i.e. a literal)
+     */
+#   define CUL_TRACE_SCOPE(name) \
+        ::cul::trace::TraceScope MACRO_CUL_TRACE_CONCAT(cul_trace_scope_, __LINE__)(name)
+#else
+#   define CUL_TRACE_SCOPE(name)
+#endif
+
+namespace cul {
+
+namespace trace {
+
+/** One complete (begin and end) traced scope. */
+struct Event {
+    const char * name = nullptr;
+    std::int64_t begin_ns = 0;
+    std::int64_t end_ns   = 0;
+};
+
+/** Number of events each thread keeps, older events are overwritten. */
+constexpr const std::size_t k_events_per_thread = std::size_t(1) << 16;
+
+/** @returns current time in nanoseconds, as used for events */
+inline std::int64_t now_ns() noexcept {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/** Records an event into the calling thread's ring buffer.
+ *
+ *  Lock free, apart from a thread's very first event, which registers its
+ *  buffer.
+ */
+void record(const Event &) noexcept;
+
+/** Writes every recorded event, for all threads, as Chrome trace event JSON.
+ *
+ *  @warning threads being traced should be idle (e.g. between frames), events
+ *           being recorded while writing may come out garbled
+ */
+void write_chrome_trace(std::ostream &);
+
+/** Discards all recorded events.
+ *  @warning same as write_chrome_trace
+ */
+void clear();
+
+/** Records the time between its construction and destruction. */
+class TraceScope final {
+public:
+    explicit TraceScope(const char * name) noexcept:
+        m_name(name), m_begin(now_ns()) {}
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope & operator = (const TraceScope &) = delete;
+
+    ~TraceScope() {
+        Event event;
+        event.name     = m_name;
+        event.begin_ns = m_begin;
+        event.end_ns   = now_ns();
+        record(event);
+    }
+
+private:
+    const char * m_name;
+    std::int64_t m_begin;
+};
+
+} // end of trace namespace -> into ::cul
+
+} // end of cul namespace
@@ -0,0 +1,284 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Vector2Array.hpp>
+#include <common/FastMath.hpp>
+#include <common/Util.hpp>
+
+#include <tuple>
+#include <type_traits>
+
+namespace cul {
+
+/** A 2D affine transformation, the top two rows of a 3x3 matrix:
+ *  @code
+ *  [ a b tx ]
+ *  [ c d ty ]
+ *  [ 0 0 1  ]
+ *  @endcode
+ *
+ *  Building a transformation computes any sin/cos once, after which every
+ *  point costs four multiplications and four additions. Whole sequences of
+ *  points can be transformed together with transform_points.
+ *
+ *  Composition reads like function composition, (f*g)(r) is f(g(r)).
+ */
+template <typename T>
+struct Transform2 {
+    static_assert(std::is_arithmetic_v<T>, "Transform2: T must be an arithmetic type.");
+
+    /** identity transformation */
+    Transform2() {}
+
+    Transform2(T a_, T b_, T c_, T d_, T tx_, T ty_):
+        a(a_), b(b_), c(c_), d(d_), tx(tx_), ty(ty_)
+    {}
+
+    /** @returns counter clockwise rotation (as rotate_vector) about the
+     *           origin
+     *  @tparam Math math policy to use (see PreciseMath, FastMath)
+     */
+    template <typename Math = DefaultMath>
+    static Transform2 make_rotation(T radians);
+
+    static Transform2 make_scale(T scale_x, T scale_y)
+        { return Transform2(scale_x, T(0), T(0), scale_y, T(0), T(0)); }
+
+    static Transform2 make_scale(T scale)
+        { return make_scale(scale, scale); }
+
+    static Transform2 make_translation(const Vector2<T> & r)
+        { return Transform2(T(1), T(0), T(0), T(1), r.x, r.y); }
+
+    /** @returns transformation applying rhs first, then this */
+    Transform2 operator * (const Transform2 & rhs) const;
+
+    Transform2 & operator *= (const Transform2 & rhs)
+        { return (*this = *this * rhs); }
+
+    /** @returns the same transformation with t applied afterwards */
+    Transform2 then(const Transform2 & t) const { return t * (*this); }
+
+    T determinant() const noexcept { return a*d - b*c; }
+
+    /** @throws if this transformation cannot be undone (the determinant is
+     *          zero)
+     *  @returns transformation that undoes this one
+     */
+    Transform2 inverse() const;
+
+    /** @returns the transformed point */
+    Vector2<T> operator () (const Vector2<T> & r) const noexcept
+        { return Vector2<T>(a*r.x + b*r.y + tx, c*r.x + d*r.y + ty); }
+
+    /** @returns the transformed vector, ignoring translation */
+    Vector2<T> transform_direction(const Vector2<T> & r) const noexcept
+        { return Vector2<T>(a*r.x + b*r.y, c*r.x + d*r.y); }
+
+    T a  = 1, b  = 0;
+    T c  = 0, d  = 1;
+    T tx = 0, ty = 0;
+};
+
+template <typename T>
+bool operator == (const Transform2<T> & lhs, const Transform2<T> & rhs) noexcept {
+    return    lhs.a  == rhs.a  && lhs.b  == rhs.b  && lhs.c == rhs.c && lhs.d == rhs.d
+           && lhs.tx == rhs.tx && lhs.ty == rhs.ty;
+}
+
+template <typename T>
+bool operator != (const Transform2<T> & lhs, const Transform2<T> & rhs) noexcept
+    { return !(lhs == rhs); }
+
+/** Transforms a sequence of points, in place.
+ *
+ *  @tparam Vec any type usable with Vector2Util functions whose scalar type
+ *          is T, builtin Vector2s of float and double are done several at a
+ *          time where SSE2 is available
+ */
+template <typename T, typename Vec>
+void transform_points(const Transform2<T> &, Vec * first, Vec * last);
+
+/** Transforms a sequence of points, writing to out (which may be first).
+ *  @see transform_points(const Transform2<T> &, Vec *, Vec *)
+ */
+template <typename T, typename Vec>
+void transform_points(const Transform2<T> &, const Vec * first, const Vec * last, Vec * out);
+
+/** Transforms all points of an array, writing to out (which may be the same
+ *  array).
+ */
+template <typename T>
+void transform_points(const Transform2<T> &, const Vector2Array<T> &, Vector2Array<T> & out);
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+template <typename Math>
+/* static */ Transform2<T> Transform2<T>::make_rotation(T radians) {
+    auto [sin_t, cos_t] = Math::sincos(radians);
+    // same orientation as rotate_vector
+    return Transform2(cos_t, -sin_t, sin_t, cos_t, T(0), T(0));
+}
+
+template <typename T>
+Transform2<T> Transform2<T>::operator * (const Transform2 & rhs) const {
+    return Transform2(a*rhs.a + b*rhs.c, a*rhs.b + b*rhs.d,
+                      c*rhs.a + d*rhs.c, c*rhs.b + d*rhs.d,
+                      a*rhs.tx + b*rhs.ty + tx, c*rhs.tx + d*rhs.ty + ty);
+}
+
+template <typename T>
+Transform2<T> Transform2<T>::inverse() const {
+    using namespace exceptions_abbr;
+    auto det = determinant();
+    if (det == T(0) || !is_real(det)) {
+        throw InvArg("Transform2::inverse: transformation has no inverse.");
+    }
+    // for integers this is only exact for determinants of one or negative one
+    Transform2 rv(d / det, -b / det, -c / det, a / det, T(0), T(0));
+    rv.tx = -(rv.a*tx + rv.b*ty);
+    rv.ty = -(rv.c*tx + rv.d*ty);
+    return rv;
+}
+
+namespace detail {
+
+template <typename T, typename Vec>
+void transform_points_scalar
+    (const Transform2<T> & t, const Vec * first, const Vec * last, Vec * out)
+{
+    using Tr = Vector2Traits<T, Vec>;
+    typename Tr::GetX get_x;
+    typename Tr::GetY get_y;
+    for (; first != last; ++first, ++out) {
+        T x = get_x(*first), y = get_y(*first);
+        get_x(*out) = t.a*x + t.b*y + t.tx;
+        get_y(*out) = t.c*x + t.d*y + t.ty;
+    }
+}
+
+#if defined(__SSE2__)
+
+// interleaved points [x0 y0 x1 y1]: out = v*[a d a d] + swap(v)*[b c b c] + [tx ty tx ty]
+inline void transform_points_simd
+    (const Transform2<float> & t, const float * in, float * out, std::size_t point_count)
+{
+    const auto diag  = _mm_setr_ps(t.a , t.d , t.a , t.d );
+    const auto cross = _mm_setr_ps(t.b , t.c , t.b , t.c );
+    const auto trans = _mm_setr_ps(t.tx, t.ty, t.tx, t.ty);
+    for (std::size_t i = 0; i + 2 <= point_count; i += 2) {
+        auto v  = _mm_loadu_ps(in + i*2);
+        auto sw = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_ps(out + i*2,
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, diag), _mm_mul_ps(sw, cross)), trans));
+    }
+}
+
+inline void transform_points_simd
+    (const Transform2<double> & t, const double * in, double * out, std::size_t point_count)
+{
+    const auto diag  = _mm_setr_pd(t.a , t.d );
+    const auto cross = _mm_setr_pd(t.b , t.c );
+    const auto trans = _mm_setr_pd(t.tx, t.ty);
+    for (std::size_t i = 0; i != point_count; ++i) {
+        auto v  = _mm_loadu_pd(in + i*2);
+        auto sw = _mm_shuffle_pd(v, v, 1);
+        _mm_storeu_pd(out + i*2,
+            _mm_add_pd(_mm_add_pd(_mm_mul_pd(v, diag), _mm_mul_pd(sw, cross)), trans));
+    }
+}
+
+#endif
+
+template <typename T, typename Vec>
+constexpr const bool k_can_transform_interleaved =
+#   if defined(__SSE2__)
+       std::is_same_v<Vec, Vector2<T>>
+    && (std::is_same_v<T, float> || std::is_same_v<T, double>)
+    && sizeof(Vector2<T>) == 2*sizeof(T);
+#   else
+    false;
+#   endif
+
+} // end of detail namespace -> into ::cul
+
+template <typename T, typename Vec>
+void transform_points(const Transform2<T> & t, Vec * first, Vec * last)
+    { transform_points(t, static_cast<const Vec *>(first), static_cast<const Vec *>(last), first); }
+
+template <typename T, typename Vec>
+void transform_points
+    (const Transform2<T> & t, const Vec * first, const Vec * last, Vec * out)
+{
+    if constexpr (detail::k_can_transform_interleaved<T, Vec>) {
+        // builtin Vector2s are laid out as interleaved x, y pairs
+        static constexpr const std::size_t k_points_per_step
+            = std::is_same_v<T, float> ? 2 : 1;
+        if (first == last) return;
+        auto count = std::size_t(last - first);
+        detail::transform_points_simd(t, &first->x, &out->x, count);
+        // SIMD loop may leave the last point out
+        auto done = count - count % k_points_per_step;
+        detail::transform_points_scalar(t, first + done, last, out + done);
+    } else {
+        detail::transform_points_scalar(t, first, last, out);
+    }
+}
+
+template <typename T>
+void transform_points
+    (const Transform2<T> & t, const Vector2Array<T> & arr, Vector2Array<T> & out)
+{
+    using Pack = detail::SimdPack<T>;
+    out.resize(arr.size());
+    const T * xs = arr.x_data(), * ys = arr.y_data();
+    T * oxs = out.x_data(), * oys = out.y_data();
+    const std::size_t n = arr.size();
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        auto a  = Pack::set1(t.a ), b  = Pack::set1(t.b );
+        auto c  = Pack::set1(t.c ), d  = Pack::set1(t.d );
+        auto tx = Pack::set1(t.tx), ty = Pack::set1(t.ty);
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            auto x = Pack::load(xs + i);
+            auto y = Pack::load(ys + i);
+            Pack::store(oxs + i, Pack::add(Pack::add(Pack::mul(a, x), Pack::mul(b, y)), tx));
+            Pack::store(oys + i, Pack::add(Pack::add(Pack::mul(c, x), Pack::mul(d, y)), ty));
+        }
+    }
+    for (; i != n; ++i) {
+        T x = xs[i], y = ys[i];
+        oxs[i] = t.a*x + t.b*y + t.tx;
+        oys[i] = t.c*x + t.d*y + t.ty;
+    }
+}
+
+} // end of cul namespace
@@ -0,0 +1,579 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Polygon.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <cmath>
+#include <cstddef>
+
+namespace cul {
+
+/** Splits polygons (possibly with holes) into triangles by ear clipping.
+ *
+ *  Only reflex vertices can sit inside an ear, so only those are tested
+ *  against each candidate ear. They are binned into a coarse grid over the
+ *  polygon (about one per cell), so that each test only looks at reflex
+ *  vertices near the ear. For most outlines this is much closer to linear
+ *  than to the n squared of naive ear clipping.
+ *
+ *  Holes are bridged into the outline before clipping, each to a vertex
+ *  visible from its right most vertex.
+ *
+ *  Triangles are written as triples of indices into the points, which are
+ *  counted through the outline first, then each hole in order. Every
+ *  triangle is counter clockwise (for a y-up system), whichever way the
+ *  outline and holes wind. Vertices where the outline runs straight (or
+ *  doubles back) are dropped, so there may be fewer than n - 2 triangles.
+ *  Self intersecting outlines are still covered, but there triangles may
+ *  overlap or wind clockwise.
+ *
+ *  A triangulator holds onto its scratch space, so that triangulating many
+ *  polygons with the same triangulator does not need to allocate once its
+ *  buffers are large enough.
+ */
+template <typename T>
+class PolygonTriangulator final {
+public:
+    static_assert(std::is_floating_point_v<T>,
+                  "PolygonTriangulator: T must be a floating point type.");
+
+    using HoleList = std::vector<std::vector<Vector2<T>>>;
+
+    PolygonTriangulator() {}
+
+    /** Triangulates a polygon without holes.
+     *
+     *  @param out_indices triangle indices are appended here
+     *  @returns number of triangles appended
+     *  @throws if any component of any point is not real
+     */
+    std::size_t triangulate
+        (const Vector2<T> * first, const Vector2<T> * last,
+         std::vector<std::size_t> & out_indices);
+
+    std::size_t triangulate
+        (const std::vector<Vector2<T>> & outline,
+         std::vector<std::size_t> & out_indices)
+    {
+        return triangulate(outline.data(), outline.data() + outline.size(),
+                           out_indices);
+    }
+
+    /** Triangulates a polygon with holes, which should lie inside the
+     *  outline and not overlap each other. Holes with fewer than three
+     *  vertices (or found outside of the outline) are ignored, though their
+     *  points are still counted for indices.
+     *
+     *  @param out_indices triangle indices are appended here
+     *  @returns number of triangles appended
+     *  @throws if any component of any point is not real
+     */
+    std::size_t triangulate
+        (const std::vector<Vector2<T>> & outline, const HoleList & holes,
+         std::vector<std::size_t> & out_indices);
+
+private:
+    static constexpr const std::size_t k_no_node = std::size_t(-1);
+
+    struct Node {
+        // index into m_points, bridged vertices appear in two nodes
+        std::size_t index;
+        std::size_t previous, next;
+        bool is_reflex;
+    };
+
+    struct HoleStart {
+        T x;
+        std::size_t node;
+    };
+
+    void add_points(const Vector2<T> * first, const Vector2<T> * last);
+
+    // links points into a loop, wound counter clockwise if is_outline and
+    // clockwise otherwise
+    // @returns any node of the loop, k_no_node if too small
+    std::size_t link_loop(std::size_t begin, std::size_t end, bool is_outline);
+
+    std::size_t bridge_hole(std::size_t outline_node, std::size_t hole_node);
+
+    std::size_t find_hole_bridge
+        (std::size_t outline_node, std::size_t hole_node) const;
+
+    std::size_t clip_ears
+        (std::size_t start, std::vector<std::size_t> & out_indices);
+
+    std::size_t copy_node(std::size_t);
+
+    void unlink(std::size_t);
+
+    void update_reflex(std::size_t);
+
+    bool has_reflex_inside
+        (std::size_t previous, std::size_t ear, std::size_t next) const;
+
+    const Vector2<T> & point_of(std::size_t node) const
+        { return m_points[m_nodes[node].index]; }
+
+    T turn_at(std::size_t node) const;
+
+    void bin_reflex_nodes(std::size_t start);
+
+    std::size_t cell_column_of(T x) const;
+
+    std::size_t cell_row_of(T y) const;
+
+    std::vector<Vector2<T>> m_points;
+    std::vector<Node> m_nodes;
+    std::vector<HoleStart> m_holes;
+    // reflex (and straight) nodes at the start of clipping, binned by cell
+    // (starts of each cell's range, then nodes); nodes are never removed,
+    // they are skipped once no longer reflex
+    std::vector<std::size_t> m_cell_starts;
+    std::vector<std::size_t> m_cell_nodes;
+    // nodes which became reflex during clipping (only in degenerate cases)
+    std::vector<std::size_t> m_late_reflex;
+    Vector2<T> m_grid_low;
+    Vector2<T> m_cells_per_unit;
+    std::size_t m_cells_per_side = 0;
+};
+
+/** Triangulates a polygon with a triangulator made just for this call.
+ *  @see PolygonTriangulator
+ */
+template <typename T>
+std::size_t triangulate_polygon
+    (const Vector2<T> * first, const Vector2<T> * last,
+     std::vector<std::size_t> & out_indices)
+{ return PolygonTriangulator<T>{}.triangulate(first, last, out_indices); }
+
+template <typename T>
+std::size_t triangulate_polygon
+    (const std::vector<Vector2<T>> & outline,
+     std::vector<std::size_t> & out_indices)
+{ return PolygonTriangulator<T>{}.triangulate(outline, out_indices); }
+
+template <typename T>
+std::size_t triangulate_polygon
+    (const std::vector<Vector2<T>> & outline,
+     const std::vector<std::vector<Vector2<T>>> & holes,
+     std::vector<std::size_t> & out_indices)
+{ return PolygonTriangulator<T>{}.triangulate(outline, holes, out_indices); }
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+std::size_t PolygonTriangulator<T>::triangulate
+    (const Vector2<T> * first, const Vector2<T> * last,
+     std::vector<std::size_t> & out_indices)
+{
+    m_points.clear();
+    m_nodes.clear();
+    add_points(first, last);
+    auto start = link_loop(0, m_points.size(), true);
+    if (start == k_no_node) return 0;
+    return clip_ears(start, out_indices);
+}
+
+template <typename T>
+std::size_t PolygonTriangulator<T>::triangulate
+    (const std::vector<Vector2<T>> & outline, const HoleList & holes,
+     std::vector<std::size_t> & out_indices)
+{
+    m_points.clear();
+    m_nodes.clear();
+    m_holes.clear();
+    add_points(outline.data(), outline.data() + outline.size());
+    for (const auto & hole : holes)
+        { add_points(hole.data(), hole.data() + hole.size()); }
+
+    auto start = link_loop(0, outline.size(), true);
+    if (start == k_no_node) return 0;
+    std::size_t begin = outline.size();
+    for (const auto & hole : holes) {
+        std::size_t end = begin + hole.size();
+        auto hole_node = link_loop(begin, end, false);
+        begin = end;
+        if (hole_node == k_no_node) continue;
+        // start each hole from its right most vertex
+        auto right_most = hole_node;
+        for (auto itr = m_nodes[hole_node].next; itr != hole_node;
+             itr = m_nodes[itr].next)
+        {
+            if (point_of(itr).x > point_of(right_most).x) right_most = itr;
+        }
+        m_holes.push_back(HoleStart{point_of(right_most).x, right_most});
+    }
+    // right most holes first, so that each later hole may bridge to any
+    // earlier hole (now part of the outline)
+    std::sort(m_holes.begin(), m_holes.end(),
+              [](const HoleStart & lhs, const HoleStart & rhs)
+              { return lhs.x > rhs.x; });
+    for (const auto & hole : m_holes) {
+        auto outline_node = find_hole_bridge(start, hole.node);
+        if (outline_node == k_no_node) continue;
+        start = bridge_hole(outline_node, hole.node);
+    }
+    return clip_ears(start, out_indices);
+}
+
+template <typename T>
+/* private */ void PolygonTriangulator<T>::add_points
+    (const Vector2<T> * first, const Vector2<T> * last)
+{
+    using namespace exceptions_abbr;
+    for (auto itr = first; itr != last; ++itr) {
+        if (is_real(*itr)) continue;
+        throw InvArg("PolygonTriangulator::triangulate: all points must have "
+                     "real components.");
+    }
+    m_points.insert(m_points.end(), first, last);
+}
+
+template <typename T>
+/* private */ std::size_t PolygonTriangulator<T>::link_loop
+    (std::size_t begin, std::size_t end, bool is_outline)
+{
+    if (end - begin < 3) return k_no_node;
+    bool is_counter_clockwise = signed_area_of_polygon
+        (m_points.data() + begin, m_points.data() + end) > T(0);
+    bool should_reverse = is_counter_clockwise != is_outline;
+    std::size_t count = end - begin;
+    std::size_t first = m_nodes.size();
+    for (std::size_t i = 0; i != count; ++i) {
+        Node node;
+        node.index     = should_reverse ? end - 1 - i : begin + i;
+        node.previous  = first + (i + count - 1) % count;
+        node.next      = first + (i + 1) % count;
+        node.is_reflex = false;
+        m_nodes.push_back(node);
+    }
+    return first;
+}
+
+template <typename T>
+/* private */ std::size_t PolygonTriangulator<T>::find_hole_bridge
+    (std::size_t outline_node, std::size_t hole_node) const
+{
+    // cast a ray from the hole's right most vertex in +x, and find the
+    // nearest edge it hits
+    const auto & hole_point = point_of(hole_node);
+    T nearest_x = std::numeric_limits<T>::infinity();
+    std::size_t candidate = k_no_node;
+    auto itr = outline_node;
+    do {
+        const auto & a = point_of(itr);
+        const auto & b = point_of(m_nodes[itr].next);
+        bool spans = std::min(a.y, b.y) <= hole_point.y
+                  && std::max(a.y, b.y) >= hole_point.y && a.y != b.y;
+        if (spans) {
+            T x = a.x + (hole_point.y - a.y)*(b.x - a.x) / (b.y - a.y);
+            if (x >= hole_point.x && x < nearest_x) {
+                nearest_x = x;
+                if (x == hole_point.x) {
+                    // the hole touches this edge
+                    return hole_point == a ? itr
+                         : hole_point == b ? m_nodes[itr].next
+                         : (a.x > b.x ? itr : m_nodes[itr].next);
+                }
+                candidate = a.x > b.x ? itr : m_nodes[itr].next;
+            }
+        }
+        itr = m_nodes[itr].next;
+    } while (itr != outline_node);
+    if (candidate == k_no_node) return k_no_node;
+
+    // the candidate endpoint may be hidden by other outline vertices inside
+    // the triangle of the hole point, the hit and the candidate; if so take
+    // the one making the smallest angle with the ray
+    const Vector2<T> hit(nearest_x, hole_point.y);
+    const auto candidate_point = point_of(candidate);
+    // wound counter clockwise, for the inside test
+    Vector2<T> a = hole_point, b = hit, c = candidate_point;
+    if (detail::doubled_signed_area(a, b, c) < T(0)) std::swap(b, c);
+
+    auto best = candidate;
+    T best_tangent = std::numeric_limits<T>::infinity();
+    itr = candidate;
+    do {
+        const auto & p = point_of(itr);
+        bool is_inside =
+               detail::doubled_signed_area(a, b, p) >= T(0)
+            && detail::doubled_signed_area(b, c, p) >= T(0)
+            && detail::doubled_signed_area(c, a, p) >= T(0);
+        if (itr != candidate && p.x >= hole_point.x && is_inside) {
+            const auto & previous = point_of(m_nodes[itr].previous);
+            const auto & next     = point_of(m_nodes[itr].next);
+            // the bridge must leave p into the polygon's inside
+            using detail::doubled_signed_area;
+            bool left_of_previous =
+                doubled_signed_area(previous, p, hole_point) >= T(0);
+            bool left_of_next =
+                doubled_signed_area(p, next, hole_point) >= T(0);
+            bool is_convex = doubled_signed_area(previous, p, next) >= T(0);
+            bool is_locally_inside = is_convex
+                ? (left_of_previous && left_of_next)
+                : (left_of_previous || left_of_next);
+            T tangent = magnitude(hole_point.y - p.y) / (p.x - hole_point.x);
+            bool is_better = tangent < best_tangent
+                || (tangent == best_tangent && p.x > point_of(best).x);
+            if (is_locally_inside && is_better) {
+                best         = itr;
+                best_tangent = tangent;
+            }
+        }
+        itr = m_nodes[itr].next;
+    } while (itr != candidate);
+    return best;
+}
+
+template <typename T>
+/* private */ std::size_t PolygonTriangulator<T>::bridge_hole
+    (std::size_t outline_node, std::size_t hole_node)
+{
+    // outline -> hole ... around the hole ... -> hole copy -> outline copy
+    // -> rest of the outline
+    auto outline_copy = copy_node(outline_node);
+    auto hole_copy    = copy_node(hole_node);
+    auto outline_next  = m_nodes[outline_node].next;
+    auto hole_previous = m_nodes[hole_node].previous;
+
+    m_nodes[outline_node ].next     = hole_node;
+    m_nodes[hole_node    ].previous = outline_node;
+    m_nodes[outline_copy ].next     = outline_next;
+    m_nodes[outline_next ].previous = outline_copy;
+    m_nodes[hole_copy    ].next     = outline_copy;
+    m_nodes[outline_copy ].previous = hole_copy;
+    m_nodes[hole_previous].next     = hole_copy;
+    m_nodes[hole_copy    ].previous = hole_previous;
+    return outline_node;
+}
+
+template <typename T>
+/* private */ std::size_t PolygonTriangulator<T>::clip_ears
+    (std::size_t start, std::vector<std::size_t> & out_indices)
+{
+    std::size_t remaining = 1;
+    for (auto itr = m_nodes[start].next; itr != start; itr = m_nodes[itr].next)
+        { ++remaining; }
+    // straight vertices would only leave slivers, so they go before any
+    // ears do
+    auto itr = start;
+    for (std::size_t unchanged = 0; remaining > 2 && unchanged <= remaining; ) {
+        auto next = m_nodes[itr].next;
+        if (turn_at(itr) == T(0)) {
+            unlink(itr);
+            --remaining;
+            unchanged = 0;
+            start = next;
+        } else {
+            ++unchanged;
+        }
+        itr = next;
+    }
+    bin_reflex_nodes(start);
+
+    std::size_t triangle_count = 0;
+    // nodes visited since the last one removed, a full lap without finding
+    // an ear means the outline is self intersecting (or otherwise broken)
+    std::size_t misses = 0;
+    auto node = start;
+    while (remaining > 2) {
+        auto previous = m_nodes[node].previous;
+        auto next     = m_nodes[node].next;
+        T turn = turn_at(node);
+        bool is_forced = misses > remaining;
+        bool is_ear = turn > T(0) && !has_reflex_inside(previous, node, next);
+        if (turn == T(0) || is_ear || is_forced) {
+            // a straight vertex takes no area with it
+            if (turn != T(0)) {
+                out_indices.push_back(m_nodes[previous].index);
+                out_indices.push_back(m_nodes[node    ].index);
+                out_indices.push_back(m_nodes[next    ].index);
+                ++triangle_count;
+            }
+            unlink(node);
+            --remaining;
+            update_reflex(previous);
+            update_reflex(next);
+            misses = 0;
+        } else {
+            ++misses;
+        }
+        node = next;
+    }
+    return triangle_count;
+}
+
+template <typename T>
+/* private */ std::size_t PolygonTriangulator<T>::copy_node(std::size_t node) {
+    m_nodes.push_back(m_nodes[node]);
+    return m_nodes.size() - 1;
+}
+
+template <typename T>
+/* private */ void PolygonTriangulator<T>::unlink(std::size_t node) {
+    m_nodes[node].is_reflex = false;
+    auto previous = m_nodes[node].previous;
+    auto next     = m_nodes[node].next;
+    m_nodes[previous].next = next;
+    m_nodes[next].previous = previous;
+}
+
+template <typename T>
+/* private */ void PolygonTriangulator<T>::update_reflex(std::size_t node) {
+    bool is_reflex = turn_at(node) <= T(0);
+    if (is_reflex && !m_nodes[node].is_reflex)
+        { m_late_reflex.push_back(node); }
+    m_nodes[node].is_reflex = is_reflex;
+}
+
+template <typename T>
+/* private */ bool PolygonTriangulator<T>::has_reflex_inside
+    (std::size_t previous, std::size_t ear, std::size_t next) const
+{
+    const auto & a = point_of(previous);
+    const auto & b = point_of(ear);
+    const auto & c = point_of(next);
+    T low_x  = std::min(a.x, std::min(b.x, c.x));
+    T high_x = std::max(a.x, std::max(b.x, c.x));
+    T low_y  = std::min(a.y, std::min(b.y, c.y));
+    T high_y = std::max(a.y, std::max(b.y, c.y));
+    auto is_inside = [&](std::size_t node) {
+        if (!m_nodes[node].is_reflex) return false;
+        const auto & p = point_of(node);
+        if (p.x < low_x || p.x > high_x || p.y < low_y || p.y > high_y)
+            { return false; }
+        // bridged vertices share places with the ear's own corners
+        if (p == a || p == b || p == c) return false;
+        return    detail::doubled_signed_area(a, b, p) >= T(0)
+               && detail::doubled_signed_area(b, c, p) >= T(0)
+               && detail::doubled_signed_area(c, a, p) >= T(0);
+    };
+    auto last_column = cell_column_of(high_x);
+    auto last_row    = cell_row_of   (high_y);
+    for (auto row = cell_row_of(low_y); row <= last_row; ++row) {
+        auto first_cell = row*m_cells_per_side + cell_column_of(low_x);
+        auto last_cell  = row*m_cells_per_side + last_column;
+        auto end = m_cell_starts[last_cell + 1];
+        for (auto i = m_cell_starts[first_cell]; i != end; ++i) {
+            if (is_inside(m_cell_nodes[i])) return true;
+        }
+    }
+    for (auto node : m_late_reflex) {
+        if (is_inside(node)) return true;
+    }
+    return false;
+}
+
+template <typename T>
+/* private */ T PolygonTriangulator<T>::turn_at(std::size_t node) const {
+    return detail::doubled_signed_area
+        (point_of(m_nodes[node].previous), point_of(node),
+         point_of(m_nodes[node].next));
+}
+
+template <typename T>
+/* private */ void PolygonTriangulator<T>::bin_reflex_nodes(std::size_t start) {
+    // bounds of the whole loop, rather than just reflex nodes, so that
+    // queries are always at least partly inside the grid
+    std::size_t reflex_count = 0;
+    Vector2<T> low  = point_of(start);
+    Vector2<T> high = low;
+    auto itr = start;
+    do {
+        const auto & r = point_of(itr);
+        low  = Vector2<T>(std::min(low .x, r.x), std::min(low .y, r.y));
+        high = Vector2<T>(std::max(high.x, r.x), std::max(high.y, r.y));
+        m_nodes[itr].is_reflex = turn_at(itr) <= T(0);
+        if (m_nodes[itr].is_reflex) ++reflex_count;
+        itr = m_nodes[itr].next;
+    } while (itr != start);
+
+    m_cells_per_side = std::max(std::size_t(1), std::size_t(
+        std::sqrt(T(reflex_count))));
+    m_grid_low = low;
+    // zero extents (a flat loop) still give a usable grid
+    auto per_unit = [this](T extent)
+        { return extent > T(0) ? T(m_cells_per_side) / extent : T(0); };
+    m_cells_per_unit =
+        Vector2<T>(per_unit(high.x - low.x), per_unit(high.y - low.y));
+
+    // a counting sort of reflex nodes into cells
+    auto cell_count = m_cells_per_side*m_cells_per_side;
+    auto cell_of = [this](std::size_t node) {
+        const auto & r = point_of(node);
+        return cell_row_of(r.y)*m_cells_per_side + cell_column_of(r.x);
+    };
+    m_cell_starts.clear();
+    m_cell_starts.resize(cell_count + 1, 0);
+    m_cell_nodes.resize(reflex_count);
+    m_late_reflex.clear();
+    itr = start;
+    do {
+        if (m_nodes[itr].is_reflex) ++m_cell_starts[cell_of(itr) + 1];
+        itr = m_nodes[itr].next;
+    } while (itr != start);
+    for (std::size_t i = 0; i != cell_count; ++i)
+        { m_cell_starts[i + 1] += m_cell_starts[i]; }
+    // filled from each cell's end backward, so that each counter comes to
+    // rest at the start of the cell before it
+    itr = start;
+    do {
+        if (m_nodes[itr].is_reflex) {
+            auto cell = cell_of(itr);
+            auto & filled = m_cell_starts[cell + 1];
+            m_cell_nodes[--filled] = itr;
+        }
+        itr = m_nodes[itr].next;
+    } while (itr != start);
+    std::rotate(m_cell_starts.begin(), m_cell_starts.begin() + 1,
+                m_cell_starts.end());
+    m_cell_starts.back() = reflex_count;
+}
+
+template <typename T>
+/* private */ std::size_t PolygonTriangulator<T>::cell_column_of(T x) const {
+    T column = (x - m_grid_low.x)*m_cells_per_unit.x;
+    if (!(column > T(0))) return 0;
+    return std::min(std::size_t(column), m_cells_per_side - 1);
+}
+
+template <typename T>
+/* private */ std::size_t PolygonTriangulator<T>::cell_row_of(T y) const {
+    T row = (y - m_grid_low.y)*m_cells_per_unit.y;
+    if (!(row > T(0))) return 0;
+    return std::min(std::size_t(row), m_cells_per_side - 1);
+}
+
+} // end of cul namespace
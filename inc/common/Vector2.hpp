@@ -32,31 +32,38 @@ namespace cul {
 
 template <typename T>
 struct Vector2 {
-    Vector2() {}
-    Vector2(T x_, T y_): x(x_), y(y_) {}
+    constexpr Vector2() noexcept {}
+    constexpr Vector2(T x_, T y_) noexcept: x(x_), y(y_) {}
 
     template <typename U>
-    explicit Vector2(U x_, U y_): x(T(x_)), y(T(y_)) {}
+    constexpr explicit Vector2(U x_, U y_)
+        noexcept(std::is_nothrow_constructible_v<T, U>):
+        x(T(x_)), y(T(y_)) {}
 
     template <typename U>
-    explicit Vector2(const Vector2<U> & r): x(T(r.x)), y(T(r.y)) {}
+    constexpr explicit Vector2(const Vector2<U> & r)
+        noexcept(std::is_nothrow_constructible_v<T, U>):
+        x(T(r.x)), y(T(r.y)) {}
 
     T x = 0, y = 0;
 };
 
 template <typename T>
 struct Size2 {
-    Size2() {}
+    constexpr Size2() noexcept {}
 
-    Size2(T width_, T height_):
+    constexpr Size2(T width_, T height_) noexcept:
         width(width_), height(height_)
     {}
 
     template <typename U>
-    explicit Size2(U width_, U height_): width(T(width_)), height(T(height_)) {}
+    constexpr explicit Size2(U width_, U height_)
+        noexcept(std::is_nothrow_constructible_v<T, U>):
+        width(T(width_)), height(T(height_)) {}
 
     template <typename U>
-    explicit Size2(const Size2<U> & r):
+    constexpr explicit Size2(const Size2<U> & r)
+        noexcept(std::is_nothrow_constructible_v<T, U>):
         width(T(r.width)), height(T(r.height))
     {}
 
@@ -68,19 +75,20 @@ struct Size2 {
  */
 template <typename T>
 struct Rectangle {
-    Rectangle() {}
+    constexpr Rectangle() noexcept {}
 
-    Rectangle(T left_, T top_, T width_, T height_):
+    constexpr Rectangle(T left_, T top_, T width_, T height_) noexcept:
         left(left_), top(top_), width(width_), height(height_)
     {}
 
-    Rectangle(const Vector2<T> & r, const Size2<T> & sz):
+    constexpr Rectangle(const Vector2<T> & r, const Size2<T> & sz) noexcept:
         left (     r.x), top   (      r.y),
         width(sz.width), height(sz.height)
     {}
 
     template <typename U>
-    explicit Rectangle(const Rectangle<U> & rect):
+    constexpr explicit Rectangle(const Rectangle<U> & rect)
+        noexcept(std::is_nothrow_constructible_v<T, U>):
         left (T(rect.left )), top   (T(rect.top   )),
         width(T(rect.width)), height(T(rect.height))
     {}
@@ -98,7 +106,9 @@ struct Rectangle {
  *  @param rect rectangle to check if r is contained in
  */
 template <typename T>
-bool is_contained_in(const Vector2<T> & r, const Rectangle<T> & rect) noexcept {
+constexpr bool is_contained_in
+    (const Vector2<T> & r, const Rectangle<T> & rect) noexcept
+{
     return    r.x >=  rect.left               && r.y >=  rect.top
            && r.x <  (rect.left + rect.width) && r.y <  (rect.top + rect.height);
 }
@@ -116,12 +126,16 @@ struct Vector2Traits<T, Vector2<T>> {
     static constexpr const bool k_should_define_operators = true;
 
     struct GetX {
-        T   operator () (const Vector2<T> & r) const { return r.x; }
-        T & operator () (      Vector2<T> & r) const { return r.x; }
+        constexpr T   operator () (const Vector2<T> & r) const noexcept
+            { return r.x; }
+        constexpr T & operator () (      Vector2<T> & r) const noexcept
+            { return r.x; }
     };
     struct GetY {
-        T   operator () (const Vector2<T> & r) const { return r.y; }
-        T & operator () (      Vector2<T> & r) const { return r.y; }
+        constexpr T   operator () (const Vector2<T> & r) const noexcept
+            { return r.y; }
+        constexpr T & operator () (      Vector2<T> & r) const noexcept
+            { return r.y; }
     };
 };
 
@@ -136,17 +150,21 @@ struct Vector2Traits<T, Size2<T>> {
     static constexpr const bool k_should_define_operators = true;
 
     struct GetX {
-        T   operator () (const Size2<T> & r) const { return r.width; }
-        T & operator () (      Size2<T> & r) const { return r.width; }
+        constexpr T   operator () (const Size2<T> & r) const noexcept
+            { return r.width; }
+        constexpr T & operator () (      Size2<T> & r) const noexcept
+            { return r.width; }
     };
     struct GetY {
-        T   operator () (const Size2<T> & r) const { return r.height; }
-        T & operator () (      Size2<T> & r) const { return r.height; }
+        constexpr T   operator () (const Size2<T> & r) const noexcept
+            { return r.height; }
+        constexpr T & operator () (      Size2<T> & r) const noexcept
+            { return r.height; }
     };
 };
 
 template <typename T>
-bool operator ==
+constexpr bool operator ==
     (const cul::Rectangle<T> & lhs, const cul::Rectangle<T> & rhs) noexcept
 {
     return    lhs.left  == rhs.left  && rhs.top    == lhs.top
@@ -154,7 +172,7 @@ bool operator ==
 }
 
 template <typename T>
-bool operator !=
+constexpr bool operator !=
     (const cul::Rectangle<T> & lhs, const cul::Rectangle<T> & rhs) noexcept
 { return !(lhs == rhs); }
 
@@ -0,0 +1,750 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+#include <common/Vector2.hpp>
+#include <common/Vector2Util.hpp>
+#include <common/Util.hpp>
+
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <algorithm>
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(__AVX__)
+#   include <immintrin.h>
+#endif
+
+namespace cul {
+
+/** A sequence of 2D vectors stored as "structure of arrays", that is with
+ *  all x components in one array, and all y components in another.
+ *
+ *  This is the layout wanted by the batch functions below, which run several
+ *  vectors per instruction for float and double where SSE2 (4 floats) or AVX
+ *  (8 floats) is available to the compiler, and fall back on plain loops
+ *  otherwise.
+ *
+ *  For all batch functions:
+ *  - arrays given together must be the same size, or else they throw
+ *  - output arrays are resized as needed, and may be the same as an input
+ *  - no checks are made if components are real numbers
+ */
+template <typename T>
+class Vector2Array {
+public:
+    static_assert(std::is_arithmetic_v<T>, "Vector2Array: T must be an arithmetic type.");
+
+    using Vector = Vector2<T>;
+
+    Vector2Array() {}
+
+    explicit Vector2Array(std::size_t n): m_x(n), m_y(n) {}
+
+    /** Copies from a sequence of vectors ("array of structures").
+     *  @tparam Vec any type usable with Vector2Util functions
+     */
+    template <typename Vec>
+    Vector2Array(const Vec * first, const Vec * last)
+        { assign(first, last); }
+
+    /** Replaces all contents with a sequence of vectors ("array of
+     *  structures").
+     */
+    template <typename Vec>
+    void assign(const Vec * first, const Vec * last);
+
+    /** Writes all vectors out as an "array of structures", out must point to
+     *  at least size() vectors.
+     */
+    template <typename Vec>
+    void copy_to(Vec * out) const;
+
+    Vector operator [] (std::size_t i) const { return Vector(m_x[i], m_y[i]); }
+
+    void set(std::size_t i, const Vector & r) {
+        m_x[i] = r.x;
+        m_y[i] = r.y;
+    }
+
+    void push_back(const Vector & r) {
+        m_x.push_back(r.x);
+        m_y.push_back(r.y);
+    }
+
+    void resize(std::size_t n) {
+        m_x.resize(n);
+        m_y.resize(n);
+    }
+
+    void reserve(std::size_t n) {
+        m_x.reserve(n);
+        m_y.reserve(n);
+    }
+
+    void clear() {
+        m_x.clear();
+        m_y.clear();
+    }
+
+    std::size_t size() const noexcept { return m_x.size(); }
+
+    bool is_empty() const noexcept { return m_x.empty(); }
+
+    T * x_data() noexcept { return m_x.data(); }
+
+    T * y_data() noexcept { return m_y.data(); }
+
+    const T * x_data() const noexcept { return m_x.data(); }
+
+    const T * y_data() const noexcept { return m_y.data(); }
+
+private:
+    std::vector<T> m_x, m_y;
+};
+
+/** out[i] = a[i] + b[i] */
+template <typename T>
+void add(const Vector2Array<T> & a, const Vector2Array<T> & b, Vector2Array<T> & out);
+
+/** out[i] = a[i] - b[i] */
+template <typename T>
+void subtract(const Vector2Array<T> & a, const Vector2Array<T> & b, Vector2Array<T> & out);
+
+/** out[i] = a[i]*scalar */
+template <typename T>
+void scale(const Vector2Array<T> & a, T scalar, Vector2Array<T> & out);
+
+/** out[i] = dot(a[i], b[i]), out must point to at least a.size() scalars */
+template <typename T>
+void dot(const Vector2Array<T> & a, const Vector2Array<T> & b, T * out);
+
+/** out[i] = cross(a[i], b[i]), out must point to at least a.size() scalars */
+template <typename T>
+void cross(const Vector2Array<T> & a, const Vector2Array<T> & b, T * out);
+
+/** out[i] = magnitude(a[i]), out must point to at least a.size() scalars */
+template <typename T>
+void magnitude(const Vector2Array<T> & a, T * out);
+
+/** out[i] = normalize(a[i])
+ *  @note unlike the single vector version, this does not throw for zero
+ *        vectors, which are left as zero vectors
+ */
+template <typename T>
+void normalize(const Vector2Array<T> & a, Vector2Array<T> & out);
+
+/** out[i] = magnitude(a[i] - point), out must point to at least a.size()
+ *  scalars
+ */
+template <typename T>
+void distance_to(const Vector2Array<T> & a, const Vector2<T> & point, T * out);
+
+/** out[i] = are_within(a[i], b[i], error), out must point to at least
+ *  a.size() bools (all false for a negative error, like are_within)
+ */
+template <typename T>
+void are_within(const Vector2Array<T> & a, const Vector2Array<T> & b, T error, bool * out);
+
+/** Batch find_velocities_to_target, for each source and target pair with one
+ *  shared influencing acceleration and speed.
+ *
+ *  The basis from the acceleration is found once, and each velocity comes
+ *  straight from components of the launch angle's tangent (no atan, cos, or
+ *  sin), so results may differ from find_velocities_to_target by rounding.
+ *
+ *  @param first_solutions the higher of two trajectories for each target
+ *  @param second_solutions the lower of two trajectories (the same as the
+ *         higher if there is only one)
+ *  @throws if sources and targets are of different sizes, or if acceleration
+ *          or speed are not real numbers (a source or target that is not real
+ *          simply has no solution)
+ *  @returns number of targets that can be reached, the rest get the "no
+ *           solution" sentinel for both solutions
+ *  @see get_no_solution_sentinel
+ */
+template <typename T>
+std::size_t find_velocities_to_target
+    (const Vector2Array<T> & sources, const Vector2Array<T> & targets,
+     const Vector2<T> & influencing_acceleration, T speed,
+     Vector2Array<T> & first_solutions, Vector2Array<T> & second_solutions);
+
+/** Batch find_velocities_to_target, with one shared source. */
+template <typename T>
+std::size_t find_velocities_to_target
+    (const Vector2<T> & source, const Vector2Array<T> & targets,
+     const Vector2<T> & influencing_acceleration, T speed,
+     Vector2Array<T> & first_solutions, Vector2Array<T> & second_solutions);
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+/** Thin wrapper over a SIMD register type for T, k_width is zero if there is
+ *  none (and batch functions use their scalar loops only).
+ */
+template <typename T>
+struct SimdPack {
+    static constexpr const std::size_t k_width = 0;
+};
+
+#if defined(__AVX__)
+
+template <>
+struct SimdPack<float> {
+    using Type = __m256;
+    static constexpr const std::size_t k_width = 8;
+    static Type load (const float * p) { return _mm256_loadu_ps(p); }
+    static void store(float * p, Type a) { _mm256_storeu_ps(p, a); }
+    static Type set1 (float a) { return _mm256_set1_ps(a); }
+    static Type add  (Type a, Type b) { return _mm256_add_ps(a, b); }
+    static Type sub  (Type a, Type b) { return _mm256_sub_ps(a, b); }
+    static Type mul  (Type a, Type b) { return _mm256_mul_ps(a, b); }
+    static Type div  (Type a, Type b) { return _mm256_div_ps(a, b); }
+    static Type sqrt (Type a) { return _mm256_sqrt_ps(a); }
+    /** @returns a with lanes zeroed where b is zero */
+    static Type zero_where_zero(Type a, Type b)
+        { return _mm256_and_ps(a, _mm256_cmp_ps(b, _mm256_setzero_ps(), _CMP_NEQ_OQ)); }
+    /** @returns bitmask of lanes where a <= b */
+    static int le_mask(Type a, Type b)
+        { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+    static Type max  (Type a, Type b) { return _mm256_max_ps(a, b); }
+    /** @returns lanes of if_le where a <= b, and of otherwise elsewhere */
+    static Type select_le(Type a, Type b, Type if_le, Type otherwise)
+        { return _mm256_blendv_ps(otherwise, if_le, _mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+};
+
+template <>
+struct SimdPack<double> {
+    using Type = __m256d;
+    static constexpr const std::size_t k_width = 4;
+    static Type load (const double * p) { return _mm256_loadu_pd(p); }
+    static void store(double * p, Type a) { _mm256_storeu_pd(p, a); }
+    static Type set1 (double a) { return _mm256_set1_pd(a); }
+    static Type add  (Type a, Type b) { return _mm256_add_pd(a, b); }
+    static Type sub  (Type a, Type b) { return _mm256_sub_pd(a, b); }
+    static Type mul  (Type a, Type b) { return _mm256_mul_pd(a, b); }
+    static Type div  (Type a, Type b) { return _mm256_div_pd(a, b); }
+    static Type sqrt (Type a) { return _mm256_sqrt_pd(a); }
+    static Type zero_where_zero(Type a, Type b)
+        { return _mm256_and_pd(a, _mm256_cmp_pd(b, _mm256_setzero_pd(), _CMP_NEQ_OQ)); }
+    static int le_mask(Type a, Type b)
+        { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ)); }
+    static Type max  (Type a, Type b) { return _mm256_max_pd(a, b); }
+    static Type select_le(Type a, Type b, Type if_le, Type otherwise)
+        { return _mm256_blendv_pd(otherwise, if_le, _mm256_cmp_pd(a, b, _CMP_LE_OQ)); }
+};
+
+#elif defined(__SSE2__)
+
+template <>
+struct SimdPack<float> {
+    using Type = __m128;
+    static constexpr const std::size_t k_width = 4;
+    static Type load (const float * p) { return _mm_loadu_ps(p); }
+    static void store(float * p, Type a) { _mm_storeu_ps(p, a); }
+    static Type set1 (float a) { return _mm_set1_ps(a); }
+    static Type add  (Type a, Type b) { return _mm_add_ps(a, b); }
+    static Type sub  (Type a, Type b) { return _mm_sub_ps(a, b); }
+    static Type mul  (Type a, Type b) { return _mm_mul_ps(a, b); }
+    static Type div  (Type a, Type b) { return _mm_div_ps(a, b); }
+    static Type sqrt (Type a) { return _mm_sqrt_ps(a); }
+    /** @returns a with lanes zeroed where b is zero */
+    static Type zero_where_zero(Type a, Type b)
+        { return _mm_and_ps(a, _mm_cmpneq_ps(b, _mm_setzero_ps())); }
+    /** @returns bitmask of lanes where a <= b */
+    static int le_mask(Type a, Type b)
+        { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+    static Type max  (Type a, Type b) { return _mm_max_ps(a, b); }
+    /** @returns lanes of if_le where a <= b, and of otherwise elsewhere */
+    static Type select_le(Type a, Type b, Type if_le, Type otherwise) {
+        auto mask = _mm_cmple_ps(a, b);
+        return _mm_or_ps(_mm_and_ps(mask, if_le), _mm_andnot_ps(mask, otherwise));
+    }
+};
+
+template <>
+struct SimdPack<double> {
+    using Type = __m128d;
+    static constexpr const std::size_t k_width = 2;
+    static Type load (const double * p) { return _mm_loadu_pd(p); }
+    static void store(double * p, Type a) { _mm_storeu_pd(p, a); }
+    static Type set1 (double a) { return _mm_set1_pd(a); }
+    static Type add  (Type a, Type b) { return _mm_add_pd(a, b); }
+    static Type sub  (Type a, Type b) { return _mm_sub_pd(a, b); }
+    static Type mul  (Type a, Type b) { return _mm_mul_pd(a, b); }
+    static Type div  (Type a, Type b) { return _mm_div_pd(a, b); }
+    static Type sqrt (Type a) { return _mm_sqrt_pd(a); }
+    static Type zero_where_zero(Type a, Type b)
+        { return _mm_and_pd(a, _mm_cmpneq_pd(b, _mm_setzero_pd())); }
+    static int le_mask(Type a, Type b)
+        { return _mm_movemask_pd(_mm_cmple_pd(a, b)); }
+    static Type max  (Type a, Type b) { return _mm_max_pd(a, b); }
+    static Type select_le(Type a, Type b, Type if_le, Type otherwise) {
+        auto mask = _mm_cmple_pd(a, b);
+        return _mm_or_pd(_mm_and_pd(mask, if_le), _mm_andnot_pd(mask, otherwise));
+    }
+};
+
+#endif
+
+/** Same interface as SimdPack, one element wide. Lets a batch function write
+ *  its loop body once, for both its SIMD loop and the remaining elements.
+ */
+template <typename T>
+struct ScalarPack {
+    using Type = T;
+    static constexpr const std::size_t k_width = 1;
+    static Type load (const T * p) { return *p; }
+    static void store(T * p, Type a) { *p = a; }
+    static Type set1 (T a) { return a; }
+    static Type add  (Type a, Type b) { return a + b; }
+    static Type sub  (Type a, Type b) { return a - b; }
+    static Type mul  (Type a, Type b) { return a*b; }
+    static Type div  (Type a, Type b) { return a / b; }
+    static Type sqrt (Type a) { using std::sqrt; return T(sqrt(a)); }
+    static Type zero_where_zero(Type a, Type b) { return b == T(0) ? T(0) : a; }
+    static int le_mask(Type a, Type b) { return a <= b ? 1 : 0; }
+    // unlike std::max, like the SIMD instructions: b if either is NaN
+    static Type max  (Type a, Type b) { return a > b ? a : b; }
+    static Type select_le(Type a, Type b, Type if_le, Type otherwise)
+        { return a <= b ? if_le : otherwise; }
+};
+
+template <typename T>
+void verify_same_size
+    (const char * caller, const Vector2Array<T> & a, const Vector2Array<T> & b)
+{
+    using namespace exceptions_abbr;
+    if (a.size() == b.size()) return;
+    throw InvArg(std::string(caller) + ": arrays must be the same size.");
+}
+
+/** Applies an elementwise operation on x and y components separately, the
+ *  same operation for both.
+ *
+ *  @param vec_f  (const T * a, const T * b, T * out) for SimdPack<T>::k_width
+ *                many elements
+ *  @param scal_f (T a, T b) -> T for one element
+ */
+template <typename T, typename VecFunc, typename ScalarFunc>
+void for_components
+    (const Vector2Array<T> & a, const Vector2Array<T> & b, Vector2Array<T> & out,
+     VecFunc && vec_f, ScalarFunc && scal_f)
+{
+    using Pack = SimdPack<T>;
+    out.resize(a.size());
+    const std::size_t n = a.size();
+    const T * xs[] = { a.x_data(), a.y_data() };
+    const T * ys[] = { b.x_data(), b.y_data() };
+    T *     outs[] = { out.x_data(), out.y_data() };
+    for (int c = 0; c != 2; ++c) {
+        std::size_t i = 0;
+        if constexpr (Pack::k_width != 0) {
+            for (; i + Pack::k_width <= n; i += Pack::k_width)
+                { vec_f(xs[c] + i, ys[c] + i, outs[c] + i); }
+        }
+        for (; i != n; ++i) outs[c][i] = scal_f(xs[c][i], ys[c][i]);
+    }
+}
+
+template <typename T>
+struct BallisticsBasis {
+    // "up" is against the acceleration
+    T up_x, up_y;
+    // magnitude of acceleration, and speed
+    T g, speed;
+};
+
+/** One SIMD pack (or scalar) of find_velocities_to_target batch solutions.
+ *
+ *  With "up" against acceleration, and for each target its offset d split
+ *  into the "up" component y and the rest h (|h| being the horizontal
+ *  distance x), the launch angle is (for either sign):
+ *  tan(angle) = (v^2 +/- sqrt(v^4 - g(g x^2 + 2 y v^2))) / (g x) = n / (g x)
+ *
+ *  Which makes the velocity v*(g*h + n*up) / sqrt((g x)^2 + n^2) directly.
+ *
+ *  @returns number of targets that can be reached
+ */
+template <typename Pack, typename T>
+int find_velocities_to_target
+    (const BallisticsBasis<T> & basis, typename Pack::Type source_x,
+     typename Pack::Type source_y, const T * target_x, const T * target_y,
+     T * first_x, T * first_y, T * second_x, T * second_y)
+{
+    // same as find_velocities_to_target
+    static constexpr const T k_error = 0.00025;
+    const auto no_solution = Pack::set1(get_no_solution_sentinel<Vector2<T>>().x);
+    const auto zero  = Pack::set1(T(0));
+    const auto up_x  = Pack::set1(basis.up_x);
+    const auto up_y  = Pack::set1(basis.up_y);
+    const auto g     = Pack::set1(basis.g);
+    const auto speed = Pack::set1(basis.speed);
+    const auto speed_sq = Pack::mul(speed, speed);
+
+    auto dx = Pack::sub(Pack::load(target_x), source_x);
+    auto dy = Pack::sub(Pack::load(target_y), source_y);
+    // non real offsets have no solution, and x - x is zero for exactly the
+    // real ones
+    auto realness = Pack::add(Pack::sub(dx, dx), Pack::sub(dy, dy));
+    auto y  = Pack::add(Pack::mul(dx, up_x), Pack::mul(dy, up_y));
+    auto hx = Pack::sub(dx, Pack::mul(y, up_x));
+    auto hy = Pack::sub(dy, Pack::mul(y, up_y));
+    auto gx_sq = Pack::mul(Pack::mul(g, g), Pack::add(Pack::mul(hx, hx), Pack::mul(hy, hy)));
+    // v^4 - g^2 x^2 - 2 g y v^2
+    auto radicand = Pack::sub(
+        Pack::sub(Pack::mul(speed_sq, speed_sq), gx_sq),
+        Pack::mul(Pack::mul(Pack::add(g, g), y), speed_sq));
+    auto root = Pack::sqrt(Pack::max(radicand, zero));
+
+    auto ghx = Pack::mul(g, hx);
+    auto ghy = Pack::mul(g, hy);
+    // both when target is at the source: straight up
+    auto dist_sq = Pack::add(Pack::mul(dx, dx), Pack::mul(dy, dy));
+    auto error_sq = Pack::set1(k_error*k_error);
+    auto up_speed_x = Pack::mul(up_x, speed);
+    auto up_speed_y = Pack::mul(up_y, speed);
+    auto solve = [&](typename Pack::Type n, T * out_x, T * out_y) {
+        auto scale = Pack::div(speed, Pack::sqrt(Pack::add(gx_sq, Pack::mul(n, n))));
+        auto vx = Pack::mul(Pack::add(ghx, Pack::mul(n, up_x)), scale);
+        auto vy = Pack::mul(Pack::add(ghy, Pack::mul(n, up_y)), scale);
+        vx = Pack::select_le(zero, radicand, vx, no_solution);
+        vy = Pack::select_le(zero, radicand, vy, no_solution);
+        vx = Pack::select_le(dist_sq, error_sq, up_speed_x, vx);
+        vy = Pack::select_le(dist_sq, error_sq, up_speed_y, vy);
+        Pack::store(out_x, Pack::select_le(realness, zero, vx, no_solution));
+        Pack::store(out_y, Pack::select_le(realness, zero, vy, no_solution));
+    };
+    solve(Pack::add(speed_sq, root), first_x , first_y );
+    solve(Pack::sub(speed_sq, root), second_x, second_y);
+
+    int mask =   (Pack::le_mask(zero, radicand) | Pack::le_mask(dist_sq, error_sq))
+               & Pack::le_mask(realness, zero);
+    int count = 0;
+    for (; mask; mask &= mask - 1) ++count;
+    return count;
+}
+
+template <typename T>
+std::size_t find_velocities_to_target
+    (const T * source_x, const T * source_y, bool is_shared_source,
+     const Vector2Array<T> & targets, const Vector2<T> & influencing_acceleration,
+     T speed, Vector2Array<T> & first_solutions, Vector2Array<T> & second_solutions)
+{
+    using namespace exceptions_abbr;
+    using Pack = SimdPack<T>;
+    static_assert(std::is_floating_point_v<T>,
+                  "find_velocities_to_target: T must be a floating point type.");
+    // same as find_velocities_to_target
+    static constexpr const T k_error = 0.00025;
+    if (!is_real(influencing_acceleration) || !is_real(speed)) {
+        throw InvArg("find_velocities_to_target: acceleration and speed must "
+                     "be real numbers.");
+    }
+    const std::size_t n = targets.size();
+    first_solutions .resize(n);
+    second_solutions.resize(n);
+    const T * tx = targets.x_data(), * ty = targets.y_data();
+    T * fx = first_solutions .x_data(), * fy = first_solutions .y_data();
+    T * sx = second_solutions.x_data(), * sy = second_solutions.y_data();
+    auto source_offset = [is_shared_source](std::size_t i)
+        { return is_shared_source ? std::size_t(0) : i; };
+
+    if (magnitude(influencing_acceleration) < k_error) {
+        // straight to target, no need for all that
+        std::size_t count = 0;
+        for (std::size_t i = 0; i != n; ++i) {
+            auto d = Vector2<T>(tx[i], ty[i])
+                     - Vector2<T>(source_x[source_offset(i)], source_y[source_offset(i)]);
+            auto s = get_no_solution_sentinel<Vector2<T>>();
+            if (is_real(d)) {
+                auto mag = magnitude(d);
+                s = mag < k_error ? Vector2<T>() : d*(speed / mag);
+                ++count;
+            }
+            fx[i] = sx[i] = s.x;
+            fy[i] = sy[i] = s.y;
+        }
+        return count;
+    }
+
+    BallisticsBasis<T> basis;
+    basis.g     = magnitude(influencing_acceleration);
+    basis.up_x  = -influencing_acceleration.x / basis.g;
+    basis.up_y  = -influencing_acceleration.y / basis.g;
+    basis.speed = speed;
+    std::size_t count = 0;
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            auto src_x = is_shared_source ? Pack::set1(*source_x) : Pack::load(source_x + i);
+            auto src_y = is_shared_source ? Pack::set1(*source_y) : Pack::load(source_y + i);
+            count += std::size_t(find_velocities_to_target<Pack>(
+                basis, src_x, src_y, tx + i, ty + i, fx + i, fy + i, sx + i, sy + i));
+        }
+    }
+    for (; i != n; ++i) {
+        count += std::size_t(find_velocities_to_target<ScalarPack<T>>(
+            basis, source_x[source_offset(i)], source_y[source_offset(i)],
+            tx + i, ty + i, fx + i, fy + i, sx + i, sy + i));
+    }
+    return count;
+}
+
+} // end of detail namespace -> into ::cul
+
+template <typename T>
+template <typename Vec>
+void Vector2Array<T>::assign(const Vec * first, const Vec * last) {
+    using Tr = Vector2Traits<T, Vec>;
+    typename Tr::GetX get_x;
+    typename Tr::GetY get_y;
+    resize(std::size_t(last - first));
+    T * xs = m_x.data();
+    T * ys = m_y.data();
+    for (auto itr = first; itr != last; ++itr) {
+        *xs++ = get_x(*itr);
+        *ys++ = get_y(*itr);
+    }
+}
+
+template <typename T>
+template <typename Vec>
+void Vector2Array<T>::copy_to(Vec * out) const {
+    using Tr = Vector2Traits<T, Vec>;
+    typename Tr::GetX get_x;
+    typename Tr::GetY get_y;
+    for (std::size_t i = 0; i != size(); ++i, ++out) {
+        get_x(*out) = m_x[i];
+        get_y(*out) = m_y[i];
+    }
+}
+
+template <typename T>
+void add(const Vector2Array<T> & a, const Vector2Array<T> & b, Vector2Array<T> & out) {
+    using Pack = detail::SimdPack<T>;
+    detail::verify_same_size("add", a, b);
+    detail::for_components(a, b, out,
+        [](const T * x, const T * y, T * o) {
+            if constexpr (Pack::k_width != 0)
+                { Pack::store(o, Pack::add(Pack::load(x), Pack::load(y))); }
+        },
+        [](T x, T y) { return T(x + y); });
+}
+
+template <typename T>
+void subtract(const Vector2Array<T> & a, const Vector2Array<T> & b, Vector2Array<T> & out) {
+    using Pack = detail::SimdPack<T>;
+    detail::verify_same_size("subtract", a, b);
+    detail::for_components(a, b, out,
+        [](const T * x, const T * y, T * o) {
+            if constexpr (Pack::k_width != 0)
+                { Pack::store(o, Pack::sub(Pack::load(x), Pack::load(y))); }
+        },
+        [](T x, T y) { return T(x - y); });
+}
+
+template <typename T>
+void scale(const Vector2Array<T> & a, T scalar, Vector2Array<T> & out) {
+    using Pack = detail::SimdPack<T>;
+    // b is only there to satisfy for_components
+    detail::for_components(a, a, out,
+        [scalar](const T * x, const T *, T * o) {
+            if constexpr (Pack::k_width != 0)
+                { Pack::store(o, Pack::mul(Pack::load(x), Pack::set1(scalar))); }
+        },
+        [scalar](T x, T) { return T(x*scalar); });
+}
+
+template <typename T>
+void dot(const Vector2Array<T> & a, const Vector2Array<T> & b, T * out) {
+    using Pack = detail::SimdPack<T>;
+    detail::verify_same_size("dot", a, b);
+    const T * ax = a.x_data(), * ay = a.y_data();
+    const T * bx = b.x_data(), * by = b.y_data();
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            Pack::store(out + i, Pack::add(
+                Pack::mul(Pack::load(ax + i), Pack::load(bx + i)),
+                Pack::mul(Pack::load(ay + i), Pack::load(by + i))));
+        }
+    }
+    for (; i != n; ++i) out[i] = ax[i]*bx[i] + ay[i]*by[i];
+}
+
+template <typename T>
+void cross(const Vector2Array<T> & a, const Vector2Array<T> & b, T * out) {
+    using Pack = detail::SimdPack<T>;
+    detail::verify_same_size("cross", a, b);
+    const T * ax = a.x_data(), * ay = a.y_data();
+    const T * bx = b.x_data(), * by = b.y_data();
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            Pack::store(out + i, Pack::sub(
+                Pack::mul(Pack::load(ax + i), Pack::load(by + i)),
+                Pack::mul(Pack::load(bx + i), Pack::load(ay + i))));
+        }
+    }
+    for (; i != n; ++i) out[i] = ax[i]*by[i] - bx[i]*ay[i];
+}
+
+template <typename T>
+void magnitude(const Vector2Array<T> & a, T * out) {
+    using Pack = detail::SimdPack<T>;
+    using std::sqrt;
+    const T * ax = a.x_data(), * ay = a.y_data();
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            auto x = Pack::load(ax + i);
+            auto y = Pack::load(ay + i);
+            Pack::store(out + i, Pack::sqrt(Pack::add(Pack::mul(x, x), Pack::mul(y, y))));
+        }
+    }
+    for (; i != n; ++i) out[i] = T(sqrt(ax[i]*ax[i] + ay[i]*ay[i]));
+}
+
+template <typename T>
+void normalize(const Vector2Array<T> & a, Vector2Array<T> & out) {
+    using Pack = detail::SimdPack<T>;
+    using std::sqrt;
+    out.resize(a.size());
+    const T * ax = a.x_data(), * ay = a.y_data();
+    T * ox = out.x_data(), * oy = out.y_data();
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        auto one = Pack::set1(T(1));
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            auto x = Pack::load(ax + i);
+            auto y = Pack::load(ay + i);
+            auto mag = Pack::sqrt(Pack::add(Pack::mul(x, x), Pack::mul(y, y)));
+            auto inv = Pack::zero_where_zero(Pack::div(one, mag), mag);
+            Pack::store(ox + i, Pack::mul(x, inv));
+            Pack::store(oy + i, Pack::mul(y, inv));
+        }
+    }
+    for (; i != n; ++i) {
+        auto mag = T(sqrt(ax[i]*ax[i] + ay[i]*ay[i]));
+        if (mag == T(0)) {
+            ox[i] = oy[i] = T(0);
+        } else {
+            auto x = ax[i], y = ay[i];
+            ox[i] = x / mag;
+            oy[i] = y / mag;
+        }
+    }
+}
+
+template <typename T>
+void distance_to(const Vector2Array<T> & a, const Vector2<T> & point, T * out) {
+    using Pack = detail::SimdPack<T>;
+    using std::sqrt;
+    const T * ax = a.x_data(), * ay = a.y_data();
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        auto px = Pack::set1(point.x);
+        auto py = Pack::set1(point.y);
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            auto x = Pack::sub(Pack::load(ax + i), px);
+            auto y = Pack::sub(Pack::load(ay + i), py);
+            Pack::store(out + i, Pack::sqrt(Pack::add(Pack::mul(x, x), Pack::mul(y, y))));
+        }
+    }
+    for (; i != n; ++i) {
+        auto x = ax[i] - point.x;
+        auto y = ay[i] - point.y;
+        out[i] = T(sqrt(x*x + y*y));
+    }
+}
+
+template <typename T>
+void are_within(const Vector2Array<T> & a, const Vector2Array<T> & b, T error, bool * out) {
+    using Pack = detail::SimdPack<T>;
+    detail::verify_same_size("are_within", a, b);
+    // squaring would make a negative error count as positive
+    if (!(error >= T(0))) {
+        std::fill(out, out + a.size(), false);
+        return;
+    }
+    // compared squared, so there's no need for sqrt
+    const T * ax = a.x_data(), * ay = a.y_data();
+    const T * bx = b.x_data(), * by = b.y_data();
+    const std::size_t n = a.size();
+    const T error_sq = error*error;
+    std::size_t i = 0;
+    if constexpr (Pack::k_width != 0) {
+        auto error_sq_pack = Pack::set1(error_sq);
+        for (; i + Pack::k_width <= n; i += Pack::k_width) {
+            auto x = Pack::sub(Pack::load(ax + i), Pack::load(bx + i));
+            auto y = Pack::sub(Pack::load(ay + i), Pack::load(by + i));
+            int mask = Pack::le_mask(Pack::add(Pack::mul(x, x), Pack::mul(y, y)), error_sq_pack);
+            for (std::size_t j = 0; j != Pack::k_width; ++j)
+                { out[i + j] = (mask >> j) & 1; }
+        }
+    }
+    for (; i != n; ++i) {
+        auto x = ax[i] - bx[i];
+        auto y = ay[i] - by[i];
+        out[i] = x*x + y*y <= error_sq;
+    }
+}
+
+template <typename T>
+std::size_t find_velocities_to_target
+    (const Vector2Array<T> & sources, const Vector2Array<T> & targets,
+     const Vector2<T> & influencing_acceleration, T speed,
+     Vector2Array<T> & first_solutions, Vector2Array<T> & second_solutions)
+{
+    detail::verify_same_size("find_velocities_to_target", sources, targets);
+    return detail::find_velocities_to_target(
+        sources.x_data(), sources.y_data(), false, targets,
+        influencing_acceleration, speed, first_solutions, second_solutions);
+}
+
+template <typename T>
+std::size_t find_velocities_to_target
+    (const Vector2<T> & source, const Vector2Array<T> & targets,
+     const Vector2<T> & influencing_acceleration, T speed,
+     Vector2Array<T> & first_solutions, Vector2Array<T> & second_solutions)
+{
+    return detail::find_velocities_to_target(
+        &source.x, &source.y, true, targets,
+        influencing_acceleration, speed, first_solutions, second_solutions);
+}
+
+} // end of cul namespace
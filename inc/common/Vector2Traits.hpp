@@ -27,6 +27,7 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 
 namespace cul {
 
@@ -44,12 +45,16 @@ struct Vector2Scalar<MySize<T>> {
 template <typename T>
 struct Vector2Traits<T, MySize<T>> {
     struct GetX {
-        T   operator () (const MySize<T> & r) const { return r.width; }
-        T & operator () (      MySize<T> & r) const { return r.width; }
+        constexpr T   operator () (const MySize<T> & r) const noexcept
+            { return r.width; }
+        constexpr T & operator () (      MySize<T> & r) const noexcept
+            { return r.width; }
     };
     struct GetY {
-        T   operator () (const MySize<T> & r) const { return r.height; }
-        T & operator () (      MySize<T> & r) const { return r.height; }
+        constexpr T   operator () (const MySize<T> & r) const noexcept
+            { return r.height; }
+        constexpr T & operator () (      MySize<T> & r) const noexcept
+            { return r.height; }
     };
     static constexpr const bool k_is_vector_type          = true;
     static constexpr const bool k_should_define_operators = true;
@@ -57,6 +62,10 @@ struct Vector2Traits<T, MySize<T>> {
 
 } // end of cul namespace
  * @endcode
+ *
+ *  With constexpr getters (as above), the operators defined here may be used
+ *  in constant expressions, so that tables of vectors may be built at compile
+ *  time.
  */
 
 template <typename VectorType>
@@ -109,12 +118,42 @@ using EnableVector2BoolOp = std::enable_if_t<
     k_should_define_vector2_operators<ScalarType, VectorType>,
 bool>;
 
+namespace detail {
+
+// operators here throw only if the scalar's own operators do
+template <typename T>
+constexpr const bool k_is_nothrow_negatable =
+    noexcept(-std::declval<const T &>());
+
+template <typename T>
+constexpr const bool k_is_nothrow_addable =
+    noexcept(std::declval<T &>() += std::declval<const T &>());
+
+template <typename T>
+constexpr const bool k_is_nothrow_subtractable =
+    noexcept(std::declval<T &>() -= std::declval<const T &>());
+
+template <typename T>
+constexpr const bool k_is_nothrow_multipliable =
+    noexcept(std::declval<T &>() *= std::declval<const T &>());
+
+template <typename T>
+constexpr const bool k_is_nothrow_divisible =
+    noexcept(std::declval<T &>() /= std::declval<const T &>());
+
+template <typename T>
+constexpr const bool k_is_nothrow_comparable =
+    noexcept(std::declval<const T &>() == std::declval<const T &>());
+
+} // end of detail namespace -> into ::cul
+
 // ---------------------------- Unary Vector Operator --------------------------
 
 template <typename VectorType, 
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType> 
+constexpr cul::EnableVector2Op<ScalarType, VectorType> 
     operator - (const VectorType & r)
+    noexcept(detail::k_is_nothrow_negatable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -130,8 +169,9 @@ cul::EnableVector2Op<ScalarType, VectorType>
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType> & 
+constexpr cul::EnableVector2Op<ScalarType, VectorType> & 
     operator += (VectorType & r, const VectorType & v)
+    noexcept(detail::k_is_nothrow_addable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -143,8 +183,9 @@ cul::EnableVector2Op<ScalarType, VectorType> &
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType> & 
+constexpr cul::EnableVector2Op<ScalarType, VectorType> & 
     operator -= (VectorType & r, const VectorType & v)
+    noexcept(detail::k_is_nothrow_subtractable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -156,8 +197,9 @@ cul::EnableVector2Op<ScalarType, VectorType> &
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType> 
+constexpr cul::EnableVector2Op<ScalarType, VectorType> 
     operator + (const VectorType & r, const VectorType & v)
+    noexcept(detail::k_is_nothrow_addable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -170,8 +212,9 @@ cul::EnableVector2Op<ScalarType, VectorType>
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType>
+constexpr cul::EnableVector2Op<ScalarType, VectorType>
     operator - (const VectorType & r, const VectorType & v)
+    noexcept(detail::k_is_nothrow_subtractable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -186,8 +229,9 @@ cul::EnableVector2Op<ScalarType, VectorType>
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType> &
+constexpr cul::EnableVector2Op<ScalarType, VectorType> &
     operator *= (VectorType & r, const ScalarType & a)
+    noexcept(detail::k_is_nothrow_multipliable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -199,8 +243,9 @@ cul::EnableVector2Op<ScalarType, VectorType> &
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType> &
+constexpr cul::EnableVector2Op<ScalarType, VectorType> &
     operator /= (VectorType & r, const ScalarType & a)
+    noexcept(detail::k_is_nothrow_divisible<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -212,8 +257,9 @@ cul::EnableVector2Op<ScalarType, VectorType> &
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType>
+constexpr cul::EnableVector2Op<ScalarType, VectorType>
     operator * (const VectorType & r, const ScalarType & a)
+    noexcept(detail::k_is_nothrow_multipliable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -226,8 +272,9 @@ cul::EnableVector2Op<ScalarType, VectorType>
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType>
+constexpr cul::EnableVector2Op<ScalarType, VectorType>
     operator / (const VectorType & r, const ScalarType & a)
+    noexcept(detail::k_is_nothrow_divisible<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -240,8 +287,9 @@ cul::EnableVector2Op<ScalarType, VectorType>
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2Op<ScalarType, VectorType>
+constexpr cul::EnableVector2Op<ScalarType, VectorType>
     operator * (const ScalarType & a, const VectorType & r)
+    noexcept(detail::k_is_nothrow_multipliable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -256,9 +304,10 @@ cul::EnableVector2Op<ScalarType, VectorType>
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2BoolOp<ScalarType, VectorType> 
+constexpr cul::EnableVector2BoolOp<ScalarType, VectorType> 
     operator ==
     (const VectorType & r, const VectorType & u)
+    noexcept(detail::k_is_nothrow_comparable<ScalarType>)
 {
     using Tr = cul::Vector2Traits<ScalarType, VectorType>;
     typename Tr::GetX get_x;
@@ -268,9 +317,10 @@ cul::EnableVector2BoolOp<ScalarType, VectorType>
 
 template <typename VectorType,
           typename ScalarType = typename cul::Vector2Scalar<VectorType>::Type>
-cul::EnableVector2BoolOp<ScalarType, VectorType>
+constexpr cul::EnableVector2BoolOp<ScalarType, VectorType>
     operator !=
     (const VectorType & r, const VectorType & u)
+    noexcept(detail::k_is_nothrow_comparable<ScalarType>)
 { return !(r == u); }
 
 // ---------------------------------- conversion -------------------------------
@@ -281,7 +331,7 @@ constexpr const bool k_both_types_conversion_suitible =
      && k_is_vector2<typename cul::Vector2Scalar<DestType  >::Type, DestType  >;
 
 template <typename DestType, typename SourceType>
-std::enable_if_t<
+constexpr std::enable_if_t<
     k_both_types_conversion_suitible<DestType, SourceType>,
 DestType> convert_to(const SourceType & r)
 {
@@ -28,8 +28,13 @@
 
 #include <common/Util.hpp>
 #include <common/Vector2.hpp>
+#include <common/FastMath.hpp>
+#include <common/IntegerGeometry.hpp>
 
 #include <tuple>
+#include <algorithm>
+
+#include <cassert>
 
 /** @defgroup vec2utils Vector2 Utility Functions */
 
@@ -109,11 +114,12 @@ EnableVec2Util<Vec, bool> are_within
  *  @throws if rot or the components of r are not real numbers
  *  @tparam Vec must be either the builtin Vector2 type or a type convertible
  *          to and from one
+ *  @tparam Math math policy to use (see PreciseMath, FastMath)
  *  @param r must be a vector of real components
  *  @param rot must be a real number, in radians
  *  @return the rotated vector
  */
-template <typename Vec>
+template <typename Vec, typename Math = DefaultMath>
 EnableVec2Util<Vec, Vec> rotate_vector
     (const Vec & r, typename Vector2Scalar<Vec>::Type rot);
 
@@ -126,7 +132,8 @@ EnableVec2Util<Vec, Vec> rotate_vector
  *  @note no checks if components are real numbers
  */
 template <typename Vec>
-EnableVec2UtilRetScalar<Vec> dot(const Vec & v, const Vec & u) noexcept;
+constexpr EnableVec2UtilRetScalar<Vec> dot
+    (const Vec & v, const Vec & u) noexcept;
 
 /** @returns the "z" component of the cross product of two 2D vectors.
  *
@@ -137,7 +144,8 @@ EnableVec2UtilRetScalar<Vec> dot(const Vec & v, const Vec & u) noexcept;
  *  @note no checks if components are real numbers
  */
 template <typename Vec>
-EnableVec2UtilRetScalar<Vec> cross(const Vec & v, const Vec & u) noexcept;
+constexpr EnableVec2UtilRetScalar<Vec> cross
+    (const Vec & v, const Vec & u) noexcept;
 
 /** @returns the magnitude of the angle between two vectors, in radians
  *
@@ -146,10 +154,11 @@ EnableVec2UtilRetScalar<Vec> cross(const Vec & v, const Vec & u) noexcept;
  *  @see rotate_vector, directed_angle_between
  *  @tparam Vec must be either the builtin Vector2 type or a type convertible
  *          to and from one
+ *  @tparam Math math policy to use (see PreciseMath, FastMath)
  *  @param v
  *  @param u
  */
-template <typename Vec>
+template <typename Vec, typename Math = DefaultMath>
 EnableVec2UtilRetScalar<Vec> angle_between(const Vec & v, const Vec & u);
 
 /** @returns the angle between the "from" and "to" vectors such that,
@@ -160,10 +169,11 @@ EnableVec2UtilRetScalar<Vec> angle_between(const Vec & v, const Vec & u);
  *  @see rotate_vector, angle_between
  *  @tparam Vec must be either the builtin Vector2 type or a type convertible
  *          to and from one
+ *  @tparam Math math policy to use (see PreciseMath, FastMath)
  *  @param from starting vector prerotation
  *  @param to   destination vector of any magnitude
  */
-template <typename Vec>
+template <typename Vec, typename Math = DefaultMath>
 EnableVec2UtilRetScalar<Vec> directed_angle_between(const Vec & from, const Vec & to);
 
 /** @returns the projection of vector a onto vector b
@@ -183,7 +193,10 @@ EnableVec2Util<Vec, Vec> project_onto(const Vec & a, const Vec & b);
  *
  *  @note You can find the "no intersection" sentinel value by calling the
  *        "get_no_solution_sentinel"
+ *  @note for integer vectors, whether there is an intersection is exact, and
+ *        the point is rounded to the nearest integers
  *  @see get_no_solution_sentinel
+ *  @see do_segments_intersect
  *
  *  @throws if any vector as a non real component
  *  @tparam Vec must be either the builtin Vector2 type or a type convertible
@@ -279,70 +292,149 @@ EnableVec2UtilRetScalar<Vec>
  *  @param b A single end point defining the perimeter of the triangle.
  *  @param c A single end point defining the perimeter of the triangle.
  *  @param test_point a point to test whether it is inside the triangle or not.
+ *  @see PreparedTriangle for testing many points against the same triangle
  */
 template <typename Vec>
 EnableVec2Util<Vec, bool> is_inside_triangle
     (const Vec & a, const Vec & b, const Vec & c, const Vec & test_point);
+
+/** Versions of the vector utilities which do not check their arguments, and
+ *  never throw, for inner loops over data that is already known to be valid.
+ *
+ *  Each has the same preconditions which the checked version would throw on
+ *  (real components, non-zero vectors where those are required). These are
+ *  verified with assertions, and so only in debug builds; violating them
+ *  otherwise gives unspecified results (typically NaNs or infinities).
+ */
+namespace unchecked {
+
+/** @returns magnitude of r
+ *  @see cul::magnitude
+ */
+template <typename Vec>
+EnableVec2UtilRetScalar<Vec> magnitude(const Vec & r) noexcept;
+
+/** @returns normal vector of r, r must not be the zero vector
+ *  @see cul::normalize
+ */
+template <typename Vec>
+EnableVec2Util<Vec, Vec> normalize(const Vec & r) noexcept;
+
+/** @returns true if both vectors are within some distance of each other,
+ *           compared without a square root
+ *  @see cul::are_within
+ */
+template <typename Vec>
+EnableVec2Util<Vec, bool> are_within
+    (const Vec & a, const Vec & b, typename Vector2Scalar<Vec>::Type error) noexcept;
+
+/** @see cul::rotate_vector */
+template <typename Vec, typename Math = DefaultMath>
+EnableVec2Util<Vec, Vec> rotate_vector
+    (const Vec & r, typename Vector2Scalar<Vec>::Type rot) noexcept;
+
+/** Neither vector may be the zero vector.
+ *  @see cul::angle_between
+ */
+template <typename Vec, typename Math = DefaultMath>
+EnableVec2UtilRetScalar<Vec> angle_between(const Vec & v, const Vec & u) noexcept;
+
+/** @see cul::directed_angle_between */
+template <typename Vec, typename Math = DefaultMath>
+EnableVec2UtilRetScalar<Vec> directed_angle_between
+    (const Vec & from, const Vec & to) noexcept;
+
+/** Vector b must not be the zero vector.
+ *  @see cul::project_onto
+ */
+template <typename Vec>
+EnableVec2Util<Vec, Vec> project_onto(const Vec & a, const Vec & b) noexcept;
+
+/** Only for floating point vectors.
+ *  @see cul::find_intersection
+ */
+template <typename Vec>
+EnableVec2Util<Vec, Vec> find_intersection
+    (const Vec & a_first, const Vec & a_second,
+     const Vec & b_first, const Vec & b_second) noexcept;
+
+/** @see cul::find_closest_point_to_line */
+template <typename Vec>
+EnableVec2Util<Vec, Vec> find_closest_point_to_line
+    (const Vec & a, const Vec & b, const Vec & external_point) noexcept;
+
+} // end of unchecked namespace -> into ::cul
+
 /** @}*/
 
 // ------------------ everything pretaining to rectangles ---------------------
 
+// these are all constexpr, so that tables of rectangles (layouts, anchors and
+// the like) may be built at compile time
+
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
-    make_size(T width_, T height_);
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
+    make_size(T width_, T height_) noexcept;
 
 template <typename T>
-void set_top_left_of(EnableRectangle<T> & rect, T left, T top);
+constexpr void set_top_left_of
+    (EnableRectangle<T> & rect, T left, T top) noexcept;
 
 template <typename T>
-void set_size_of(EnableRectangle<T> & rect, T width, T height);
+constexpr void set_size_of
+    (EnableRectangle<T> & rect, T width, T height) noexcept;
 
 template <typename T>
-inline void set_top_left_of(EnableRectangle<T> & rect, const Vector2<T> & r)
+constexpr void set_top_left_of
+    (EnableRectangle<T> & rect, const Vector2<T> & r) noexcept
     { set_top_left_of(rect, r.x, r.y); }
 
 template <typename T>
-void set_size_of(EnableRectangle<T> & rect, const Size2<T> & r)
+constexpr void set_size_of
+    (EnableRectangle<T> & rect, const Size2<T> & r) noexcept
     { set_size_of(rect, r.width, r.height); }
 
 template <typename T>
-Vector2<T> top_left_of(const Rectangle<T> & rect)
+constexpr Vector2<T> top_left_of(const Rectangle<T> & rect) noexcept
     { return Vector2<T>(rect.left, rect.top); }
 
 template <typename T>
-EnableArithmetic<T>
-    right_of(const Rectangle<T> & rect) { return rect.left + rect.width; }
+constexpr EnableArithmetic<T>
+    right_of(const Rectangle<T> & rect) noexcept
+    { return rect.left + rect.width; }
 
 template <typename T>
-EnableArithmetic<T>
-    bottom_of(const Rectangle<T> & rect) { return rect.top + rect.height; }
+constexpr EnableArithmetic<T>
+    bottom_of(const Rectangle<T> & rect) noexcept
+    { return rect.top + rect.height; }
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
-    size_of(const Rectangle<T> &);
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
+    size_of(const Rectangle<T> &) noexcept;
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, Vector2<T>>
-    center_of(const Rectangle<T> &);
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, Vector2<T>>
+    center_of(const Rectangle<T> &) noexcept;
 
 template <typename T>
-EnableRectangle<T> find_rectangle_intersection
-    (const Rectangle<T> &, const Rectangle<T> &);
+constexpr EnableRectangle<T> find_rectangle_intersection
+    (const Rectangle<T> &, const Rectangle<T> &) noexcept;
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, bool>
-    overlaps(const Rectangle<T> &, const Rectangle<T> &);
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, bool>
+    overlaps(const Rectangle<T> &, const Rectangle<T> &) noexcept;
 
 template <typename T>
-EnableArithmetic<T> area_of(const Rectangle<T> & a)
+constexpr EnableArithmetic<T> area_of(const Rectangle<T> & a) noexcept
     { return a.width*a.height; }
 
 template <typename T>
-EnableRectangle<T> compose(const Vector2<T> & top_left, const Size2<T> &);
+constexpr EnableRectangle<T> compose
+    (const Vector2<T> & top_left, const Size2<T> &) noexcept;
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, Tuple<Vector2<T>, Size2<T>>>
-    decompose(const Rectangle<T> & rect)
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, Tuple<Vector2<T>, Size2<T>>>
+    decompose(const Rectangle<T> & rect) noexcept
 { return std::make_tuple(top_left_of(rect), size_of(rect)); }
 
 // ----------------------- Implementation Details -----------------------------
@@ -356,7 +448,7 @@ Vector2<T> find_intersection
      const Vector2<T> & b_first, const Vector2<T> & b_second);
 
 template <typename T>
-std::enable_if_t<std::is_floating_point_v<T>, std::tuple<Vector2<T>,Vector2<T>>>
+std::enable_if_t<!std::is_integral_v<T>, std::tuple<Vector2<T>,Vector2<T>>>
     find_velocities_to_target
     (const Vector2<T> & source, const Vector2<T> & target,
      const Vector2<T> & influencing_acceleration, T speed);
@@ -378,7 +470,9 @@ EnableVec2UtilRetScalar<Vec> magnitude(const Vec & r) {
     using T = typename Vector2Scalar<Vec>::Type;
     using namespace exceptions_abbr;
     if constexpr (std::is_same_v<Vec, Vector2<T>>) {
-        if (is_real(r)) return std::sqrt(r.x*r.x + r.y*r.y);
+        // unqualified, so that non-builtin scalars (like Fixed) are found
+        using std::sqrt;
+        if (is_real(r)) return sqrt(r.x*r.x + r.y*r.y);
         throw InvArg("magnitude: given vector must have real number components.");
     } else if constexpr (k_is_vector2_util_suitable<Vec>) {
         return magnitude(convert_to<Vector2<T>>(r));
@@ -417,7 +511,7 @@ EnableVec2Util<Vec, bool> are_within
     }
 }
 
-template <typename Vec>
+template <typename Vec, typename Math>
 EnableVec2Util<Vec, Vec> rotate_vector
     (const Vec & r, typename Vector2Scalar<Vec>::Type rot)
 {
@@ -429,16 +523,19 @@ EnableVec2Util<Vec, Vec> rotate_vector
     using Tr     = Vector2Traits<Scalar, Vec>;
     typename Tr::GetX get_x;
     typename Tr::GetY get_y;
+    auto [sin_rot, cos_rot] = Math::sincos(rot);
     Vec rv;
     // [r.x] * [ cos(rot) sin(rot)]
     // [r.y]   [-sin(rot) cos(rot)]
-    get_x(rv) = get_x(r)*std::cos(rot) - get_y(r)*std::sin(rot);
-    get_y(rv) = get_x(r)*std::sin(rot) + get_y(r)*std::cos(rot);
+    get_x(rv) = get_x(r)*cos_rot - get_y(r)*sin_rot;
+    get_y(rv) = get_x(r)*sin_rot + get_y(r)*cos_rot;
     return rv;
 }
 
 template <typename Vec>
-EnableVec2UtilRetScalar<Vec> dot(const Vec & v, const Vec & u) noexcept {
+constexpr EnableVec2UtilRetScalar<Vec> dot
+    (const Vec & v, const Vec & u) noexcept
+{
     using Scalar  = typename Vector2Scalar<Vec>::Type;
     using Tr      = Vector2Traits<Scalar, Vec>;
     typename Tr::GetX get_x;
@@ -447,7 +544,9 @@ EnableVec2UtilRetScalar<Vec> dot(const Vec & v, const Vec & u) noexcept {
 }
 
 template <typename Vec>
-EnableVec2UtilRetScalar<Vec> cross(const Vec & v, const Vec & u) noexcept {
+constexpr EnableVec2UtilRetScalar<Vec> cross
+    (const Vec & v, const Vec & u) noexcept
+{
     using Scalar  = typename Vector2Scalar<Vec>::Type;
     using Tr      = Vector2Traits<Scalar, Vec>;
     typename Tr::GetX get_x;
@@ -455,7 +554,7 @@ EnableVec2UtilRetScalar<Vec> cross(const Vec & v, const Vec & u) noexcept {
     return get_x(v)*get_y(u) - get_x(u)*get_y(v);
 }
 
-template <typename Vec>
+template <typename Vec, typename Math>
 EnableVec2UtilRetScalar<Vec> angle_between(const Vec & v, const Vec & u) {
     // problematic with integer vectors...
     using namespace exceptions_abbr;
@@ -475,10 +574,10 @@ EnableVec2UtilRetScalar<Vec> angle_between(const Vec & v, const Vec & u) {
     auto frac = dot(v, u) / (mag_v*mag_u);
     if      (frac > T( 1)) { frac = T( 1); }
     else if (frac < T(-1)) { frac = T(-1); }
-    return std::acos(frac);
+    return Math::acos(frac);
 }
 
-template <typename Vec>
+template <typename Vec, typename Math>
 EnableVec2UtilRetScalar<Vec> directed_angle_between(const Vec & from, const Vec & to) {
     using namespace exceptions_abbr;
     if (!is_real(from) || !is_real(to)) {
@@ -489,7 +588,8 @@ EnableVec2UtilRetScalar<Vec> directed_angle_between(const Vec & from, const Vec
     using Tr     = Vector2Traits<Scalar, Vec>;
     typename Tr::GetX get_x;
     typename Tr::GetY get_y;
-    return std::atan2(get_y(from), get_x(from)) - std::atan2(get_y(to), get_x(to));
+    return   Math::atan2(get_y(from), get_x(from))
+           - Math::atan2(get_y(to  ), get_x(to  ));
 }
 
 template <typename Vec>
@@ -622,12 +722,174 @@ EnableVec2Util<Vec, bool> is_inside_triangle
     }
 }
 
+// ---------------------- Unchecked Vector Utilities --------------------------
+
+namespace unchecked {
+
+template <typename Vec>
+EnableVec2UtilRetScalar<Vec> magnitude(const Vec & r) noexcept {
+    using T = typename Vector2Scalar<Vec>::Type;
+    if constexpr (std::is_same_v<Vec, Vector2<T>>) {
+        assert(is_real(r));
+        using std::sqrt;
+        return sqrt(r.x*r.x + r.y*r.y);
+    } else {
+        static_assert(k_is_vector2_util_suitable<Vec>, "Type Vec not suitible for conversion.");
+        return unchecked::magnitude(convert_to<Vector2<T>>(r));
+    }
+}
+
+template <typename Vec>
+EnableVec2Util<Vec, Vec> normalize(const Vec & r) noexcept {
+    using T = typename Vector2Scalar<Vec>::Type;
+    if constexpr (std::is_same_v<Vec, Vector2<T>>) {
+        assert(is_real(r) && r != Vector2<T>());
+        return r*(T(1) / unchecked::magnitude(r));
+    } else {
+        static_assert(k_is_vector2_util_suitable<Vec>, "Type Vec not suitible for conversion.");
+        return convert_to<Vec>(unchecked::normalize(convert_to<Vector2<T>>(r)));
+    }
+}
+
+template <typename Vec>
+EnableVec2Util<Vec, bool> are_within
+    (const Vec & a, const Vec & b, typename Vector2Scalar<Vec>::Type error) noexcept
+{
+    using T = typename Vector2Scalar<Vec>::Type;
+    if constexpr (std::is_same_v<Vec, Vector2<T>>) {
+        assert(is_real(a) && is_real(b) && is_real(error));
+        auto diff = a - b;
+        return error >= T(0) && dot(diff, diff) <= error*error;
+    } else {
+        static_assert(k_is_vector2_util_suitable<Vec>, "Type Vec not suitible for conversion.");
+        using VecImp = Vector2<T>;
+        return unchecked::are_within(convert_to<VecImp>(a), convert_to<VecImp>(b), error);
+    }
+}
+
+template <typename Vec, typename Math>
+EnableVec2Util<Vec, Vec> rotate_vector
+    (const Vec & r, typename Vector2Scalar<Vec>::Type rot) noexcept
+{
+    assert(is_real(r) && is_real(rot));
+    using Scalar = typename Vector2Scalar<Vec>::Type;
+    using Tr     = Vector2Traits<Scalar, Vec>;
+    typename Tr::GetX get_x;
+    typename Tr::GetY get_y;
+    auto [sin_rot, cos_rot] = Math::sincos(rot);
+    Vec rv;
+    get_x(rv) = get_x(r)*cos_rot - get_y(r)*sin_rot;
+    get_y(rv) = get_x(r)*sin_rot + get_y(r)*cos_rot;
+    return rv;
+}
+
+template <typename Vec, typename Math>
+EnableVec2UtilRetScalar<Vec> angle_between(const Vec & v, const Vec & u) noexcept {
+    using T = typename Vector2Scalar<Vec>::Type;
+    assert(is_real(v) && is_real(u));
+    // magnitudes are taken apart, the product of squares would underflow
+    // (or overflow) far sooner than either vector
+    auto mag_v = Math::sqrt(dot(v, v));
+    auto mag_u = Math::sqrt(dot(u, u));
+    assert(mag_v > T(0) && mag_u > T(0));
+    auto frac = dot(v, u) / (mag_v*mag_u);
+    // the square root may be wider than T (double for integers)
+    using Frac = decltype(frac);
+    return Math::acos(std::min(std::max(frac, Frac(-1)), Frac(1)));
+}
+
+template <typename Vec, typename Math>
+EnableVec2UtilRetScalar<Vec> directed_angle_between
+    (const Vec & from, const Vec & to) noexcept
+{
+    assert(is_real(from) && is_real(to));
+    using Scalar = typename Vector2Scalar<Vec>::Type;
+    using Tr     = Vector2Traits<Scalar, Vec>;
+    typename Tr::GetX get_x;
+    typename Tr::GetY get_y;
+    return   Math::atan2(get_y(from), get_x(from))
+           - Math::atan2(get_y(to  ), get_x(to  ));
+}
+
+template <typename Vec>
+EnableVec2Util<Vec, Vec> project_onto(const Vec & a, const Vec & b) noexcept {
+    using T = typename Vector2Scalar<Vec>::Type;
+    if constexpr (std::is_same_v<Vec, Vector2<T>>) {
+        assert(is_real(a) && is_real(b) && b != Vector2<T>());
+        return (dot(b, a) / dot(b, b))*b;
+    } else {
+        static_assert(k_is_vector2_util_suitable<Vec>, "Type Vec not suitible for conversion.");
+        using VecImp = Vector2<T>;
+        return convert_to<Vec>(unchecked::project_onto(convert_to<VecImp>(a),
+                                            convert_to<VecImp>(b)));
+    }
+}
+
+template <typename Vec>
+EnableVec2Util<Vec, Vec> find_intersection
+    (const Vec & a_first, const Vec & a_second,
+     const Vec & b_first, const Vec & b_second) noexcept
+{
+    using T = typename Vector2Scalar<Vec>::Type;
+    using VecImp = Vector2<T>;
+    static_assert(std::is_floating_point_v<T>,
+                  "find_intersection: T must be a floating point type.");
+    if constexpr (std::is_same_v<Vec, VecImp>) {
+        assert(   is_real(a_first) && is_real(a_second)
+               && is_real(b_first) && is_real(b_second));
+        auto r = a_second - a_first;
+        auto s = b_second - b_first;
+        auto r_cross_s = cross(r, s);
+        auto q_sub_p = b_first - a_first;
+        auto t = cross(q_sub_p, s) / r_cross_s;
+        auto u = cross(q_sub_p, r) / r_cross_s;
+        // parallel lines give a non-finite (or NaN) t and u, which fail here
+        if (t >= T(0) && t <= T(1) && u >= T(0) && u <= T(1))
+            return a_first + t*r;
+        return get_no_solution_sentinel<VecImp>();
+    } else {
+        static_assert(k_is_vector2_util_suitable<Vec>,
+                      "Type Vec not suitible for conversion.");
+        return convert_to<Vec>(unchecked::find_intersection(
+            convert_to<VecImp>(a_first), convert_to<VecImp>(a_second),
+            convert_to<VecImp>(b_first), convert_to<VecImp>(b_second)));
+    }
+}
+
+template <typename Vec>
+EnableVec2Util<Vec, Vec> find_closest_point_to_line
+    (const Vec & a, const Vec & b, const Vec & external_point) noexcept
+{
+    using T = typename Vector2Scalar<Vec>::Type;
+    using VecImp = Vector2<T>;
+    if constexpr (std::is_same_v<Vec, VecImp>) {
+        assert(is_real(a) && is_real(b) && is_real(external_point));
+        // project onto the line, and clamp to the extreme points, the clamp
+        // is decided on the numerator and denominator alone (no division,
+        // trig, or square roots needed)
+        auto ab = b - a;
+        auto num = dot(external_point - a, ab);
+        if (!(num > T(0))) return a;
+        auto denom = dot(ab, ab);
+        if (!(num < denom)) return b;
+        return a + ab*(num / denom);
+    } else {
+        static_assert(k_is_vector2_util_suitable<Vec>,
+                      "Type Vec not suitible for conversion.");
+        return convert_to<Vec>(unchecked::find_closest_point_to_line(
+            convert_to<VecImp>(a), convert_to<VecImp>(b),
+            convert_to<VecImp>(external_point)));
+    }
+}
+
+} // end of unchecked namespace -> into ::cul
+
 // ----------------------- Implementation Details -----------------------------
 // ------------------ everything pretaining to rectangles ---------------------
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
-    make_size(T width_, T height_)
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
+    make_size(T width_, T height_) noexcept
 {
     Size2<T> rv;
     rv.width  = width_ ;
@@ -636,20 +898,24 @@ std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
 }
 
 template <typename T>
-void set_top_left_of(EnableRectangle<T> & rect, T left, T top) {
+constexpr void set_top_left_of
+    (EnableRectangle<T> & rect, T left, T top) noexcept
+{
     rect.left = left;
     rect.top  = top ;
 }
 
 template <typename T>
-void set_size_of(EnableRectangle<T> & rect, T width, T height) {
+constexpr void set_size_of
+    (EnableRectangle<T> & rect, T width, T height) noexcept
+{
     rect.width  = width ;
     rect.height = height;
 }
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
-    size_of(const Rectangle<T> & rect)
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
+    size_of(const Rectangle<T> & rect) noexcept
 {
     Size2<T> size;
     size.width  = rect.width ;
@@ -658,16 +924,16 @@ std::enable_if_t<std::is_arithmetic_v<T>, Size2<T>>
 }
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, Vector2<T>>
-    center_of(const Rectangle<T> & rect)
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, Vector2<T>>
+    center_of(const Rectangle<T> & rect) noexcept
 {
     return Vector2<T>(rect.left + rect.width  / T(2),
                       rect.top  + rect.height / T(2));
 }
 
 template <typename T>
-EnableRectangle<T> find_rectangle_intersection
-    (const Rectangle<T> & a, const Rectangle<T> & b)
+constexpr EnableRectangle<T> find_rectangle_intersection
+    (const Rectangle<T> & a, const Rectangle<T> & b) noexcept
 {
     using TVec = Vector2<T>;
     auto high_a = TVec(right_of(a), bottom_of(a));
@@ -684,15 +950,17 @@ EnableRectangle<T> find_rectangle_intersection
 }
 
 template <typename T>
-std::enable_if_t<std::is_arithmetic_v<T>, bool>
-    overlaps(const Rectangle<T> & a, const Rectangle<T> & b)
+constexpr std::enable_if_t<std::is_arithmetic_v<T>, bool>
+    overlaps(const Rectangle<T> & a, const Rectangle<T> & b) noexcept
 {
     return    right_of (a) > b.left && right_of (b) > a.left
            && bottom_of(a) > b.top  && bottom_of(b) > a.top ;
 }
 
 template <typename T>
-EnableRectangle<T> compose(const Vector2<T> & top_left, const Size2<T> & size) {
+constexpr EnableRectangle<T> compose
+    (const Vector2<T> & top_left, const Size2<T> & size) noexcept
+{
     return Rectangle<T>(top_left.x, top_left.y, size.width, size.height);
 }
 
@@ -705,12 +973,14 @@ Vector2<T> find_intersection
     (const Vector2<T> & a_first, const Vector2<T> & a_second,
      const Vector2<T> & b_first, const Vector2<T> & b_second)
 {
-    using namespace exceptions_abbr;
-    if constexpr (!std::is_floating_point_v<T>) {
-        throw RtError("find_intersection: finding intersections on integer "
-                      "vectors is not defined (perhaps a future feature?).");
-    }
     static const Vector2<T> k_no_intersection = get_no_solution_sentinel<Vector2<T>>();
+    if constexpr (std::is_integral_v<T>) {
+        // exact, with wide integers
+        Vector2<T> rv;
+        if (find_integer_intersection(a_first, a_second, b_first, b_second, rv))
+            return rv;
+        return k_no_intersection;
+    }
 
     auto p = a_first;
     auto r = a_second - p;
@@ -737,7 +1007,7 @@ Vector2<T> find_intersection
 // still in cul::detail namespace
 
 template <typename T>
-std::enable_if_t<std::is_floating_point_v<T>, std::tuple<Vector2<T>,Vector2<T>>>
+std::enable_if_t<!std::is_integral_v<T>, std::tuple<Vector2<T>,Vector2<T>>>
     find_velocities_to_target
     (const Vector2<T> & source, const Vector2<T> & target,
      const Vector2<T> & influencing_acceleration, T speed)
@@ -797,11 +1067,12 @@ std::enable_if_t<std::is_floating_point_v<T>, std::tuple<Vector2<T>,Vector2<T>>>
         auto spd_sq = speed*speed;
         auto g = magnitude(influencing_acceleration);
         auto do_atan_with_sqpart = [spd_sq, g, diff_i] (T sqpart)
-            { return std::atan( (spd_sq + sqpart) / (g*diff_i) ); };
+            { using std::atan; return atan( (spd_sq + sqpart) / (g*diff_i) ); };
 
         auto randicand = spd_sq*spd_sq - g*(g*diff_i*diff_i + T(2)*spd_sq*diff_j);
         if (randicand < T(0)) return k_no_solution;
-        auto sqpart = std::sqrt(randicand);
+        using std::sqrt;
+        auto sqpart = sqrt(randicand);
         t0 = do_atan_with_sqpart( sqpart);
         t1 = do_atan_with_sqpart(-sqpart);
 
@@ -809,9 +1080,10 @@ std::enable_if_t<std::is_floating_point_v<T>, std::tuple<Vector2<T>,Vector2<T>>>
     auto ground_dir = normalize(project_onto(target - source, i));
     auto up         = -normalize(influencing_acceleration);
 
-    auto s0 = ground_dir*std::cos(t0)*speed + up*std::sin(t0)*speed;
+    using std::cos, std::sin;
+    auto s0 = ground_dir*cos(t0)*speed + up*sin(t0)*speed;
     if (are_very_close_s(t0, t1)) { return make_tuple(s0, s0); }
-    return make_tuple(s0, ground_dir*std::cos(t1)*speed + up*std::sin(t1)*speed);
+    return make_tuple(s0, ground_dir*cos(t1)*speed + up*sin(t1)*speed);
 }
 
 template <typename T>
@@ -819,25 +1091,12 @@ Vector2<T> find_closest_point_to_line
     (const Vector2<T> & a, const Vector2<T> & b,
      const Vector2<T> & external_point)
 {
-    using Vec = Vector2<T>;
-    const auto & c = external_point;
-    if (a == b) return a;
-    if (a - c == Vec()) return a;
-    if (b - c == Vec()) return b;
-    // obtuse angles -> snap to extreme points
-    auto angle_at_a = angle_between(a - b, a - c);
-    if (angle_at_a > k_pi_for_type<T>*0.5) return a;
-
-    auto angle_at_b = angle_between(b - a, b - c);
-    if (angle_at_b > k_pi_for_type<T>*0.5) return b;
-
-    // https://www.eecs.umich.edu/courses/eecs380/HANDOUTS/PROJ2/LinePoint.html
-    T mag = [&a, &b, &c]() {
-        auto num = (c.x - a.x)*(b.x - a.x) + (c.y - a.y)*(b.y - a.y);
-        auto denom = magnitude(b - a);
-        return num / (denom*denom);
-    } ();
-    return Vec(a.x, a.y) + mag*Vec(b.x - a.x, b.y - a.y);
+    using namespace exceptions_abbr;
+    if (!is_real(a) || !is_real(b) || !is_real(external_point)) {
+        throw InvArg("find_closest_point_to_line: all components must be "
+                     "real numbers.");
+    }
+    return unchecked::find_closest_point_to_line(a, b, external_point);
 }
 
 template <typename T>
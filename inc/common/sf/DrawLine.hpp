@@ -34,6 +34,9 @@
 
 namespace cul {
 
+template <typename T>
+struct Transform2;
+
 /** Simple drawable line.
  *
  *  It has four write-only attributes. As it's only meant to represent a line
@@ -75,6 +78,11 @@ public:
     /** Moves the line by some given displacement. */
     void move(sf::Vector2f);
 
+    /** Applies the transformation to the line's verticies.
+     *  @note scaling will change the line's thickness too
+     */
+    void transform(const Transform2<float> &);
+
     /** @returns begin iterator to the verticies
      *  @note it maybe desirable to grab the verticies and push them somewhere
      *        else (for future rendering perhaps?)
@@ -27,6 +27,7 @@
 #include <common/Vector2.hpp>
 #include <common/BitmapFont.hpp>
 #include <common/SfmlVectorTraits.hpp>
+#include <common/Metrics.hpp>
 
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Sprite.hpp>
@@ -34,9 +35,13 @@
 
 #include <vector>
 #include <string>
+#include <memory_resource>
 
 namespace cul {
 
+template <typename T>
+struct Transform2;
+
 /** A bitmap font which works with SFML. To render to a SFML render target,
  *  fonts need to specify a texture.
  */
@@ -154,6 +159,11 @@ public:
     /** Moves the text's position by the given displacement vector. */
     void move(sf::Vector2f);
 
+    /** Applies the transformation to all produced verticies (e.g. to rotate
+     *  or scale text about some point).
+     */
+    void transform(const Transform2<float> &);
+
     /** @returns the size needed to render some given number of characters
      *  @note this text renderer, renders all text on a single line
      */
@@ -170,6 +180,16 @@ public:
      */
     std::vector<sf::Vertex> give_verticies();
 
+    /** @returns a copy of all verticies produced by the set_text function
+     *           family, allocated from the given memory resource (e.g. a
+     *           FrameArena)
+     *  @note This function also clears all verticies contained in this
+     *        object, but unlike give_verticies() this object keeps its
+     *        capacity, so that rebuilding text every frame need not touch the
+     *        global heap.
+     */
+    std::pmr::vector<sf::Vertex> give_verticies(std::pmr::memory_resource *);
+
     /** @returns a read only reference to the produced verticies */
     const std::vector<sf::Vertex> & verticies() const;
 
@@ -242,6 +262,7 @@ void DrawText::set_text_top_left(sf::Vector2f r, const T * beg, const T * end) {
         }
         r = push_character(r, char(c));
     }
+    builtin_metrics().text_verticies.add(m_verticies.size());
 }
 
 template <typename T>
@@ -33,6 +33,9 @@
 
 namespace cul {
 
+template <typename T>
+struct Transform2;
+
 class DrawTriangle final : public sf::Drawable {
 public:
     static constexpr const auto k_vertex_count = 3u;
@@ -56,6 +59,9 @@ public:
 
     void move(VectorF);
 
+    /** Applies the transformation to all three points. */
+    void transform(const Transform2<float> &);
+
     void set_center(VectorF);
 
     void set_center(float, float);
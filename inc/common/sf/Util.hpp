@@ -28,8 +28,13 @@
 
 #include <common/Grid.hpp>
 #include <common/SfmlVectorTraits.hpp>
+#include <common/Transform2.hpp>
 
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <vector>
 
 namespace cul {
 
@@ -37,6 +42,23 @@ sf::Image to_image(const Grid<sf::Color> &);
 
 Grid<sf::Color> to_color_grid(const sf::Image &);
 
+/** Transforms the positions of a sequence of verticies, in place. */
+void transform_verticies(const Transform2<float> &, sf::Vertex * first, sf::Vertex * last);
+
+/** Triangulates a polygon, replacing the contents of a vertex array with its
+ *  triangles (as sf::Triangles, all in one color), so that a filled polygon
+ *  takes only one draw call.
+ *  @see PolygonTriangulator
+ *  @throws if any component of any point is not real
+ */
+void fill_polygon_vertices
+    (const std::vector<Vector2<float>> & outline, sf::Color, sf::VertexArray &);
+
+void fill_polygon_vertices
+    (const std::vector<Vector2<float>> & outline,
+     const std::vector<std::vector<Vector2<float>>> & holes, sf::Color,
+     sf::VertexArray &);
+
 template <typename T>
 sf::Vector2f to_sf_vec2f(const cul::Vector2<T> & r)
     { return cul::convert_to<sf::Vector2<T>>(r); }
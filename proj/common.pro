@@ -48,6 +48,11 @@ SOURCES += \
     ../src/ConstString.cpp             \
     ../src/CurrentWorkingDirectory.cpp \
     ../src/TestSuite.cpp               \
+    ../src/ThreadPool.cpp              \
+    ../src/TaskGraph.cpp               \
+    ../src/FrameArena.cpp              \
+    ../src/Trace.cpp                   \
+    ../src/Metrics.cpp                 \
     \ # SFML Utilities
     ../src/sf-DrawText.cpp             \
     ../src/sf-DrawRectangle.cpp        \
@@ -76,6 +81,28 @@ HEADERS += \
     ../inc/common/Vector2.hpp                 \
     ../inc/common/SfmlVectorTraits.hpp        \
     ../inc/common/BezierCurves.hpp            \
+    ../inc/common/ThreadPool.hpp              \
+    ../inc/common/TaskGraph.hpp               \
+    ../inc/common/Fixed.hpp                   \
+    ../inc/common/FastMath.hpp                \
+    ../inc/common/FrameArena.hpp              \
+    ../inc/common/SlotMap.hpp                 \
+    ../inc/common/Trace.hpp                   \
+    ../inc/common/Metrics.hpp                 \
+    ../inc/common/Vector2Array.hpp            \
+    ../inc/common/Transform2.hpp              \
+    ../inc/common/SegmentIntersection.hpp     \
+    ../inc/common/Polygon.hpp                 \
+    ../inc/common/PreparedTriangle.hpp        \
+    ../inc/common/DynamicAabbTree.hpp         \
+    ../inc/common/SpatialHashGrid.hpp         \
+    ../inc/common/NearestSegment.hpp          \
+    ../inc/common/SweptRectangle.hpp          \
+    ../inc/common/SeparatingAxis.hpp          \
+    ../inc/common/Region.hpp                  \
+    ../inc/common/IntegerGeometry.hpp         \
+    ../inc/common/PolylineSimplifier.hpp      \
+    ../inc/common/Triangulation.hpp           \
     \ # SFML Utilities
     ../inc/common/sf/DrawText.hpp             \
     ../inc/common/sf/DrawRectangle.hpp        \
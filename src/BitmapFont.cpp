@@ -27,6 +27,7 @@
 #include <common/BitmapFont.hpp>
 #include <common/Util.hpp>
 #include <common/StringUtil.hpp>
+#include <common/Trace.hpp>
 
 #include "sf-8x8Font.hpp"
 #include "sf-8x16Font.hpp"
@@ -149,6 +150,7 @@ cul::Vector2<int> GridBitmapFontComplete::operator () (char code) const {
 void GridBitmapFontComplete::setup
     (GetCharFunc get_char, Size char_size, bool has_highlight)
 {
+    CUL_TRACE_SCOPE("GridBitmapFontComplete::setup");
     using namespace cul;
     assert(get_char);
     assert(char_size.width != 0 && char_size.height != 0);
@@ -197,7 +199,7 @@ void GridBitmapFontComplete::setup
 }
 
 /* private */ void GridBitmapFontComplete::add_highlights() {
-    static auto k_neighbors = {
+    static constexpr const Vector k_neighbors[] = {
         Vector(1, 0), Vector(-1, 0), Vector(0,  1), Vector( 0, -1),
         Vector(1, 1), Vector(-1, 1), Vector(1, -1), Vector(-1, -1),
     };
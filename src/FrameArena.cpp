@@ -0,0 +1,170 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/FrameArena.hpp>
+
+#include <new>
+#include <limits>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+
+#include <cstring>
+#include <cassert>
+
+namespace {
+
+using LocalArenaEntry = std::pair<std::uint64_t, cul::FrameArena *>;
+
+// ids are never reused, so stale entries left by destroyed arenas can never
+// be matched
+std::atomic<std::uint64_t> s_next_arena_id = 0;
+thread_local std::vector<LocalArenaEntry> t_local_arenas;
+
+std::uintptr_t round_up(std::uintptr_t n, std::size_t alignment) noexcept
+    { return (n + alignment - 1) & ~(alignment - 1); }
+
+} // end of <anonymous> namespace
+
+namespace cul {
+
+FrameArena::FrameArena(std::size_t block_size, bool can_grow):
+    m_block_size(std::max(block_size, k_block_alignment)),
+    m_can_grow(can_grow),
+    m_id(s_next_arena_id++)
+{ push_block(m_block_size); }
+
+FrameArena::~FrameArena() { free_blocks(); }
+
+void FrameArena::reset() {
+    {
+    std::lock_guard lock(m_locals_mutex);
+    for (auto & local : m_locals) local->reset();
+    }
+#   ifndef NDEBUG
+    // poison everything handed out this frame, before any of it is freed
+    for (auto & block : m_blocks) {
+        bool is_last = &block == &m_blocks.back();
+        std::memset(block.data, k_poison_byte, is_last ? m_position : block.size);
+    }
+#   endif
+    if (m_blocks.size() > 1) {
+        // coalesce so that the next frame of the same size needs one block
+        // (allocated first, so a throw leaves the arena as it was)
+        push_block(capacity());
+        for (auto itr = m_blocks.begin(); itr != m_blocks.end() - 1; ++itr)
+            { ::operator delete(itr->data, std::align_val_t(k_block_alignment)); }
+        m_blocks.erase(m_blocks.begin(), m_blocks.end() - 1);
+    }
+    m_position = 0;
+}
+
+FrameArena & FrameArena::local_arena() {
+    for (auto & [id, arena] : t_local_arenas) {
+        if (id == m_id) return *arena;
+    }
+    FrameArena * local = nullptr;
+    {
+    std::lock_guard lock(m_locals_mutex);
+    m_locals.emplace_back(std::make_unique<FrameArena>(m_block_size, true));
+    local = m_locals.back().get();
+    }
+    t_local_arenas.emplace_back(m_id, local);
+    return *local;
+}
+
+std::size_t FrameArena::bytes_in_use() const noexcept
+    { return capacity() - m_blocks.back().size + m_position; }
+
+std::size_t FrameArena::capacity() const noexcept {
+    std::size_t total = 0;
+    for (const auto & block : m_blocks) total += block.size;
+    return total;
+}
+
+/* private */ void * FrameArena::do_allocate
+    (std::size_t bytes, std::size_t alignment)
+{
+    if (auto * rv = bump(bytes, alignment)) return rv;
+    if (!m_can_grow) throw std::bad_alloc();
+    // the rest of the current block is abandoned until reset
+    // (over aligned requests may need padding, even at the start of a block)
+    auto padding = alignment > k_block_alignment ? alignment : 0;
+    if (bytes > std::numeric_limits<std::size_t>::max() - padding)
+        { throw std::bad_alloc(); }
+    push_block(std::max(m_block_size, bytes + padding));
+    m_position = 0;
+    auto * rv = bump(bytes, alignment);
+    assert(rv);
+    return rv;
+}
+
+/* private */ void FrameArena::do_deallocate
+    (void * ptr, std::size_t bytes, std::size_t)
+{
+    // only the most recent allocation can be given back (which is what
+    // happens to a growing vector's old buffer, often enough)
+    auto * bptr = static_cast<std::byte *>(ptr);
+    const auto & block = m_blocks.back();
+    if (bptr >= block.data && bptr + bytes == block.data + m_position) {
+        m_position = std::size_t(bptr - block.data);
+    }
+}
+
+/* private */ bool FrameArena::do_is_equal
+    (const std::pmr::memory_resource & other) const noexcept
+{ return this == &other; }
+
+/* private */ void * FrameArena::bump
+    (std::size_t bytes, std::size_t alignment) noexcept
+{
+    const auto & block = m_blocks.back();
+    auto addr  = reinterpret_cast<std::uintptr_t>(block.data);
+    auto start = round_up(addr + m_position, alignment) - addr;
+    // (written so that huge requests cannot wrap around)
+    if (start > block.size || bytes > block.size - start) return nullptr;
+    m_position = start + bytes;
+    return block.data + start;
+}
+
+/* private */ void FrameArena::push_block(std::size_t size) {
+    auto * data = static_cast<std::byte *>
+        (::operator new(size, std::align_val_t(k_block_alignment)));
+    try {
+        m_blocks.push_back(Block { data, size });
+    } catch (...) {
+        ::operator delete(data, std::align_val_t(k_block_alignment));
+        throw;
+    }
+}
+
+/* private */ void FrameArena::free_blocks() noexcept {
+    for (auto & block : m_blocks)
+        { ::operator delete(block.data, std::align_val_t(k_block_alignment)); }
+    m_blocks.clear();
+}
+
+} // end of cul namespace
@@ -0,0 +1,249 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Metrics.hpp>
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <ostream>
+#include <algorithm>
+
+namespace {
+
+using namespace cul;
+using HistogramSummary = MetricsSnapshot::HistogramSummary;
+
+int log2_floor(std::uint64_t value) noexcept;
+
+HistogramSummary summarize(std::string name, const Histogram &);
+
+void write_json_string(std::ostream &, const std::string &);
+
+} // end of <anonymous> namespace
+
+namespace cul {
+
+// ----------------------------------------------------------------------------
+
+void Histogram::record(std::uint64_t value) noexcept {
+    m_buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+    auto old_max = m_max.load(std::memory_order_relaxed);
+    while (value > old_max &&
+           !m_max.compare_exchange_weak(old_max, value, std::memory_order_relaxed))
+    {}
+}
+
+std::uint64_t Histogram::count() const noexcept {
+    std::uint64_t sum = 0;
+    for (const auto & bucket : m_buckets)
+        { sum += bucket.load(std::memory_order_relaxed); }
+    return sum;
+}
+
+std::uint64_t Histogram::value_at(double fraction) const noexcept {
+    auto total = count();
+    if (total == 0) return 0;
+    fraction = std::min(1., std::max(0., fraction));
+    auto wanted = std::max(std::uint64_t(1), std::uint64_t(fraction*double(total) + 0.5));
+    std::uint64_t seen = 0;
+    for (int i = 0; i != k_bucket_count; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= wanted) return std::min(highest_in_bucket(i), max());
+    }
+    return max();
+}
+
+void Histogram::reset() noexcept {
+    for (auto & bucket : m_buckets) bucket.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+/* static */ int Histogram::bucket_of(std::uint64_t value) noexcept {
+    if (value < std::uint64_t(k_sub_bucket_count)) return int(value);
+    auto exp = log2_floor(value);
+    auto sub = int(value >> (exp - k_sub_bucket_bits)) & (k_sub_bucket_count - 1);
+    return (exp - k_sub_bucket_bits + 1)*k_sub_bucket_count + sub;
+}
+
+/* static */ std::uint64_t Histogram::lowest_in_bucket(int bucket) noexcept {
+    if (bucket < k_sub_bucket_count) return std::uint64_t(bucket);
+    auto exp = bucket / k_sub_bucket_count + k_sub_bucket_bits - 1;
+    auto sub = std::uint64_t(bucket % k_sub_bucket_count);
+    return (std::uint64_t(k_sub_bucket_count) + sub) << (exp - k_sub_bucket_bits);
+}
+
+/* static */ std::uint64_t Histogram::highest_in_bucket(int bucket) noexcept {
+    if (bucket < k_sub_bucket_count) return std::uint64_t(bucket);
+    auto exp = bucket / k_sub_bucket_count + k_sub_bucket_bits - 1;
+    return lowest_in_bucket(bucket) + ((std::uint64_t(1) << (exp - k_sub_bucket_bits)) - 1);
+}
+
+// ----------------------------------------------------------------------------
+
+struct MetricsRegistry::Impl {
+    mutable std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+};
+
+/* static */ MetricsRegistry & MetricsRegistry::instance() {
+    static MetricsRegistry inst;
+    return inst;
+}
+
+Counter & MetricsRegistry::counter(const std::string & name) {
+    std::lock_guard lock(impl().mutex);
+    auto & ptr = impl().counters[name];
+    if (!ptr) ptr = std::make_unique<Counter>();
+    return *ptr;
+}
+
+Histogram & MetricsRegistry::histogram(const std::string & name) {
+    std::lock_guard lock(impl().mutex);
+    auto & ptr = impl().histograms[name];
+    if (!ptr) ptr = std::make_unique<Histogram>();
+    return *ptr;
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    MetricsSnapshot rv;
+    const auto & builtins = builtin_metrics();
+    rv.counters = {
+        { "cul.bounds_check_throws"      , builtins.bounds_check_throws      .value() },
+        { "cul.grid_allocations"         , builtins.grid_allocations         .value() },
+        { "cul.grid_resizes"             , builtins.grid_resizes             .value() },
+        { "cul.line_verticies"           , builtins.line_verticies           .value() },
+        { "cul.string_to_number_failures", builtins.string_to_number_failures.value() },
+        { "cul.text_verticies"           , builtins.text_verticies           .value() }
+    };
+    rv.histograms.push_back(summarize("cul.task_graph_run_ns", builtins.task_graph_run_ns));
+    {
+    std::lock_guard lock(impl().mutex);
+    for (const auto & [name, counter_] : impl().counters)
+        { rv.counters.emplace_back(name, counter_->value()); }
+    for (const auto & [name, histogram_] : impl().histograms)
+        { rv.histograms.push_back(summarize(name, *histogram_)); }
+    }
+    std::sort(rv.counters.begin(), rv.counters.end());
+    std::sort(rv.histograms.begin(), rv.histograms.end(),
+              [](const HistogramSummary & a, const HistogramSummary & b)
+              { return a.name < b.name; });
+    return rv;
+}
+
+void MetricsRegistry::reset() {
+    auto & builtins = builtin_metrics();
+    for (auto * counter_ : { &builtins.bounds_check_throws, &builtins.grid_allocations,
+                             &builtins.grid_resizes, &builtins.line_verticies,
+                             &builtins.string_to_number_failures, &builtins.text_verticies })
+    { counter_->reset(); }
+    builtins.task_graph_run_ns.reset();
+
+    std::lock_guard lock(impl().mutex);
+    for (auto & pair : impl().counters  ) pair.second->reset();
+    for (auto & pair : impl().histograms) pair.second->reset();
+}
+
+/* private */ MetricsRegistry::Impl & MetricsRegistry::impl() const {
+    static Impl inst;
+    return inst;
+}
+
+// ----------------------------------------------------------------------------
+
+void write_text(std::ostream & out, const MetricsSnapshot & snapshot) {
+    for (const auto & [name, value] : snapshot.counters) {
+        out << name << " " << value << "\n";
+    }
+    for (const auto & hist : snapshot.histograms) {
+        out << hist.name << " count=" << hist.count << " sum=" << hist.sum
+            << " max=" << hist.max << " p50=" << hist.p50 << " p90=" << hist.p90
+            << " p99=" << hist.p99 << "\n";
+    }
+}
+
+void write_json(std::ostream & out, const MetricsSnapshot & snapshot) {
+    out << "{\"counters\":{";
+    bool is_first = true;
+    for (const auto & [name, value] : snapshot.counters) {
+        if (!is_first) out << ",";
+        write_json_string(out, name);
+        out << ":" << value;
+        is_first = false;
+    }
+    out << "},\"histograms\":{";
+    is_first = true;
+    for (const auto & hist : snapshot.histograms) {
+        if (!is_first) out << ",";
+        write_json_string(out, hist.name);
+        out << ":{\"count\":" << hist.count << ",\"sum\":" << hist.sum
+            << ",\"max\":" << hist.max << ",\"p50\":" << hist.p50
+            << ",\"p90\":" << hist.p90 << ",\"p99\":" << hist.p99 << "}";
+        is_first = false;
+    }
+    out << "}}";
+}
+
+} // end of cul namespace
+
+namespace {
+
+int log2_floor(std::uint64_t value) noexcept {
+    int rv = 0;
+    for (int shift = 32; shift != 0; shift /= 2) {
+        if (value >> shift) {
+            value >>= shift;
+            rv += shift;
+        }
+    }
+    return rv;
+}
+
+HistogramSummary summarize(std::string name, const Histogram & histogram) {
+    HistogramSummary rv;
+    rv.name  = std::move(name);
+    rv.count = histogram.count();
+    rv.sum   = histogram.sum();
+    rv.max   = histogram.max();
+    rv.p50   = histogram.value_at(0.5 );
+    rv.p90   = histogram.value_at(0.9 );
+    rv.p99   = histogram.value_at(0.99);
+    return rv;
+}
+
+void write_json_string(std::ostream & out, const std::string & str) {
+    out << "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') out << '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out << c;
+    }
+    out << "\"";
+}
+
+} // end of <anonymous> namespace
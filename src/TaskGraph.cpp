@@ -0,0 +1,249 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/TaskGraph.hpp>
+#include <common/Util.hpp>
+#include <common/Trace.hpp>
+#include <common/Metrics.hpp>
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include <cassert>
+
+namespace {
+
+using namespace cul::exceptions_abbr;
+
+} // end of <anonymous> namespace
+
+namespace cul {
+
+TaskGraph::TaskId TaskGraph::add_task
+    (std::function<void()> && f, Affinity affinity)
+{
+    if (!f) {
+        throw InvArg("TaskGraph::add_task: task function must not be empty.");
+    }
+    auto node = std::make_unique<Node>();
+    node->parent   = this;
+    node->id       = task_count();
+    node->function = std::move(f);
+    node->affinity = affinity;
+    node->execute  = execute_node;
+    node->group    = &m_group;
+    m_nodes.emplace_back(std::move(node));
+    m_is_prepared = false;
+    return m_nodes.back()->id;
+}
+
+void TaskGraph::add_dependency(TaskId before, TaskId after) {
+    verify_id("TaskGraph::add_dependency", before);
+    verify_id("TaskGraph::add_dependency", after );
+    if (before == after) {
+        throw InvArg("TaskGraph::add_dependency: a task cannot depend on "
+                     "itself.");
+    }
+    m_nodes[std::size_t(before)]->explicit_successors.push_back(after);
+    m_is_prepared = false;
+}
+
+void TaskGraph::add_read(TaskId id, Resource res) {
+    verify_id("TaskGraph::add_read", id);
+    m_nodes[std::size_t(id)]->reads.push_back(res);
+    m_is_prepared = false;
+}
+
+void TaskGraph::add_write(TaskId id, Resource res) {
+    verify_id("TaskGraph::add_write", id);
+    m_nodes[std::size_t(id)]->writes.push_back(res);
+    m_is_prepared = false;
+}
+
+void TaskGraph::prepare() {
+    // gather every edge as (before, after) pairs
+    std::vector<std::pair<TaskId, TaskId>> edges;
+    for (const auto & node : m_nodes) {
+        for (auto after : node->explicit_successors)
+            edges.emplace_back(node->id, after);
+    }
+
+    struct Access {
+        TaskId last_writer = -1;
+        std::vector<TaskId> readers_since_write;
+    };
+    std::map<Resource, Access> accesses;
+    for (const auto & node : m_nodes) {
+        for (auto res : node->reads) {
+            auto & access = accesses[res];
+            if (access.last_writer != -1)
+                edges.emplace_back(access.last_writer, node->id);
+            access.readers_since_write.push_back(node->id);
+        }
+        for (auto res : node->writes) {
+            auto & access = accesses[res];
+            if (access.last_writer != -1)
+                edges.emplace_back(access.last_writer, node->id);
+            for (auto reader : access.readers_since_write) {
+                if (reader != node->id) edges.emplace_back(reader, node->id);
+            }
+            access.readers_since_write.clear();
+            access.last_writer = node->id;
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // flatten successor lists, edges are sorted by "before"
+    m_successors.clear();
+    m_successors.reserve(edges.size());
+    for (auto & node : m_nodes) {
+        node->dependency_count = 0;
+    }
+    auto itr = edges.begin();
+    for (auto & node : m_nodes) {
+        node->successors_begin = int(m_successors.size());
+        for (; itr != edges.end() && itr->first == node->id; ++itr) {
+            m_successors.push_back(itr->second);
+            ++m_nodes[std::size_t(itr->second)]->dependency_count;
+        }
+        node->successors_end = int(m_successors.size());
+    }
+
+    m_roots.clear();
+    int main_count = 0;
+    for (const auto & node : m_nodes) {
+        if (node->dependency_count == 0) m_roots.push_back(node->id);
+        if (node->affinity == k_main_thread) ++main_count;
+    }
+
+    // Kahn's algorithm, to find cycles before they hang a run
+    std::vector<int> counts;
+    counts.reserve(m_nodes.size());
+    for (const auto & node : m_nodes) counts.push_back(node->dependency_count);
+    std::vector<TaskId> ready = m_roots;
+    int visited = 0;
+    while (!ready.empty()) {
+        const auto & node = *m_nodes[std::size_t(ready.back())];
+        ready.pop_back();
+        ++visited;
+        for (int i = node.successors_begin; i != node.successors_end; ++i) {
+            auto succ = m_successors[std::size_t(i)];
+            if (--counts[std::size_t(succ)] == 0) ready.push_back(succ);
+        }
+    }
+    if (visited != task_count()) {
+        throw InvArg("TaskGraph::prepare: graph has a dependency cycle.");
+    }
+
+    m_main_ready.clear();
+    m_main_ready.reserve(std::size_t(main_count));
+    m_is_prepared = true;
+}
+
+void TaskGraph::run(ThreadPool & pool) {
+    CUL_TRACE_SCOPE("TaskGraph::run");
+    ScopedLatency latency(builtin_metrics().task_graph_run_ns);
+    if (!m_is_prepared) prepare();
+    if (m_nodes.empty()) return;
+
+    m_pool = &pool;
+    m_has_failed.store(false);
+    m_exception = nullptr;
+    for (auto & node : m_nodes) {
+        node->remaining_dependencies.store(node->dependency_count,
+                                           std::memory_order_relaxed);
+    }
+    m_unfinished.store(task_count());
+    for (auto id : m_roots) {
+        schedule(*m_nodes[std::size_t(id)]);
+    }
+
+    while (m_unfinished.load(std::memory_order_acquire) > 0) {
+        Node * main_node = nullptr;
+        {
+        std::lock_guard<std::mutex> lock(m_main_mutex);
+        if (!m_main_ready.empty()) {
+            main_node = m_nodes[std::size_t(m_main_ready.back())].get();
+            m_main_ready.pop_back();
+        }
+        }
+        if (main_node) {
+            run_node(*main_node);
+        } else if (!pool.run_pending_task()) {
+            std::this_thread::yield();
+        }
+    }
+    // every node has finished, though a worker may still be returning from
+    // its last node
+    pool.wait(m_group);
+    m_pool = nullptr;
+    if (m_exception) std::rethrow_exception(m_exception);
+}
+
+/* private static */ void TaskGraph::execute_node(Task & task) {
+    auto & node = static_cast<Node &>(task);
+    node.parent->run_node(node);
+}
+
+/* private */ void TaskGraph::verify_id(const char * caller, TaskId id) const {
+    if (id >= 0 && id < task_count()) return;
+    throw InvArg(std::string(caller) + ": task id " + std::to_string(id)
+                 + " is not in this graph.");
+}
+
+/* private */ void TaskGraph::run_node(Node & node) {
+    if (!m_has_failed.load(std::memory_order_relaxed)) {
+        try {
+            node.function();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_exception_mutex);
+            if (!m_exception) m_exception = std::current_exception();
+            m_has_failed.store(true);
+        }
+    }
+    // successors must be scheduled before this node counts as finished,
+    // otherwise "run" may return early
+    for (int i = node.successors_begin; i != node.successors_end; ++i) {
+        auto & succ = *m_nodes[std::size_t(m_successors[std::size_t(i)])];
+        if (succ.remaining_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            { schedule(succ); }
+    }
+    m_unfinished.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/* private */ void TaskGraph::schedule(Node & node) {
+    if (node.affinity == k_main_thread) {
+        std::lock_guard<std::mutex> lock(m_main_mutex);
+        assert(m_main_ready.size() < m_main_ready.capacity());
+        m_main_ready.push_back(node.id);
+    } else {
+        m_pool->submit(node);
+    }
+}
+
+} // end of cul namespace
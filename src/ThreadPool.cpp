@@ -0,0 +1,281 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/ThreadPool.hpp>
+#include <common/Util.hpp>
+
+#include <cassert>
+
+namespace {
+
+using namespace cul::exceptions_abbr;
+using cul::Task;
+using cul::ThreadPool;
+
+// how many times an idle worker looks for work before going to sleep
+constexpr const int k_spin_count = 64;
+
+constexpr const int k_not_a_worker = -1;
+
+thread_local const ThreadPool * t_current_pool = nullptr;
+thread_local int t_worker_index = k_not_a_worker;
+
+} // end of <anonymous> namespace
+
+namespace cul {
+
+/* private */ void TaskGroup::keep_exception(std::exception_ptr ptr) noexcept {
+    if (m_has_exception.test_and_set(std::memory_order_acq_rel)) return;
+    m_exception = ptr;
+}
+
+/* private */ void TaskGroup::rethrow_kept_exception() {
+    if (!m_exception) return;
+    auto ptr = std::move(m_exception);
+    m_exception = nullptr;
+    m_has_exception.clear(std::memory_order_release);
+    std::rethrow_exception(ptr);
+}
+
+namespace detail {
+
+TaskDeque::Buffer::Buffer(std::int64_t capacity_):
+    capacity(capacity_),
+    mask(capacity_ - 1),
+    slots(new std::atomic<Task *>[std::size_t(capacity_)])
+{ assert((capacity & mask) == 0); }
+
+TaskDeque::TaskDeque() {
+    m_buffers.emplace_back(std::make_unique<Buffer>(k_initial_capacity));
+    m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+}
+
+TaskDeque::~TaskDeque() {}
+
+void TaskDeque::push(Task * task) {
+    auto bottom = m_bottom.load(std::memory_order_relaxed);
+    auto top    = m_top   .load(std::memory_order_acquire);
+    auto * buf  = m_buffer.load(std::memory_order_relaxed);
+    if (bottom - top > buf->capacity - 1) {
+        buf = grow(buf, top, bottom);
+    }
+    buf->put(bottom, task);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+Task * TaskDeque::pop() noexcept {
+    auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    auto * buf  = m_buffer.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = m_top.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        // was already empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Task * rv = buf->get(bottom);
+    if (top == bottom) {
+        // last element, race against thieves for it
+        if (!m_top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed))
+        { rv = nullptr; }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return rv;
+}
+
+Task * TaskDeque::steal() noexcept {
+    auto top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom) return nullptr;
+    auto * buf = m_buffer.load(std::memory_order_acquire);
+    Task * rv = buf->get(top);
+    if (!m_top.compare_exchange_strong(top, top + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed))
+    { return nullptr; }
+    return rv;
+}
+
+/* private */ TaskDeque::Buffer * TaskDeque::grow
+    (Buffer * old, std::int64_t top, std::int64_t bottom)
+{
+    auto new_buf = std::make_unique<Buffer>(old->capacity*2);
+    for (auto i = top; i != bottom; ++i) {
+        new_buf->put(i, old->get(i));
+    }
+    auto * rv = new_buf.get();
+    m_buffers.emplace_back(std::move(new_buf));
+    m_buffer.store(rv, std::memory_order_release);
+    return rv;
+}
+
+} // end of detail namespace -> into ::cul
+
+ThreadPool::ThreadPool(int worker_count_) {
+    if (worker_count_ < 0) {
+        throw InvArg("ThreadPool::ThreadPool: worker count must be a "
+                     "non-negative integer.");
+    }
+    m_workers.reserve(std::size_t(worker_count_));
+    for (int i = 0; i != worker_count_; ++i) {
+        m_workers.emplace_back(std::make_unique<Worker>());
+    }
+    // workers must all exist before any of them start stealing
+    for (int i = 0; i != worker_count_; ++i) {
+        m_workers[std::size_t(i)]->thread = std::thread([this, i] { run_worker(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    m_stopping.store(true);
+    {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    m_sleep_cv.notify_all();
+    }
+    for (auto & worker : m_workers) {
+        worker->thread.join();
+    }
+}
+
+/* static */ ThreadPool & ThreadPool::default_instance() {
+    static ThreadPool s_pool(std::max(0, int(std::thread::hardware_concurrency()) - 1));
+    return s_pool;
+}
+
+void ThreadPool::submit(Task & task) { submit(task, 1); }
+
+void ThreadPool::submit(Task & task, int times) {
+    if (!task.execute || !task.group) {
+        throw InvArg("ThreadPool::submit: task must have both an execute "
+                     "function and a group.");
+    }
+    if (times < 1) return;
+    task.group->add_pending(times);
+    enqueue(&task, times);
+}
+
+void ThreadPool::wait(TaskGroup & group) {
+    while (!group.is_done()) {
+        if (!run_pending_task()) std::this_thread::yield();
+    }
+    group.rethrow_kept_exception();
+}
+
+bool ThreadPool::run_pending_task() {
+    int own_index = (t_current_pool == this) ? t_worker_index : k_not_a_worker;
+    return try_run_one(own_index);
+}
+
+/* private */ void ThreadPool::run_worker(int index) {
+    t_current_pool = this;
+    t_worker_index = index;
+    while (true) {
+        if (try_run_one(index)) continue;
+
+        bool found = false;
+        for (int i = 0; i != k_spin_count && !found; ++i) {
+            std::this_thread::yield();
+            found = try_run_one(index);
+        }
+        if (found) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        ++m_sleepers;
+        m_sleep_cv.wait(lock, [this]
+            { return m_queued.load() > 0 || m_stopping.load(); });
+        --m_sleepers;
+        if (m_stopping.load() && m_queued.load() <= 0) return;
+    }
+}
+
+/* private */ void ThreadPool::enqueue(Task * task, int times) {
+    // count first, so that a sleeping worker cannot miss this task
+    m_queued.fetch_add(times);
+    if (t_current_pool == this) {
+        auto & deque = m_workers[std::size_t(t_worker_index)]->deque;
+        for (int i = 0; i != times; ++i) deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(m_shared_mutex);
+        m_shared_queue.insert(m_shared_queue.end(), std::size_t(times), task);
+        m_shared_size.store(int(m_shared_queue.size()), std::memory_order_relaxed);
+    }
+    if (m_sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        if (times == 1) m_sleep_cv.notify_one();
+        else            m_sleep_cv.notify_all();
+    }
+}
+
+/* private */ bool ThreadPool::try_run_one(int own_index) {
+    Task * task = find_task(own_index);
+    if (!task) return false;
+    m_queued.fetch_sub(1);
+    execute(task);
+    return true;
+}
+
+/* private */ Task * ThreadPool::find_task(int own_index) {
+    if (own_index != k_not_a_worker) {
+        if (auto * task = m_workers[std::size_t(own_index)]->deque.pop())
+            { return task; }
+    }
+    if (m_shared_size.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(m_shared_mutex);
+        if (!m_shared_queue.empty()) {
+            auto * task = m_shared_queue.back();
+            m_shared_queue.pop_back();
+            m_shared_size.store(int(m_shared_queue.size()), std::memory_order_relaxed);
+            return task;
+        }
+    }
+    // steal, starting from the next worker over so that thieves spread out
+    int count = worker_count();
+    int start = (own_index == k_not_a_worker) ? 0 : own_index + 1;
+    for (int i = 0; i != count; ++i) {
+        int victim = (start + i) % count;
+        if (victim == own_index) continue;
+        if (auto * task = m_workers[std::size_t(victim)]->deque.steal())
+            { return task; }
+    }
+    return nullptr;
+}
+
+/* private static */ void ThreadPool::execute(Task * task) {
+    // the task may destroy itself (or be destroyed by its owner as soon as
+    // the group finishes), so the group must be read first
+    TaskGroup * group = task->group;
+    try {
+        task->execute(*task);
+    } catch (...) {
+        group->keep_exception(std::current_exception());
+    }
+    group->finish_one();
+}
+
+} // end of cul namespace
@@ -0,0 +1,162 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Trace.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <ostream>
+#include <algorithm>
+
+namespace {
+
+using cul::trace::Event;
+using cul::trace::k_events_per_thread;
+
+static_assert((k_events_per_thread & (k_events_per_thread - 1)) == 0,
+              "Events per thread must be a power of two.");
+
+// single writer (the owning thread), read only when threads are idle
+struct ThreadEvents final {
+    explicit ThreadEvents(int thread_id_):
+        thread_id(thread_id_),
+        events(new Event[k_events_per_thread])
+    {}
+
+    void push(const Event & event) noexcept {
+        auto pos = count.load(std::memory_order_relaxed);
+        events[pos & (k_events_per_thread - 1)] = event;
+        count.store(pos + 1, std::memory_order_release);
+    }
+
+    const int thread_id;
+    std::atomic<std::uint64_t> count = 0;
+    std::unique_ptr<Event[]> events;
+};
+
+// buffers are kept after their threads finish, so that short lived threads
+// still show up
+class ThreadEventsRegistry final {
+public:
+    static ThreadEventsRegistry & instance() {
+        static ThreadEventsRegistry inst;
+        return inst;
+    }
+
+    std::shared_ptr<ThreadEvents> make_thread_events() {
+        std::lock_guard lock(m_mutex);
+        m_all.emplace_back(std::make_shared<ThreadEvents>(int(m_all.size()) + 1));
+        return m_all.back();
+    }
+
+    template <typename Func>
+    void for_each(Func && f) {
+        std::lock_guard lock(m_mutex);
+        for (auto & thread_events : m_all) f(*thread_events);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<ThreadEvents>> m_all;
+};
+
+ThreadEvents * get_thread_events();
+
+void write_escaped(std::ostream &, const char *);
+
+} // end of <anonymous> namespace
+
+namespace cul {
+
+namespace trace {
+
+void record(const Event & event) noexcept {
+    if (auto * thread_events = get_thread_events()) thread_events->push(event);
+}
+
+void write_chrome_trace(std::ostream & out) {
+    // ts and dur are in microseconds
+    static constexpr const double k_ns_to_us = 1. / 1000.;
+    out << "{\"traceEvents\":[";
+    bool is_first = true;
+    ThreadEventsRegistry::instance().for_each([&](ThreadEvents & thread_events) {
+        auto last  = thread_events.count.load(std::memory_order_acquire);
+        auto first = last > k_events_per_thread ? last - k_events_per_thread : 0;
+        for (auto i = first; i != last; ++i) {
+            const auto & event = thread_events.events[i & (k_events_per_thread - 1)];
+            out << (is_first ? "\n" : ",\n") << "{\"name\":\"";
+            write_escaped(out, event.name);
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_events.thread_id
+                << ",\"ts\":"  << double(event.begin_ns)*k_ns_to_us
+                << ",\"dur\":" << double(event.end_ns - event.begin_ns)*k_ns_to_us
+                << "}";
+            is_first = false;
+        }
+    });
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void clear() {
+    ThreadEventsRegistry::instance().for_each([](ThreadEvents & thread_events)
+        { thread_events.count.store(0, std::memory_order_release); });
+}
+
+} // end of trace namespace -> into ::cul
+
+} // end of cul namespace
+
+namespace {
+
+ThreadEvents * get_thread_events() {
+    thread_local std::shared_ptr<ThreadEvents> t_thread_events;
+    if (!t_thread_events) {
+        try {
+            t_thread_events = ThreadEventsRegistry::instance().make_thread_events();
+        } catch (...) {
+            // tracing is not worth crashing over, drop the event
+            return nullptr;
+        }
+    }
+    return t_thread_events.get();
+}
+
+void write_escaped(std::ostream & out, const char * str) {
+    if (!str) return;
+    for (; *str; ++str) {
+        switch (*str) {
+        case '"' : out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n" ; break;
+        default:
+            if (static_cast<unsigned char>(*str) < 0x20) continue;
+            out << *str;
+        }
+    }
+}
+
+} // end of <anonymous> namespace
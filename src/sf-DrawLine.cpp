@@ -28,8 +28,10 @@
 
 #include <common/Util.hpp>
 #include <common/Vector2Util.hpp>
+#include <common/Metrics.hpp>
 #include <common/SfmlVectorTraits.hpp>
 #include <common/sf/DrawRectangle.hpp>
+#include <common/sf/Util.hpp>
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
@@ -88,6 +90,9 @@ void DrawLine::move(sf::Vector2f r) {
     for (auto & vtx : m_verticies) vtx.position += r;
 }
 
+void DrawLine::transform(const Transform2<float> & t)
+    { transform_verticies(t, m_verticies.data(), m_verticies.data() + m_verticies.size()); }
+
 Iterator DrawLine::begin() const { return m_verticies.begin(); }
 
 Iterator DrawLine::end() const { return m_verticies.end(); }
@@ -128,6 +133,7 @@ Iterator DrawLine::end() const { return m_verticies.end(); }
     m_verticies[k_a_down] = mk_vertex(a, -1.f);
     m_verticies[k_b_down] = mk_vertex(b, -1.f);
     m_verticies[k_b_up  ] = mk_vertex(b,  1.f);
+    builtin_metrics().line_verticies.add(m_verticies.size());
 }
 
 } // end of cul namespace
@@ -30,6 +30,7 @@
 #include <common/SfmlVectorTraits.hpp>
 #include <common/Vector2Util.hpp>
 #include <common/sf/Util.hpp>
+#include <common/Trace.hpp>
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Texture.hpp>
@@ -92,6 +93,9 @@ void DrawText::move(sf::Vector2f r) {
         vtx.position += r;
 }
 
+void DrawText::transform(const Transform2<float> & t)
+    { transform_verticies(t, m_verticies.data(), m_verticies.data() + m_verticies.size()); }
+
 Size2<float> DrawText::measure_text(int character_count) const {
     if (!m_font) {
         throw RtError("DrawText::measure_text: a font is needed in order to "
@@ -110,6 +114,14 @@ std::vector<sf::Vertex> DrawText::give_verticies() {
     return rv;
 }
 
+std::pmr::vector<sf::Vertex> DrawText::give_verticies
+    (std::pmr::memory_resource * resource)
+{
+    std::pmr::vector<sf::Vertex> rv(m_verticies.begin(), m_verticies.end(), resource);
+    m_verticies.clear();
+    return rv;
+}
+
 const std::vector<sf::Vertex> & DrawText::verticies() const
     { return m_verticies; }
 
@@ -209,6 +221,7 @@ std::array<sf::Vector2f, k_rect_count> to_texture_positions
 
 void SfBitmapFontComplete::setup(const GridBitmapFont & font) {
     // terse, but computationally intense
+    CUL_TRACE_SCOPE("SfBitmapFontComplete::setup");
     using namespace cul;
     m_font = &font;
     Grid<sf::Color> grid_texture;
@@ -25,6 +25,7 @@
 *****************************************************************************/
 
 #include <common/sf/DrawTriangle.hpp>
+#include <common/sf/Util.hpp>
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
@@ -54,6 +55,9 @@ void DrawTriangle::move(VectorF r) {
         v.position += r;
 }
 
+void DrawTriangle::transform(const Transform2<float> & t)
+    { transform_verticies(t, m_verticies.data(), m_verticies.data() + m_verticies.size()); }
+
 void DrawTriangle::set_center(VectorF r)
     { move(r - center()); }
 
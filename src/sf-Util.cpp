@@ -25,16 +25,21 @@
 *****************************************************************************/
 
 #include <common/sf/Util.hpp>
+#include <common/Trace.hpp>
+#include <common/Triangulation.hpp>
 
 namespace {
 
 using GridVector = cul::Grid<sf::Color>::Vector;
+using VectorF    = cul::Vector2<float>;
+using HoleList   = std::vector<std::vector<VectorF>>;
 
 } // end of <anonymous> namespace
 
 namespace cul {
 
 sf::Image to_image(const Grid<sf::Color> & grid) {
+    CUL_TRACE_SCOPE("to_image");
     sf::Image img;
     img.create(unsigned(grid.width()), unsigned(grid.height()));
     for (GridVector r; r != grid.end_position(); r = grid.next(r)) {
@@ -43,7 +48,42 @@ sf::Image to_image(const Grid<sf::Color> & grid) {
     return img;
 }
 
+void transform_verticies
+    (const Transform2<float> & t, sf::Vertex * first, sf::Vertex * last)
+{
+    // verticies are not packed positions, so there's no SIMD here, but this
+    // is still only four multiplies and four adds per vertex
+    for (; first != last; ++first) {
+        auto & pos = first->position;
+        pos = sf::Vector2f(t.a*pos.x + t.b*pos.y + t.tx, t.c*pos.x + t.d*pos.y + t.ty);
+    }
+}
+
+void fill_polygon_vertices
+    (const std::vector<VectorF> & outline, sf::Color color,
+     sf::VertexArray & vertices)
+{ fill_polygon_vertices(outline, HoleList{}, color, vertices); }
+
+void fill_polygon_vertices
+    (const std::vector<VectorF> & outline, const HoleList & holes,
+     sf::Color color, sf::VertexArray & vertices)
+{
+    CUL_TRACE_SCOPE("fill_polygon_vertices");
+    std::vector<std::size_t> indices;
+    triangulate_polygon(outline, holes, indices);
+    // indices count through the outline, then each hole
+    std::vector<VectorF> points = outline;
+    for (const auto & hole : holes)
+        { points.insert(points.end(), hole.begin(), hole.end()); }
+
+    vertices.setPrimitiveType(sf::Triangles);
+    vertices.resize(indices.size());
+    for (std::size_t i = 0; i != indices.size(); ++i)
+        { vertices[i] = sf::Vertex(to_sf_vec2f(points[indices[i]]), color); }
+}
+
 Grid<sf::Color> to_color_grid(const sf::Image & image) {
+    CUL_TRACE_SCOPE("to_color_grid");
     Grid<sf::Color> rv;
     rv.set_size(int(image.getSize().x), int(image.getSize().y));
     for (GridVector r; r != rv.end_position(); r = rv.next(r)) {
@@ -0,0 +1,227 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/DynamicAabbTree.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Rect   = Rectangle<float>;
+using Vec    = Vector2<float>;
+using Tree   = DynamicAabbTree<float, int>;
+using IdSet  = std::set<Tree::ProxyId>;
+using PairSet = std::set<std::pair<Tree::ProxyId, Tree::ProxyId>>;
+
+struct Object {
+    Tree::ProxyId id = Tree::k_null_proxy;
+    Rect bounds;
+};
+
+class RandomScene {
+public:
+    explicit RandomScene(unsigned seed): m_rng(seed) {}
+
+    Rect random_rectangle() {
+        std::uniform_real_distribution<float> pos(0, 100), size(0.5f, 6);
+        return Rect(pos(m_rng), pos(m_rng), size(m_rng), size(m_rng));
+    }
+
+    Vec random_vector(float max) {
+        std::uniform_real_distribution<float> dist(-max, max);
+        return Vec(dist(m_rng), dist(m_rng));
+    }
+
+    std::size_t random_index(std::size_t size)
+        { return std::uniform_int_distribution<std::size_t>(0, size - 1)(m_rng); }
+
+private:
+    std::default_random_engine m_rng;
+};
+
+IdSet brute_force_query(const std::vector<Object> & objects, const Rect & rect) {
+    IdSet rv;
+    for (const auto & obj : objects)
+        { if (overlaps(obj.bounds, rect)) rv.insert(obj.id); }
+    return rv;
+}
+
+IdSet tree_query(const Tree & tree, const Rect & rect) {
+    IdSet rv;
+    tree.query(rect, [&rv](Tree::ProxyId id, int) { rv.insert(id); });
+    return rv;
+}
+
+PairSet brute_force_pairs(const std::vector<Object> & objects) {
+    PairSet rv;
+    for (const auto & a : objects) {
+    for (const auto & b : objects) {
+        if (a.id < b.id && overlaps(a.bounds, b.bounds)) rv.emplace(a.id, b.id);
+    }}
+    return rv;
+}
+
+bool throws_invalid_argument(void (*f)()) {
+    try {
+        f();
+    } catch (std::invalid_argument &) {
+        return true;
+    }
+    return false;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("DynamicAabbTree");
+    suite.hide_successes();
+    mark(suite).test([] {
+        Tree tree(1.f);
+        auto a = tree.insert(Rect(0, 0, 2, 2), 10);
+        auto b = tree.insert(Rect(5, 5, 2, 2), 20);
+        IdSet hits = tree_query(tree, Rect(1, 1, 1, 1));
+        return ts::test(   tree.size() == 2 && hits == IdSet { a }
+                        && tree.payload_of(b) == 20
+                        && tree.fat_bounds_of(a).width == 4.f
+                        && tree.bounds_of(a).width == 2.f);
+    });
+    // queries agree with brute force, while inserting, moving, removing
+    mark(suite).test([] {
+        RandomScene scene(1);
+        Tree tree(0.5f);
+        std::vector<Object> objects;
+        bool all_good = true;
+        for (int step = 0; step != 3000; ++step) {
+            auto action = scene.random_index(10);
+            if (action < 4 || objects.size() < 10) {
+                Object obj;
+                obj.bounds = scene.random_rectangle();
+                obj.id = tree.insert(obj.bounds, int(objects.size()));
+                objects.push_back(obj);
+            } else if (action < 6) {
+                auto i = scene.random_index(objects.size());
+                tree.remove(objects[i].id);
+                objects.erase(objects.begin() + i);
+            } else {
+                auto & obj = objects[scene.random_index(objects.size())];
+                auto delta = scene.random_vector(2);
+                obj.bounds.left += delta.x;
+                obj.bounds.top  += delta.y;
+                tree.move(obj.id, obj.bounds, delta);
+            }
+            if (step % 50 == 0) {
+                auto rect = scene.random_rectangle();
+                rect.width  *= 4;
+                rect.height *= 4;
+                all_good = all_good && tree_query(tree, rect) == brute_force_query(objects, rect);
+            }
+        }
+        return ts::test(all_good && tree.size() == objects.size());
+    });
+    mark(suite).test([] {
+        RandomScene scene(2);
+        Tree tree;
+        std::vector<Object> objects;
+        for (int i = 0; i != 500; ++i) {
+            Object obj;
+            obj.bounds = scene.random_rectangle();
+            obj.id = tree.insert(obj.bounds, i);
+            objects.push_back(obj);
+        }
+        PairSet pairs;
+        bool ordered = true;
+        tree.for_each_overlapping_pair([&](Tree::ProxyId a, Tree::ProxyId b) {
+            ordered = ordered && a < b;
+            pairs.emplace(a, b);
+        });
+        int count = 0;
+        tree.for_each_overlapping_pair([&count](Tree::ProxyId, Tree::ProxyId) {
+            return ++count == 3 ? fc_signal::k_break : fc_signal::k_continue;
+        });
+        // balanced, far below the 500 of a list
+        return ts::test(   ordered && pairs == brute_force_pairs(objects) && count == 3
+                        && tree.height() < 30);
+    });
+    // points, with the same rules as is_contained_in
+    mark(suite).test([] {
+        Tree tree;
+        auto a = tree.insert(Rect(0, 0, 2, 2), 0);
+        tree.insert(Rect(3, 3, 1, 1), 1);
+        IdSet inside, on_edge;
+        tree.query(Vec(0, 0), [&inside](Tree::ProxyId id, int) { inside.insert(id); });
+        tree.query(Vec(2, 1), [&on_edge](Tree::ProxyId id, int) { on_edge.insert(id); });
+        return ts::test(inside == IdSet { a } && on_edge.empty());
+    });
+    mark(suite).test([] {
+        Tree tree;
+        auto near_ = tree.insert(Rect(2, -1, 1, 2), 0);
+        auto far_  = tree.insert(Rect(6, -1, 1, 2), 1);
+        tree.insert(Rect(4, 3, 1, 1), 2);
+        std::vector<std::pair<Tree::ProxyId, float>> hits;
+        tree.raycast(Vec(0, 0), Vec(10, 0), [&hits](Tree::ProxyId id, int, float fraction)
+            { hits.emplace_back(id, fraction); });
+        std::sort(hits.begin(), hits.end(),
+                  [](const auto & lhs, const auto & rhs) { return lhs.second < rhs.second; });
+        return ts::test(   hits.size() == 2
+                        && hits[0].first == near_ && are_within(hits[0].second, 0.2f, 1e-5f)
+                        && hits[1].first == far_  && are_within(hits[1].second, 0.6f, 1e-5f));
+    });
+    // moving within the margin does not touch the tree
+    mark(suite).test([] {
+        Tree tree(1.f);
+        auto a = tree.insert(Rect(0, 0, 1, 1), 0);
+        tree.insert(Rect(10, 10, 1, 1), 1);
+        bool small_move = tree.move(a, Rect(0.5f, 0.5f, 1, 1));
+        bool big_move   = tree.move(a, Rect(5, 5, 1, 1));
+        return ts::test(!small_move && big_move && tree_query(tree, Rect(5, 5, 1, 1)) == IdSet { a });
+    });
+    mark(suite).test([] {
+        return ts::test(   throws_invalid_argument([] { Tree().remove(0); })
+                        && throws_invalid_argument([] {
+                               Tree tree;
+                               auto a = tree.insert(Rect(0, 0, 1, 1), 0);
+                               tree.insert(Rect(0, 0, 1, 1), 0);
+                               // the node at a's old parent is not an object
+                               tree.remove(a);
+                               tree.payload_of(a);
+                           }));
+    });
+    mark(suite).test([] {
+        Tree tree;
+        for (int i = 0; i != 10; ++i) tree.insert(Rect(float(i), 0, 1, 1), i);
+        tree.clear();
+        auto a = tree.insert(Rect(0, 0, 1, 1), 7);
+        return ts::test(   tree.size() == 1 && tree.height() == 0
+                        && tree_query(tree, Rect(0, 0, 10, 10)) == IdSet { a });
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
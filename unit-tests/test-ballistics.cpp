@@ -0,0 +1,207 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Vector2Array.hpp>
+#include <common/TestSuite.hpp>
+
+#include <vector>
+#include <limits>
+#include <tuple>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+
+template <typename T>
+bool run_ballistics_tests(const char * series_name);
+
+// odd on purpose, so that both SIMD and scalar tail loops run
+constexpr const std::size_t k_test_size = 37;
+
+template <typename T>
+Vector2Array<T> make_test_targets(int seed) {
+    Vector2Array<T> rv;
+    for (std::size_t i = 0; i != k_test_size; ++i) {
+        int n = int(i)*7 + seed;
+        rv.push_back(Vector2<T>(T((n % 23) - 11), T((n % 17) - 8)));
+    }
+    return rv;
+}
+
+template <typename T>
+bool near(const Vector2<T> & a, const Vector2<T> & b) {
+    if (!is_real(a) || !is_real(b)) return a == b;
+    return are_within(a, b, T(0.001));
+}
+
+// compares the batch results against the one at a time function (which
+// throws for non real positions, where the batch has no solution)
+template <typename T>
+bool matches_scalar
+    (const Vector2Array<T> & sources, const Vector2Array<T> & targets,
+     const Vector2<T> & acc, T speed, const Vector2Array<T> & first,
+     const Vector2Array<T> & second, std::size_t count)
+{
+    std::size_t expected_count = 0;
+    for (std::size_t i = 0; i != targets.size(); ++i) {
+        auto s0 = get_no_solution_sentinel<Vector2<T>>();
+        auto s1 = s0;
+        if (is_real(sources[i]) && is_real(targets[i])) {
+            std::tie(s0, s1) = find_velocities_to_target
+                (sources[i], targets[i], acc, speed);
+        }
+        if (is_real(s0)) ++expected_count;
+        if (!near(s0, first[i]) || !near(s1, second[i])) return false;
+    }
+    return expected_count == count;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    bool all_good = true;
+    if (!run_ballistics_tests<float >("Ballistics<float>" )) all_good = false;
+    if (!run_ballistics_tests<double>("Ballistics<double>")) all_good = false;
+    return all_good ? 0 : ~0;
+}
+
+namespace {
+
+template <typename T>
+bool run_ballistics_tests(const char * series_name) {
+    using Array = Vector2Array<T>;
+    using Vec   = Vector2<T>;
+    ts::TestSuite suite(series_name);
+    suite.hide_successes();
+    // some reachable, some not
+    mark(suite).test([] {
+        auto targets = make_test_targets<T>(3);
+        auto sources = make_test_targets<T>(11);
+        Array first, second;
+        Vec acc(T(1), T(9.8));
+        auto count = find_velocities_to_target
+            (sources, targets, acc, T(7), first, second);
+        return ts::test(count > 0 && count < k_test_size &&
+            matches_scalar(sources, targets, acc, T(7), first, second, count));
+    });
+    // single source
+    mark(suite).test([] {
+        auto targets = make_test_targets<T>(5);
+        Vec source(T(2), T(-1));
+        Array sources;
+        for (std::size_t i = 0; i != targets.size(); ++i)
+            sources.push_back(source);
+        Array first, second;
+        Vec acc(T(0.5), T(-9.8));
+        auto count = find_velocities_to_target
+            (source, targets, acc, T(9), first, second);
+        return ts::test(first.size() == k_test_size &&
+            matches_scalar(sources, targets, acc, T(9), first, second, count));
+    });
+    // target at source: straight up against acceleration
+    mark(suite).test([] {
+        Array targets, first, second;
+        targets.push_back(Vec(T(3), T(4)));
+        auto count = find_velocities_to_target
+            (Vec(T(3), T(4)), targets, Vec(T(0), T(2)), T(5), first, second);
+        return ts::test(count == 1 && near(first[0], Vec(T(0), T(-5)))
+                        && near(second[0], Vec(T(0), T(-5))));
+    });
+    // no acceleration: straight to target
+    mark(suite).test([] {
+        Array targets, first, second;
+        targets.push_back(Vec(T(3), T(4)));
+        targets.push_back(Vec());
+        auto count = find_velocities_to_target
+            (Vec(), targets, Vec(), T(10), first, second);
+        return ts::test(count == 2 && near(first[0], Vec(T(6), T(8)))
+                        && near(second[0], Vec(T(6), T(8)))
+                        && near(first[1], Vec()));
+    });
+    // non real targets have no solution, with or without acceleration
+    mark(suite).test([] {
+        auto targets = make_test_targets<T>(3);
+        auto sources = make_test_targets<T>(11);
+        for (std::size_t i = 0; i < k_test_size; i += 3) {
+            auto bad = i % 2 ? std::numeric_limits<T>::infinity()
+                             : std::numeric_limits<T>::quiet_NaN();
+            targets.set(i, Vec(bad, targets[i].y));
+        }
+        Array first, second, flat_first, flat_second;
+        Vec acc(T(1), T(9.8));
+        auto count = find_velocities_to_target
+            (sources, targets, acc, T(7), first, second);
+        auto flat_count = find_velocities_to_target
+            (sources, targets, Vec(), T(7), flat_first, flat_second);
+        return ts::test(
+               matches_scalar(sources, targets, acc, T(7), first, second, count)
+            && matches_scalar(sources, targets, Vec(), T(7), flat_first, flat_second, flat_count));
+    });
+    // out of reach
+    mark(suite).test([] {
+        Array targets, first, second;
+        targets.push_back(Vec(T(100), T(0)));
+        auto count = find_velocities_to_target
+            (Vec(), targets, Vec(T(0), T(10)), T(1), first, second);
+        return ts::test(count == 0 && !is_real(first[0]) && !is_real(second[0]));
+    });
+    // non real targets have no solution
+    mark(suite).test([] {
+        Array targets, first, second;
+        for (int i = 0; i != 9; ++i)
+            targets.push_back(Vec(T(1), T(1)));
+        targets.set(4, get_no_solution_sentinel<Vec>());
+        auto count = find_velocities_to_target
+            (Vec(), targets, Vec(T(0), T(10)), T(10), first, second);
+        return ts::test(count == 8 && !is_real(first[4]) && is_real(first[3]));
+    });
+    mark(suite).test([] {
+        Array sources, targets, first, second;
+        sources.push_back(Vec());
+        try {
+            find_velocities_to_target
+                (sources, targets, Vec(T(0), T(1)), T(1), first, second);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    mark(suite).test([] {
+        Array targets, first, second;
+        try {
+            find_velocities_to_target
+                (Vec(), targets, get_no_solution_sentinel<Vec>(), T(1), first, second);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only();
+}
+
+} // end of <anonymous> namespace
@@ -0,0 +1,253 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/FrameArena.hpp>
+#include <common/Grid.hpp>
+#include <common/ThreadPool.hpp>
+#include <common/TestSuite.hpp>
+
+#include <vector>
+#include <string>
+#include <new>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <limits>
+
+#include <cstdlib>
+#include <cstdint>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+// counts every trip to the global heap, so that "zero heap calls" can
+// actually be tested
+std::atomic<int> s_global_news = 0;
+
+using namespace cul;
+
+bool run_frame_arena_tests();
+bool run_local_arena_tests();
+bool run_container_tests();
+
+} // end of <anonymous> namespace
+
+void * operator new(std::size_t n) {
+    ++s_global_news;
+    if (void * rv = std::malloc(n ? n : 1)) return rv;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    auto test_list = {
+        run_frame_arena_tests,
+        run_local_arena_tests,
+        run_container_tests
+    };
+
+    bool all_good = true;
+    for (auto f : test_list) {
+        if (!f()) all_good = false;
+    }
+
+    return all_good ? 0 : ~0;
+}
+
+namespace {
+
+bool is_aligned(const void * ptr, std::size_t alignment)
+    { return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0; }
+
+bool run_frame_arena_tests() {
+    ts::TestSuite suite("FrameArena");
+    suite.hide_successes();
+    mark(suite).test([] {
+        FrameArena arena(1024);
+        auto * a = arena.allocate(3, 1);
+        auto * b = arena.allocate(8, 8);
+        auto * c = arena.allocate(64, 64);
+        return ts::test(   a != b && is_aligned(b, 8) && is_aligned(c, 64)
+                        && arena.bytes_in_use() >= 3 + 8 + 64);
+    });
+    // reset hands out the same memory again
+    mark(suite).test([] {
+        FrameArena arena(1024);
+        auto * a = arena.allocate(100, 4);
+        arena.reset();
+        auto * b = arena.allocate(100, 4);
+        return ts::test(a == b && arena.bytes_in_use() == 100);
+    });
+    // the last allocation can be given back
+    mark(suite).test([] {
+        FrameArena arena(1024);
+        auto * a = arena.allocate(16, 8);
+        auto * b = arena.allocate(32, 8);
+        arena.deallocate(b, 32, 8);
+        auto * c = arena.allocate(32, 8);
+        return ts::test(a != c && b == c);
+    });
+    // growing, then coalescing on reset
+    mark(suite).test([] {
+        FrameArena arena(256);
+        for (int i = 0; i != 10; ++i) (void)arena.allocate(200, 8);
+        auto grown_blocks = arena.block_count();
+        auto capacity = arena.capacity();
+        arena.reset();
+        for (int i = 0; i != 10; ++i) (void)arena.allocate(200, 8);
+        return ts::test(   grown_blocks > 1 && capacity >= 2000
+                        && arena.block_count() == 1);
+    });
+    mark(suite).test([] {
+        FrameArena arena(2048);
+        auto * p = arena.allocate(4096, 256);
+        return ts::test(is_aligned(p, 256) && arena.block_count() == 2);
+    });
+    mark(suite).test([] {
+        FrameArena arena(256, false);
+        (void)arena.allocate(200, 8);
+        try {
+            (void)arena.allocate(200, 8);
+        } catch (std::bad_alloc &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    // requests too large to fit fail, rather than wrapping around
+    mark(suite).test([] {
+        constexpr const auto k_huge = std::numeric_limits<std::size_t>::max() - 8;
+        FrameArena fixed(256, false), growing(256);
+        (void)fixed.allocate(8, 8);
+        bool fixed_threw = false, growing_threw = false;
+        try {
+            (void)fixed.allocate(k_huge, 8);
+        } catch (std::bad_alloc &) {
+            fixed_threw = true;
+        }
+        try {
+            (void)growing.allocate(k_huge, 256);
+        } catch (std::bad_alloc &) {
+            growing_threw = true;
+        }
+        return ts::test(fixed_threw && growing_threw);
+    });
+#   ifndef NDEBUG
+    // what was handed out is poisoned on reset
+    mark(suite).test([] {
+        FrameArena arena(1024);
+        auto * bytes = static_cast<unsigned char *>(arena.allocate(16, 8));
+        for (int i = 0; i != 16; ++i) bytes[i] = 0;
+        arena.reset();
+        bool all_poisoned = true;
+        for (int i = 0; i != 16; ++i)
+            { all_poisoned = all_poisoned && bytes[i] == FrameArena::k_poison_byte; }
+        return ts::test(all_poisoned);
+    });
+#   endif
+    mark(suite).test([] {
+        FrameArena a, b;
+        return ts::test(a.is_equal(a) && !a.is_equal(b));
+    });
+    return suite.has_successes_only();
+}
+
+bool run_local_arena_tests() {
+    ts::TestSuite suite("FrameArena::local_arena");
+    suite.hide_successes();
+    mark(suite).test([] {
+        FrameArena arena;
+        auto & local = arena.local_arena();
+        return ts::test(&local != &arena && &local == &arena.local_arena());
+    });
+    mark(suite).test([] {
+        ThreadPool pool(4);
+        FrameArena arena(4096);
+        std::mutex mtx;
+        std::set<FrameArena *> locals;
+        bool all_good = true;
+        for (int frame = 0; frame != 3; ++frame) {
+            parallel_for(pool, 0, 2000, 16, [&](int i) {
+                auto & local = arena.local_arena();
+                auto * ints = static_cast<int *>(local.allocate(sizeof(int)*8, alignof(int)));
+                for (int j = 0; j != 8; ++j) ints[j] = i;
+                bool good = true;
+                for (int j = 0; j != 8; ++j) good = good && ints[j] == i;
+                std::lock_guard lock(mtx);
+                locals.insert(&local);
+                all_good = all_good && good;
+            });
+            arena.reset();
+        }
+        return ts::test(all_good && locals.size() <= 5);
+    });
+    return suite.has_successes_only();
+}
+
+bool run_container_tests() {
+    ts::TestSuite suite("FrameArena with containers");
+    suite.hide_successes();
+    mark(suite).test([] {
+        FrameArena arena;
+        pmr::Grid<int> grid(&arena);
+        grid.set_size(10, 12, 7);
+        grid(3, 4) = 2;
+        return ts::test(   grid.get_allocator().resource() == &arena
+                        && grid(3, 4) == 2 && grid(9, 11) == 7
+                        && arena.bytes_in_use() >= sizeof(int)*10*12);
+    });
+    mark(suite).test([] {
+        FrameArena arena;
+        pmr::Grid<char> grid({ { 'a', 'b' }, { 'c', 'd' } }, &arena);
+        return ts::test(grid.width() == 2 && grid.height() == 2 && grid(1, 1) == 'd');
+    });
+    // steady state frames should not touch the global heap at all
+    mark(suite).test([] {
+        FrameArena arena(4096);
+        auto do_frame = [&arena] {
+            {
+            std::pmr::vector<int> ints(&arena);
+            for (int i = 0; i != 1000; ++i) ints.push_back(i);
+            pmr::Grid<int> grid(&arena);
+            grid.set_size(20, 20);
+            std::pmr::string str("a string too long for short string optimization", &arena);
+            str += str;
+            }
+            arena.reset();
+        };
+        do_frame();
+        do_frame();
+        auto news_before = s_global_news.load();
+        for (int i = 0; i != 10; ++i) do_frame();
+        return ts::test(s_global_news.load() == news_before);
+    });
+    return suite.has_successes_only();
+}
+
+} // end of <anonymous> namespace
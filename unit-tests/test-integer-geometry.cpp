@@ -0,0 +1,133 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Vector2Util.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+#include <limits>
+#include <cstdint>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using VecI = Vector2<int>;
+using VecL = Vector2<std::int64_t>;
+using VecD = Vector2<double>;
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("integer geometry");
+    suite.hide_successes();
+    mark(suite).test([] {
+        return ts::test(   orientation_of(VecI(0, 0), VecI(4, 0), VecI(1,  1)) ==  1
+                        && orientation_of(VecI(0, 0), VecI(4, 0), VecI(1, -1)) == -1
+                        && orientation_of(VecI(0, 0), VecI(4, 0), VecI(9,  0)) ==  0);
+    });
+    // far beyond what doubles can tell apart
+    mark(suite).test([] {
+        const std::int64_t big = std::int64_t(1) << 60;
+        VecL a(-big, -big), b(big, big - 2);
+        return ts::test(   orientation_of(a, b, VecL(0, -1)) ==  0
+                        && orientation_of(a, b, VecL(0,  0)) ==  1
+                        && orientation_of(a, b, VecL(0, -2)) == -1);
+    });
+    mark(suite).test([] {
+        const int k = 2000000000;
+        return ts::test(   orientation_of(VecI(-k, -k), VecI(k, k), VecI(k - 1, k - 1)) == 0
+                        && orientation_of(VecI(-k, -k), VecI(k, k), VecI(k - 1, k)) == 1);
+    });
+    mark(suite).test([] {
+        VecI a(0, 0), b(4, 0), c(0, 4);
+        return ts::test(   incircle_of(a, b, c, VecI(1, 1)) ==  1
+                        && incircle_of(a, b, c, VecI(4, 4)) ==  0
+                        && incircle_of(a, b, c, VecI(5, 5)) == -1
+                        && incircle_of(a, c, b, VecI(1, 1)) == -1);
+    });
+    // lifts times crosses overflow even 128 bits, for these extremes
+    mark(suite).test([] {
+        const int lo = std::numeric_limits<int>::min(), hi = std::numeric_limits<int>::max();
+        VecI a(lo, lo), b(hi, lo), c(hi, hi);
+        return ts::test(   incircle_of(a, b, c, VecI(lo    , hi    )) ==  0
+                        && incircle_of(a, b, c, VecI(lo + 1, hi    )) ==  1
+                        && incircle_of(a, b, c, VecI(0     , 0     )) ==  1
+                        && incircle_of(a, c, b, VecI(lo    , hi - 1)) == -1
+                        && incircle_of(a, VecI(lo + 2, lo), VecI(lo, lo + 2), c) == -1);
+    });
+    mark(suite).test([] {
+        const std::int64_t big = std::int64_t(1) << 61;
+        VecL a(-big, -big), b(big, -big), c(big, big);
+        return ts::test(   incircle_of(a, b, c, VecL(-big    , big    )) ==  0
+                        && incircle_of(a, b, c, VecL(-big + 1, big    )) ==  1
+                        && incircle_of(a, b, c, VecL(-big    , big + 1)) == -1
+                        && incircle_of(a, VecL(-big + 2, -big), VecL(-big, -big + 2), c) == -1);
+    });
+    mark(suite).test([] {
+        auto p = find_intersection(VecI(0, 0), VecI(10, 10), VecI(0, 10), VecI(10, 0));
+        auto q = find_intersection(VecI(0, 0), VecI(3, 1), VecI(0, 1), VecI(3, 0));
+        return ts::test(p == VecI(5, 5) && q == VecI(2, 1));
+    });
+    // touching counts, parallel and collinear do not
+    mark(suite).test([] {
+        return ts::test(   do_segments_intersect(VecI(0, 0), VecI(4, 4), VecI(4, 4), VecI(8, 0))
+                        && !do_segments_intersect(VecI(0, 0), VecI(4, 4), VecI(1, 0), VecI(5, 4))
+                        && !do_segments_intersect(VecI(0, 0), VecI(4, 4), VecI(2, 2), VecI(6, 6))
+                        && find_intersection(VecI(0, 0), VecI(1, 1), VecI(100, 1), VecI(101, 0))
+                           == get_no_solution_sentinel<VecI>());
+    });
+    // same as floating point (rounded) where floating point is exact
+    mark(suite).test([] {
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<int> pos(-1000, 1000);
+        bool all_good = true;
+        for (int i = 0; i != 2000; ++i) {
+            VecI a(pos(rng), pos(rng)), b(pos(rng), pos(rng));
+            VecI c(pos(rng), pos(rng)), d(pos(rng), pos(rng));
+            auto pi = find_intersection(a, b, c, d);
+            auto pd = find_intersection(VecD(a), VecD(b), VecD(c), VecD(d));
+            if (is_real(pd) != (pi != get_no_solution_sentinel<VecI>())) {
+                // only differs for floating point rounding at the very ends
+                all_good &= do_segments_intersect(a, b, c, d) == (pi != get_no_solution_sentinel<VecI>());
+                continue;
+            }
+            if (!is_real(pd)) continue;
+            all_good &= magnitude(pd.x - pi.x) <= 0.5 + 1e-9 && magnitude(pd.y - pi.y) <= 0.5 + 1e-9;
+        }
+        return ts::test(all_good);
+    });
+    // large coordinates do not overflow
+    mark(suite).test([] {
+        const std::int64_t big = std::int64_t(1) << 60;
+        auto p = find_intersection(VecL(-big, -big), VecL(big, big), VecL(-big, big), VecL(big, -big));
+        // meets at x = y = big / (2*big - 1), just over a half
+        auto q = find_intersection(VecL(-big, 0), VecL(big, 1), VecL(0, -big), VecL(1, big));
+        return ts::test(p == VecL(0, 0) && q == VecL(1, 1));
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
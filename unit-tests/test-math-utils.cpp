@@ -1,5 +1,7 @@
 #include <common/Util.hpp>
 #include <common/Vector2Util.hpp>
+#include <common/Fixed.hpp>
+#include <common/FastMath.hpp>
 
 #include <vector>
 #include <set>
@@ -13,6 +15,11 @@ inline void verify(bool b) { assert(b); }
 // ... but... how is this good at tests then?
 
 static void test_v2();
+static void test_fixed();
+static void test_fast_math();
+static void test_unchecked();
+static void test_constexpr();
+static void test_integer_rotation();
 
 int main() {
     // purpose: just make sure it compiles!
@@ -68,6 +75,11 @@ int main() {
     cul::find_lowest_true<double>([](double x) { return x > k_chosen_const; });
     // Vector2 header
     test_v2();
+    test_fixed();
+    test_fast_math();
+    test_unchecked();
+    test_constexpr();
+    test_integer_rotation();
 }
 
 static void test_v2() {
@@ -119,3 +131,191 @@ static void test_v2() {
     [](SizeI) {}(szi);
     [](SizeD) {}(SizeD(szi));
 }
+
+static void test_fixed() {
+    using namespace cul;
+    using FixedT  = Fixed<16, 16>;
+    using VectorX = Vector2<FixedT>;
+    static constexpr const double k_ulp = 1. / 65536.;
+
+    assert(FixedT(7) / FixedT(-2) == FixedT(-3.5));
+    assert(FixedT(1.5)*FixedT(-2) == FixedT(-3));
+    assert(int(FixedT(-2.75)) == -2);
+    assert(sqrt(FixedT(16)) == FixedT(4));
+    for (double t = -10.; t < 10.; t += 0.01) {
+        auto x = FixedT(t);
+        assert(std::abs(double(sin(x)) - std::sin(double(x))) <= k_ulp);
+        assert(std::abs(double(cos(x)) - std::cos(double(x))) <= k_ulp);
+        assert(std::abs(double(atan2(x, FixedT(3))) - std::atan2(double(x), 3.)) <= k_ulp);
+    }
+
+    // overflow wraps like the underlying integer would, rather than being
+    // undefined
+    using RawLimits = std::numeric_limits<FixedT::Raw>;
+    const auto raw_max = FixedT::from_raw(RawLimits::max());
+    const auto raw_min = FixedT::from_raw(RawLimits::min());
+    const auto raw_one = FixedT::from_raw(1);
+    assert(raw_max + raw_one == raw_min);
+    assert(raw_min - raw_one == raw_max);
+    assert(-raw_min == raw_min);
+    FixedT acc = raw_max;
+    acc += raw_one;
+    assert(acc == raw_min);
+    acc -= raw_one;
+    assert(acc == raw_max);
+    assert(FixedT(32768) == raw_min);
+    // out of range floats saturate, and NaN is zero
+    assert(FixedT(1e12) == raw_max && FixedT(-1e12) == raw_min);
+    assert(FixedT(std::numeric_limits<float>::infinity()) == raw_max);
+    assert(FixedT(std::numeric_limits<double>::quiet_NaN()) == FixedT(0));
+
+    assert(magnitude(VectorX(3, 4)) == FixedT(5));
+    [[maybe_unused]] VectorX vx = normalize(VectorX(3, 4));
+    vx = rotate_vector(VectorX(1, 0), k_pi_for_type<FixedT>*0.5);
+    assert(are_within(vx, VectorX(0, 1), FixedT(0.0005)));
+    assert(are_within(angle_between(VectorX(1, 0), VectorX(0, 1)),
+                      k_pi_for_type<FixedT>*0.5, FixedT(0.0005)));
+    vx = find_intersection(VectorX(0, 0), VectorX(1, 1), VectorX(0, 1), VectorX(1, 0));
+    assert(vx == VectorX(0.5, 0.5));
+    vx = find_closest_point_to_line(VectorX(5, 4), VectorX(10, 12), VectorX(7, 5));
+    assert(is_inside_triangle(VectorX(0, 0), VectorX(4, 0), VectorX(0, 4), VectorX(1, 1)));
+}
+
+static void test_fast_math() {
+    using namespace cul;
+    using VectorD = Vector2<double>;
+    using FixedT  = Fixed<16, 16>;
+    static constexpr const double k_pi_d = k_pi_for_type<double>;
+
+    for (double t = -1000.; t < 1000.; t += 0.0173) {
+        auto [s, c] = fast::sincos(t);
+        assert(std::abs(s - std::sin(t)) <= 1e-7);
+        assert(std::abs(c - std::cos(t)) <= 1e-7);
+        assert(std::abs(fast::atan(t) - std::atan(t)) <= 2e-8);
+    }
+    for (double y = -5.; y < 5.; y += 0.0731) {
+        for (double x = -5.; x < 5.; x += 0.0917)
+            { assert(std::abs(fast::atan2(y, x) - std::atan2(y, x)) <= 2e-8); }
+    }
+    for (double x = -1.; x <= 1.; x += 0.0001)
+        { assert(std::abs(fast::acos(x) - std::acos(x)) <= 5e-8); }
+    assert(fast::atan2(0., 0.) == 0.);
+    assert(fast::atan2(0., -1.) == k_pi_d);
+    // non real (and huge) arguments are well defined, not just imprecise
+    {
+    auto [nan_s, nan_c] = fast::sincos(std::numeric_limits<double>::quiet_NaN());
+    auto [inf_s, inf_c] = fast::sincos(std::numeric_limits<float>::infinity());
+    auto [huge_s, huge_c] = fast::sincos(1e300);
+    assert(std::isnan(nan_s) && std::isnan(nan_c));
+    assert(std::isnan(inf_s) && std::isnan(inf_c));
+    (void)huge_s; (void)huge_c;
+    }
+
+    // policies can be picked per call
+    auto vd = rotate_vector<VectorD, FastMath>(VectorD(1, 0), k_pi_d*0.5);
+    assert(are_within(vd, VectorD(0, 1), 1e-7));
+    assert(are_within(angle_between<VectorD, FastMath>(VectorD(1, 0), VectorD(0, 1)),
+                      k_pi_d*0.5, 1e-7));
+    assert(are_within(directed_angle_between<VectorD, FastMath>(VectorD(1, 0), VectorD(0, 1)),
+                      -k_pi_d*0.5, 1e-7));
+    // ...falling back to precise functions for types fast doesn't cover
+    assert(FastMath::sin(FixedT(1)) == sin(FixedT(1)));
+}
+
+static void test_unchecked() {
+    using namespace cul;
+    using VectorD = Vector2<double>;
+    using VectorF = Vector2<float>;
+    static constexpr const double k_pi_d = k_pi_for_type<double>;
+    // same results as the checked versions, for valid input
+    VectorD a(3.5, -1.25), b(-0.5, 7.), c(2., 2.), d(0.1, -4.);
+    static_assert(noexcept(unchecked::normalize(a)));
+    static_assert(noexcept(unchecked::find_intersection(a, b, c, d)));
+    assert(unchecked::magnitude(a) == magnitude(a));
+    assert(unchecked::normalize(a) == normalize(a));
+    assert(unchecked::rotate_vector(a, 0.3) == rotate_vector(a, 0.3));
+    assert(are_within(unchecked::angle_between(a, b), angle_between(a, b), 1e-12));
+    assert(unchecked::directed_angle_between(a, b) == directed_angle_between(a, b));
+    assert(are_within(unchecked::project_onto(a, b), project_onto(a, b), 1e-12));
+    assert(are_within(unchecked::find_intersection(a, b, c, d),
+                      find_intersection(a, b, c, d), 1e-12));
+    assert(unchecked::find_closest_point_to_line(a, b, c)
+           == find_closest_point_to_line(a, b, c));
+    assert(unchecked::are_within(a, a + VectorD(0.3, 0.4), 0.5));
+    assert(!unchecked::are_within(a, a + VectorD(0.3, 0.4), 0.49));
+    assert(!unchecked::are_within(a, a, -1.));
+
+    // no intersection, including parallel and collinear lines
+    assert(!is_real(unchecked::find_intersection(
+        VectorD(0, 0), VectorD(1, 1), VectorD(100, 1), VectorD(101, 0))));
+    assert(!is_real(unchecked::find_intersection(
+        VectorD(0, 0), VectorD(1, 1), VectorD(0, 1), VectorD(1, 2))));
+    assert(!is_real(unchecked::find_intersection(
+        VectorD(0, 0), VectorD(2, 2), VectorD(1, 1), VectorD(3, 3))));
+    assert(unchecked::find_intersection(
+        VectorF(0, 0), VectorF(1, 1), VectorF(0, 1), VectorF(1, 0)) == VectorF(0.5f, 0.5f));
+
+    assert(are_within(unchecked::angle_between<VectorD, FastMath>(VectorD(1, 0), VectorD(0, 3)),
+                      k_pi_d*0.5, 1e-7));
+    assert(unchecked::find_closest_point_to_line(VectorD(1, 1), VectorD(1, 1), c) == VectorD(1, 1));
+
+    // tiny and huge (but valid) vectors, whose squared magnitudes multiplied
+    // together would underflow or overflow
+    static constexpr const float k_pi_f = k_pi_for_type<float>;
+    VectorF tiny_x(1e-12f, 0.f), tiny_y(0.f, 1e-12f);
+    VectorF huge_x(1e+12f, 0.f), huge_y(0.f, 1e+12f);
+    assert(are_within(unchecked::angle_between(tiny_x, tiny_y),
+                      angle_between(tiny_x, tiny_y), 1e-6f));
+    assert(are_within(unchecked::angle_between(tiny_x, tiny_y), k_pi_f*0.5f, 1e-6f));
+    assert(are_within(unchecked::angle_between(huge_x, huge_y), k_pi_f*0.5f, 1e-6f));
+}
+
+static void test_constexpr() {
+    using namespace cul;
+    using VectorI = Vector2<int>;
+    using RectI   = Rectangle<int>;
+    using FixedT  = Fixed<16, 16>;
+    // tables like these should be built entirely at compile time
+    static constexpr const VectorI k_offsets[] = {
+        VectorI(1, 0) + VectorI(0, 1), -VectorI(2, 3), VectorI(4, 6) / 2,
+        3*VectorI(1, -1) - VectorI(1, 1)
+    };
+    static_assert(k_offsets[0] == VectorI(1, 1) && k_offsets[1] == VectorI(-2, -3));
+    static_assert(k_offsets[2] == VectorI(2, 3) && k_offsets[3] != VectorI(2, -3));
+    static_assert(convert_to<Size2<int>>(k_offsets[3]).height == -4);
+
+    static constexpr const RectI k_frame(0, 0, 10, 8);
+    static constexpr const auto k_inner = compose(VectorI(2, 2), Size2<int>(4, 4));
+    static_assert(right_of(k_frame) == 10 && bottom_of(k_frame) == 8);
+    static_assert(center_of(k_inner) == VectorI(4, 4));
+    static_assert(overlaps(k_frame, k_inner) && !overlaps(k_inner, RectI(6, 6, 2, 2)));
+    static_assert(find_rectangle_intersection(k_frame, RectI(8, 6, 4, 4)) == RectI(8, 6, 2, 2));
+    static_assert(area_of(k_inner) == 16 && size_of(k_inner) == Size2<int>(4, 4));
+    static_assert(is_contained_in(VectorI(9, 7), k_frame));
+    static_assert(dot(VectorI(2, 3), VectorI(4, 5)) == 23);
+    static_assert(cross(VectorI(1, 0), VectorI(0, 1)) == 1);
+
+    // noexcept follows the scalar's own operators
+    VectorI a(1, 2);
+    FixedT two(2);
+    Vector2<FixedT> f(FixedT(1), two);
+    static_assert(noexcept(a + a) && noexcept(a / 2) && noexcept(a == a));
+    static_assert(noexcept(f + f) && noexcept(f*two));
+    // fixed point division throws on zero
+    static_assert(!noexcept(f / two));
+    assert(a + a == VectorI(2, 4));
+}
+
+static void test_integer_rotation() {
+    using namespace cul;
+    using VectorI = Vector2<int>;
+    // trig is done in floating point, and only the results are truncated
+    // (10*cos(1) ~ 5.4, 10*sin(1) ~ 8.4)
+    assert(rotate_vector(VectorI(10, 0), 1) == VectorI(5, 8));
+    assert((rotate_vector<VectorI, FastMath>(VectorI(10, 0), 1) == VectorI(5, 8)));
+    assert(unchecked::rotate_vector(VectorI(10, 0), 1) == VectorI(5, 8));
+    assert(rotate_vector(VectorI(0, 100), 3) == VectorI(-14, -98));
+    // angles between integer vectors come back whole, but are no longer
+    // computed from whole number trig
+    assert(unchecked::angle_between(VectorI(3, 0), VectorI(0, 3)) == 1);
+}
@@ -0,0 +1,190 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Metrics.hpp>
+#include <common/Grid.hpp>
+#include <common/StringUtil.hpp>
+#include <common/TestSuite.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+
+bool run_counter_tests();
+bool run_histogram_tests();
+bool run_registry_tests();
+
+} // end of <anonymous> namespace
+
+int main() {
+    auto test_list = {
+        run_counter_tests,
+        run_histogram_tests,
+        run_registry_tests
+    };
+
+    bool all_good = true;
+    for (auto f : test_list) {
+        if (!f()) all_good = false;
+    }
+
+    return all_good ? 0 : ~0;
+}
+
+namespace {
+
+bool run_counter_tests() {
+    ts::TestSuite suite("Counter");
+    suite.hide_successes();
+    mark(suite).test([] {
+        Counter counter;
+        counter.add();
+        counter.add(4);
+        return ts::test(counter.value() == 5);
+    });
+    mark(suite).test([] {
+        static constexpr const int k_per_thread = 100000;
+        Counter counter;
+        std::vector<std::thread> threads;
+        for (int i = 0; i != 8; ++i) {
+            threads.emplace_back([&counter] {
+                for (int j = 0; j != k_per_thread; ++j) counter.add();
+            });
+        }
+        for (auto & thd : threads) thd.join();
+        return ts::test(counter.value() == 8*k_per_thread);
+    });
+    mark(suite).test([] {
+        Counter counter;
+        counter.add(10);
+        counter.reset();
+        return ts::test(counter.value() == 0);
+    });
+    return suite.has_successes_only();
+}
+
+bool run_histogram_tests() {
+    ts::TestSuite suite("Histogram");
+    suite.hide_successes();
+    // small values are exact
+    mark(suite).test([] {
+        bool all_good = true;
+        for (std::uint64_t i = 0; i != Histogram::k_sub_bucket_count; ++i) {
+            auto bucket = Histogram::bucket_of(i);
+            all_good = all_good && Histogram::lowest_in_bucket (bucket) == i
+                                && Histogram::highest_in_bucket(bucket) == i;
+        }
+        return ts::test(all_good);
+    });
+    // every value lands in a bucket which contains it, and buckets are
+    // contiguous
+    mark(suite).test([] {
+        bool all_good = true;
+        for (int bucket = 0; bucket + 1 < Histogram::k_bucket_count; ++bucket) {
+            all_good = all_good &&   Histogram::highest_in_bucket(bucket) + 1
+                                  == Histogram::lowest_in_bucket(bucket + 1);
+        }
+        for (std::uint64_t value : { 16ull, 17ull, 1000ull, 123456789ull, ~0ull }) {
+            auto bucket = Histogram::bucket_of(value);
+            all_good = all_good && Histogram::lowest_in_bucket (bucket) <= value
+                                && Histogram::highest_in_bucket(bucket) >= value;
+        }
+        return ts::test(all_good && Histogram::bucket_of(~0ull) == Histogram::k_bucket_count - 1);
+    });
+    mark(suite).test([] {
+        Histogram hist;
+        for (std::uint64_t i = 1; i <= 1000; ++i) hist.record(i);
+        auto p50 = hist.value_at(0.5);
+        auto p99 = hist.value_at(0.99);
+        return ts::test(   hist.count() == 1000 && hist.max() == 1000
+                        && hist.sum() == 500500
+                        && p50 >= 500 && p50 <= 532 && p99 >= 990 && p99 <= 1000);
+    });
+    mark(suite).test([] {
+        Histogram hist;
+        return ts::test(hist.value_at(0.5) == 0 && hist.count() == 0);
+    });
+    return suite.has_successes_only();
+}
+
+bool run_registry_tests() {
+    ts::TestSuite suite("MetricsRegistry");
+    suite.hide_successes();
+    mark(suite).test([] {
+        auto & registry = MetricsRegistry::instance();
+        auto & a = registry.counter("test.a");
+        a.add(3);
+        return ts::test(&a == &registry.counter("test.a") && a.value() == 3);
+    });
+    mark(suite).test([] {
+        auto & registry = MetricsRegistry::instance();
+        registry.histogram("test.latency").record(100);
+        registry.counter("test.b").add(7);
+        auto snapshot = registry.snapshot();
+        std::stringstream text, json;
+        write_text(text, snapshot);
+        write_json(json, snapshot);
+        return ts::test(   text.str().find("test.b 7\n") != std::string::npos
+                        && json.str().find("\"test.b\":7") != std::string::npos
+                        && json.str().find("\"test.latency\":{\"count\":1") != std::string::npos
+                        && std::is_sorted(snapshot.counters.begin(), snapshot.counters.end()));
+    });
+    // the library's hot paths report to the builtin metrics
+    mark(suite).test([] {
+        MetricsRegistry::instance().reset();
+        auto & builtins = builtin_metrics();
+        Grid<int> grid;
+        grid.set_size(10, 10);
+        grid.set_size(5, 5);
+        try {
+            (void)grid(100, 100);
+        } catch (...) {}
+        int out = 0;
+        (void)string_to_number(std::string("12z"), out);
+        (void)string_to_number(std::string("12"), out);
+        return ts::test(   builtins.grid_resizes.value() == 2
+                        && builtins.grid_allocations.value() == 1
+                        && builtins.bounds_check_throws.value() == 1
+                        && builtins.string_to_number_failures.value() == 1);
+    });
+    mark(suite).test([] {
+        auto & registry = MetricsRegistry::instance();
+        registry.counter("test.c").add(1);
+        registry.reset();
+        return ts::test(registry.counter("test.c").value() == 0);
+    });
+    return suite.has_successes_only();
+}
+
+} // end of <anonymous> namespace
@@ -0,0 +1,185 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/NearestSegment.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec     = Vector2<double>;
+using Segment = LineSegment<double>;
+
+std::vector<Segment> make_random_segments(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> pos(-100., 100.);
+    std::uniform_real_distribution<double> len(-5., 5.);
+    std::vector<Segment> rv;
+    for (std::size_t i = 0; i != count; ++i) {
+        Vec a(pos(rng), pos(rng));
+        rv.emplace_back(a, a + Vec(len(rng), len(rng)));
+    }
+    return rv;
+}
+
+// nearest distance, using the one at a time function
+double brute_force_distance
+    (const Vec & point, const std::vector<Segment> & segments)
+{
+    double rv = std::numeric_limits<double>::infinity();
+    for (const auto & seg : segments) {
+        auto d = find_closest_point_to_line(seg.a, seg.b, point) - point;
+        rv = std::min(rv, dot(d, d));
+    }
+    return rv;
+}
+
+bool is_consistent
+    (const NearestSegment<double> & res, const Vec & point,
+     const std::vector<Segment> & segments)
+{
+    if (res.index >= segments.size()) return false;
+    const auto & seg = segments[res.index];
+    auto expected = find_closest_point_to_line(seg.a, seg.b, point);
+    auto d = res.point - point;
+    return are_within(res.point, expected, 0.000001)
+        && are_within(res.distance_squared, dot(d, d), 0.000001)
+        && are_within(res.distance_squared, brute_force_distance(point, segments), 0.000001);
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("nearest_segment");
+    suite.hide_successes();
+    // closest points clamp to extreme points
+    mark(suite).test([] {
+        return ts::test(
+               find_closest_point_to_line(Vec(0, 0), Vec(4, 0), Vec(-2, 3)) == Vec(0, 0)
+            && find_closest_point_to_line(Vec(0, 0), Vec(4, 0), Vec(6, -3)) == Vec(4, 0)
+            && find_closest_point_to_line(Vec(0, 0), Vec(4, 0), Vec(1, 3)) == Vec(1, 0)
+            && find_closest_point_to_line(Vec(2, 2), Vec(2, 2), Vec(1, 3)) == Vec(2, 2));
+    });
+    mark(suite).test([] {
+        try {
+            find_closest_point_to_line(Vec(), Vec(1, 1), get_no_solution_sentinel<Vec>());
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    mark(suite).test([] {
+        std::vector<Segment> segments;
+        segments.emplace_back(Vec(0, 0), Vec(10, 0));
+        segments.emplace_back(Vec(0, 5), Vec(10, 5));
+        segments.emplace_back(Vec(0, 4), Vec(10, 4));
+        auto res = nearest_segment(Vec(3, 3.), segments);
+        return ts::test(res.index == 2 && res.point == Vec(3, 4)
+                        && are_within(res.distance_squared, 1., 0.000001));
+    });
+    // ties go to the lowest index
+    mark(suite).test([] {
+        std::vector<Segment> segments;
+        segments.emplace_back(Vec(0, 2), Vec(10, 2));
+        segments.emplace_back(Vec(0, -2), Vec(10, -2));
+        return ts::test(nearest_segment(Vec(5, 0), segments).index == 0);
+    });
+    mark(suite).test([] {
+        std::vector<Segment> segments;
+        auto res = nearest_segment(Vec(), segments);
+        SegmentIndex<double> index(segments);
+        auto ires = nearest_segment(Vec(), index);
+        return ts::test(res.index == NearestSegment<double>::k_no_segment
+                        && ires.index == NearestSegment<double>::k_no_segment
+                        && !is_real(res.point));
+    });
+    // non real segments are skipped
+    mark(suite).test([] {
+        auto segments = make_random_segments(10, 3);
+        segments[4].a = get_no_solution_sentinel<Vec>();
+        auto res = nearest_segment(segments[4].b, segments);
+        return ts::test(res.index != 4 && res.index < segments.size());
+    });
+    // point segments
+    mark(suite).test([] {
+        std::vector<Segment> segments;
+        segments.emplace_back(Vec(1, 1), Vec(1, 1));
+        auto res = nearest_segment(Vec(4, 5), segments);
+        return ts::test(res.index == 0 && res.point == Vec(1, 1)
+                        && are_within(res.distance_squared, 25., 0.000001));
+    });
+    // several blocks, against brute force
+    mark(suite).test([] {
+        auto segments = make_random_segments(517, 7);
+        bool all_good = true;
+        for (int i = -10; i != 10; ++i) {
+            Vec point(i*11.3, i*-7.7);
+            all_good &= is_consistent(nearest_segment(point, segments), point, segments);
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        auto segments = make_random_segments(1025, 11);
+        SegmentIndex<double> index(segments);
+        bool all_good = index.size() == segments.size();
+        for (int i = -15; i != 15; ++i) {
+            Vec point(i*9.1, i*i*0.5 - 60.);
+            all_good &= is_consistent(nearest_segment(point, index), point, segments);
+        }
+        return ts::test(all_good);
+    });
+    // few enough for one leaf
+    mark(suite).test([] {
+        auto segments = make_random_segments(5, 13);
+        SegmentIndex<double> index(segments);
+        Vec point(1, 2);
+        return ts::test(is_consistent(index.find_nearest(point), point, segments));
+    });
+    mark(suite).test([] {
+        auto segments = make_random_segments(20, 17);
+        segments[3].b.x = std::numeric_limits<double>::quiet_NaN();
+        try {
+            SegmentIndex<double> index(segments);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    mark(suite).test([] {
+        auto segments = make_random_segments(20, 19);
+        try {
+            nearest_segment(get_no_solution_sentinel<Vec>(), segments);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
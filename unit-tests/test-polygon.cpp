@@ -0,0 +1,174 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Polygon.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+#include <vector>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec = Vector2<double>;
+
+const std::vector<Vec> k_square = { Vec(0, 0), Vec(2, 0), Vec(2, 2), Vec(0, 2) };
+
+// an "L" shape, clockwise
+const std::vector<Vec> k_l_shape =
+    { Vec(0, 0), Vec(0, 3), Vec(1, 3), Vec(1, 1), Vec(2, 1), Vec(2, 0) };
+
+template <typename T>
+const T * begin_of(const std::vector<T> & vec) { return vec.data(); }
+
+template <typename T>
+const T * end_of(const std::vector<T> & vec) { return vec.data() + vec.size(); }
+
+bool is_convex_and_counter_clockwise(const std::vector<Vec> & poly) {
+    for (std::size_t i = 0; i != poly.size(); ++i) {
+        const auto & a = poly[i];
+        const auto & b = poly[(i + 1) % poly.size()];
+        const auto & c = poly[(i + 2) % poly.size()];
+        if (cross(b - a, c - b) <= 0) return false;
+    }
+    return true;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("Polygons");
+    suite.hide_successes();
+    mark(suite).test([] {
+        return ts::test(   are_within(signed_area_of_polygon(begin_of(k_square), end_of(k_square)), 4., 1e-9)
+                        && are_within(signed_area_of_polygon(begin_of(k_l_shape), end_of(k_l_shape)), -4., 1e-9)
+                        && are_within(area_of_polygon(begin_of(k_l_shape), end_of(k_l_shape)), 4., 1e-9));
+    });
+    mark(suite).test([] {
+        auto square = centroid_of_polygon(begin_of(k_square), end_of(k_square));
+        auto l_shape = centroid_of_polygon(begin_of(k_l_shape), end_of(k_l_shape));
+        // pieces: [0,1]x[0,3] (area 3) and [1,2]x[0,1] (area 1)
+        Vec expected = (Vec(0.5, 1.5)*3. + Vec(1.5, 0.5)) * 0.25;
+        return ts::test(are_within(square, Vec(1, 1), 1e-9) && are_within(l_shape, expected, 1e-9));
+    });
+    mark(suite).test([] {
+        std::vector<Vec> line = { Vec(0, 0), Vec(1, 1), Vec(2, 2) };
+        return ts::test(   !is_real(centroid_of_polygon(begin_of(line), end_of(line)))
+                        && !is_real(centroid_of_polygon(begin_of(line), begin_of(line) + 2)));
+    });
+    mark(suite).test([] {
+        const auto * beg = begin_of(k_l_shape);
+        const auto * end = end_of(k_l_shape);
+        return ts::test(   winding_number_of(beg, end, Vec(0.5, 2.5)) == -1
+                        && is_inside_polygon(beg, end, Vec(1.5, 0.5))
+                        && !is_inside_polygon(beg, end, Vec(1.5, 1.5))
+                        && !is_inside_polygon(beg, end, Vec(-1, 0.5))
+                        && !is_inside_polygon(beg, beg, Vec()));
+    });
+    // a pentagram winds twice around its center
+    mark(suite).test([] {
+        std::vector<Vec> star;
+        for (int i = 0; i != 5; ++i) {
+            double t = k_pi_for_type<double>*0.8*i;
+            star.emplace_back(std::cos(t), std::sin(t));
+        }
+        return ts::test(   winding_number_of(begin_of(star), end_of(star), Vec()) == 2
+                        && winding_number_of(begin_of(star), end_of(star), Vec(0.7, 0)) == 1);
+    });
+    // batched results agree with one at a time
+    mark(suite).test([] {
+        std::default_random_engine rng { 3 };
+        std::uniform_real_distribution<double> dist(-0.5, 3.5);
+        std::vector<Vec> points;
+        for (int i = 0; i != 201; ++i) points.emplace_back(dist(rng), dist(rng));
+        // one more, which must not be written to
+        bool out[202];
+        out[201] = true;
+        auto * out_ptr = out;
+        auto count = is_inside_polygon(begin_of(k_l_shape), end_of(k_l_shape),
+                                       begin_of(points), end_of(points), out_ptr);
+        std::size_t expected_count = 0;
+        bool all_agree = true;
+        for (std::size_t i = 0; i != points.size(); ++i) {
+            bool inside = is_inside_polygon(begin_of(k_l_shape), end_of(k_l_shape), points[i]);
+            expected_count += inside ? 1 : 0;
+            all_agree = all_agree && out_ptr[i] == inside;
+        }
+        return ts::test(all_agree && count == expected_count && out[201]);
+    });
+    mark(suite).test([] {
+        std::vector<Vector2<int>> points = {
+            Vector2<int>(1, 1), Vector2<int>(0, 0), Vector2<int>(2, 0), Vector2<int>(1, 0),
+            Vector2<int>(2, 2), Vector2<int>(0, 2), Vector2<int>(0, 0), Vector2<int>(1, 2)
+        };
+        std::vector<Vector2<int>> hull(points.size());
+        auto count = find_convex_hull(points.data(), points.data() + points.size(), hull.data());
+        hull.resize(count);
+        return ts::test(hull == std::vector<Vector2<int>> {
+            Vector2<int>(0, 0), Vector2<int>(2, 0), Vector2<int>(2, 2), Vector2<int>(0, 2) });
+    });
+    mark(suite).test([] {
+        std::vector<Vec> points = { Vec(3, 3), Vec(1, 1), Vec(2, 2), Vec(1, 1) };
+        std::vector<Vec> one = { Vec(4, 5), Vec(4, 5) };
+        Vec hull[4];
+        auto count = find_convex_hull(points.data(), points.data() + points.size(), hull);
+        auto one_count = find_convex_hull(one.data(), one.data() + one.size(), hull + 2);
+        return ts::test(   count == 2 && hull[0] == Vec(1, 1) && hull[1] == Vec(3, 3)
+                        && one_count == 1 && hull[2] == Vec(4, 5)
+                        && find_convex_hull(one.data(), one.data(), hull) == 0);
+    });
+    // all points are inside or on the hull, in convex position (no more room
+    // than the number of points given is used)
+    mark(suite).test([] {
+        bool all_good = true;
+        for (unsigned seed = 0; seed != 20; ++seed) {
+            std::default_random_engine rng { seed };
+            std::uniform_real_distribution<double> dist(-10, 10);
+            std::vector<Vec> points;
+            for (int i = 0; i != 100; ++i) {
+                double t = dist(rng);
+                // some seeds are all on a circle
+                points.push_back(seed % 2 ? Vec(dist(rng), dist(rng)) : Vec(std::cos(t), std::sin(t)));
+            }
+            std::vector<Vec> hull(points.size() + 1, Vec(-100, -100));
+            auto count = find_convex_hull(points.data(), points.data() + points.size(), hull.data());
+            all_good = all_good && hull[points.size()] == Vec(-100, -100);
+            hull.resize(count);
+            all_good = all_good && is_convex_and_counter_clockwise(hull);
+            for (const auto & r : points) {
+                for (std::size_t i = 0; i != hull.size(); ++i) {
+                    const auto & a = hull[i];
+                    const auto & b = hull[(i + 1) % hull.size()];
+                    all_good = all_good && cross(b - a, r - a) >= -1e-9;
+                }
+            }
+        }
+        return ts::test(all_good);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
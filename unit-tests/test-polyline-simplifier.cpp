@@ -0,0 +1,202 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/PolylineSimplifier.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec = Vector2<double>;
+
+std::vector<Vec> make_random_walk(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> step(-1., 1.);
+    std::vector<Vec> rv;
+    Vec pos;
+    for (std::size_t i = 0; i != count; ++i) {
+        rv.push_back(pos);
+        pos += Vec(1. + step(rng), step(rng)*0.5);
+    }
+    return rv;
+}
+
+double distance_squared_to_polyline
+    (const Vec & point, const std::vector<Vec> & polyline)
+{
+    double rv = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 1; i < polyline.size(); ++i) {
+        auto d = find_closest_point_to_line(polyline[i - 1], polyline[i], point) - point;
+        rv = std::min(rv, dot(d, d));
+    }
+    return rv;
+}
+
+// kept points must appear in order, with the same ends
+bool is_subsequence_of
+    (const std::vector<Vec> & kept, const std::vector<Vec> & original)
+{
+    if (kept.empty() || kept.front() != original.front()
+        || kept.back() != original.back())
+    { return false; }
+    auto itr = original.begin();
+    for (const auto & pt : kept) {
+        itr = std::find(itr, original.end(), pt);
+        if (itr == original.end()) return false;
+        ++itr;
+    }
+    return true;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("PolylineSimplifier");
+    suite.hide_successes();
+    // collinear points reduce to their ends
+    mark(suite).test([] {
+        std::vector<Vec> line;
+        for (int i = 0; i != 10; ++i) line.emplace_back(i, i*0.5);
+        std::vector<Vec> dp, vw;
+        simplify_polyline(line, 0.01, dp);
+        simplify_polyline(line, 0.01, vw, k_visvalingam_whyatt);
+        std::vector<Vec> expected = { Vec(0, 0), Vec(9, 4.5) };
+        return ts::test(dp == expected && vw == expected);
+    });
+    // a corner survives, a wiggle does not
+    mark(suite).test([] {
+        std::vector<Vec> pts = {
+            Vec(0, 0), Vec(1, 0.001), Vec(2, 0), Vec(2, 1), Vec(2, 2)
+        };
+        std::vector<Vec> expected = { Vec(0, 0), Vec(2, 0), Vec(2, 2) };
+        std::vector<Vec> dp, vw;
+        simplify_polyline(pts, 0.01, dp);
+        simplify_polyline(pts, 0.01, vw, k_visvalingam_whyatt);
+        return ts::test(dp == expected && vw == expected);
+    });
+    // too few points to remove any
+    mark(suite).test([] {
+        std::vector<Vec> pts = { Vec(0, 0), Vec(1, 1) };
+        std::vector<Vec> out;
+        simplify_polyline(pts, 10., out);
+        std::vector<Vec> empty, empty_out;
+        simplify_polyline(empty, 10., empty_out, k_visvalingam_whyatt);
+        return ts::test(out == pts && empty_out.empty());
+    });
+    // Douglas–Peucker keeps every removed point within tolerance
+    mark(suite).test([] {
+        auto walk = make_random_walk(500, 3);
+        constexpr const double k_tolerance = 0.75;
+        std::vector<Vec> out;
+        simplify_polyline(walk, k_tolerance, out);
+        bool all_within = true;
+        for (const auto & pt : walk) {
+            all_within = all_within
+                && distance_squared_to_polyline(pt, out)
+                   <= k_tolerance*k_tolerance + 1e-9;
+        }
+        return ts::test(all_within && out.size() < walk.size()
+                        && is_subsequence_of(out, walk));
+    });
+    // Visvalingam–Whyatt leaves no triangle under tolerance
+    mark(suite).test([] {
+        auto walk = make_random_walk(500, 5);
+        constexpr const double k_tolerance = 0.5;
+        std::vector<Vec> out;
+        simplify_polyline(walk, k_tolerance, out, k_visvalingam_whyatt);
+        bool all_large = true;
+        for (std::size_t i = 1; i + 1 < out.size(); ++i) {
+            auto a = out[i - 1] - out[i];
+            auto b = out[i + 1] - out[i];
+            all_large = all_large
+                && magnitude(a.x*b.y - a.y*b.x)*0.5 > k_tolerance;
+        }
+        return ts::test(all_large && out.size() < walk.size()
+                        && is_subsequence_of(out, walk));
+    });
+    // in place, and with a reused simplifier
+    mark(suite).test([] {
+        PolylineSimplifier<double> simplifier;
+        simplifier.reserve(1000);
+        bool all_same = true;
+        for (unsigned seed = 0; seed != 5; ++seed) {
+            auto walk = make_random_walk(200 + seed*100, seed);
+            std::vector<Vec> fresh;
+            simplify_polyline(walk, 0.5, fresh);
+            simplifier.simplify(walk, 0.5, walk);
+            all_same = all_same && walk == fresh;
+        }
+        return ts::test(all_same);
+    });
+    // zero tolerance removes only exactly redundant points
+    mark(suite).test([] {
+        std::vector<Vec> pts = {
+            Vec(0, 0), Vec(1, 0), Vec(2, 0), Vec(2, 1), Vec(3, 2)
+        };
+        std::vector<Vec> expected = { Vec(0, 0), Vec(2, 0), Vec(2, 1), Vec(3, 2) };
+        std::vector<Vec> dp, vw;
+        simplify_polyline(pts, 0., dp);
+        simplify_polyline(pts, 0., vw, k_visvalingam_whyatt);
+        return ts::test(dp == expected && vw == expected);
+    });
+    // the worst case, every range splits off just one point
+    mark(suite).test([] {
+        std::vector<Vec> pts;
+        for (int i = 0; i != 5000; ++i)
+            { pts.emplace_back(i, (i % 2) ? 1. : 0.); }
+        std::vector<Vec> out;
+        simplify_polyline(pts, 0.1, out);
+        return ts::test(out == pts);
+    });
+    mark(suite).test([] {
+        std::vector<Vec> pts = { Vec(0, 0), Vec(1, 1), Vec(2, 0) };
+        std::vector<Vec> out;
+        try {
+            simplify_polyline(pts, -1., out);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    mark(suite).test([] {
+        std::vector<Vec> pts = {
+            Vec(0, 0), Vec(1, std::numeric_limits<double>::quiet_NaN()),
+            Vec(2, 0)
+        };
+        std::vector<Vec> out;
+        try {
+            simplify_polyline(pts, 1., out, k_visvalingam_whyatt);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
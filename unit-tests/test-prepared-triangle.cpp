@@ -0,0 +1,140 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/PreparedTriangle.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+#include <vector>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec  = Vector2<double>;
+using VecI = Vector2<int>;
+
+std::vector<Vec> random_points(std::size_t count, unsigned seed) {
+    std::default_random_engine rng { seed };
+    std::uniform_real_distribution<double> dist(-1, 11);
+    std::vector<Vec> rv;
+    for (std::size_t i = 0; i != count; ++i) rv.emplace_back(dist(rng), dist(rng));
+    return rv;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("PreparedTriangle");
+    suite.hide_successes();
+    // agrees with is_inside_triangle (away from edges), in either winding
+    mark(suite).test([] {
+        Vec a(1, 1), b(9, 2), c(4, 10);
+        PreparedTriangle<double> ccw(a, b, c), cw(a, c, b);
+        bool all_agree = true;
+        for (const auto & r : random_points(500, 1)) {
+            bool expected = is_inside_triangle(a, b, c, r);
+            all_agree = all_agree && ccw.contains(r) == expected && cw.contains(r) == expected;
+        }
+        return ts::test(all_agree);
+    });
+    mark(suite).test([] {
+        PreparedTriangle<float> tri(Vector2<float>(0, 0), Vector2<float>(8, 0), Vector2<float>(0, 8));
+        std::vector<Vector2<float>> points;
+        for (const auto & r : random_points(203, 2)) points.emplace_back(r);
+        bool out[203];
+        bool arr_out[203];
+        auto count = tri.contains(points.data(), points.data() + points.size(), out);
+        auto arr_count = tri.contains(Vector2Array<float>(points.data(), points.data() + points.size()), arr_out);
+        std::size_t expected_count = 0;
+        bool all_agree = true;
+        for (std::size_t i = 0; i != points.size(); ++i) {
+            bool expected = tri.contains(points[i]);
+            expected_count += expected ? 1 : 0;
+            all_agree = all_agree && out[i] == expected && arr_out[i] == expected;
+        }
+        return ts::test(all_agree && count == expected_count && arr_count == expected_count);
+    });
+    // points on a shared edge go to exactly one triangle
+    mark(suite).test([] {
+        VecI a(0, 0), b(12, 0), c(12, 8), d(0, 8);
+        PreparedTriangle<int> lower(a, b, c), upper(a, c, d);
+        bool all_good = true;
+        int count = 0;
+        for (int y = -1; y != 10; ++y) {
+        for (int x = -1; x != 14; ++x) {
+            VecI r(x, y);
+            int hits = int(lower.contains(r)) + int(upper.contains(r));
+            all_good = all_good && hits <= 1;
+            count += hits;
+        }}
+        // each pixel inside the rectangle is covered exactly once
+        int pixel_count = 0;
+        for (int y = -1; y != 10; ++y) {
+        for (int x = -1; x != 14; ++x) {
+            int hits = int(lower.contains_pixel_center(x, y)) + int(upper.contains_pixel_center(x, y));
+            all_good = all_good && hits <= 1;
+            pixel_count += hits;
+        }}
+        // the "top left" rule keeps only two of the rectangle's sides
+        return ts::test(all_good && count == 12*8 && pixel_count == 12*8);
+    });
+    mark(suite).test([] {
+        Vec a(1, 1), b(9, 2), c(4, 10);
+        PreparedTriangle<double> tri(a, c, b);
+        bool all_good = true;
+        for (const auto & r : random_points(100, 3)) {
+            auto [wa, wb, wc] = tri.barycentric_of(r);
+            all_good =    all_good && are_within(wa + wb + wc, 1., 1e-9)
+                       && are_within(a*wa + c*wb + b*wc, r, 1e-9)
+                       && ((wa >= 0 && wb >= 0 && wc >= 0) == tri.contains(r));
+        }
+        auto [wa, wb, wc] = tri.barycentric_of(a);
+        return ts::test(all_good && are_within(wa, 1., 1e-9) && are_within(wb + wc, 0., 1e-9));
+    });
+    mark(suite).test([] {
+        PreparedTriangle<double> line(Vec(0, 0), Vec(1, 1), Vec(2, 2));
+        PreparedTriangle<double> empty;
+        bool out[2] = { true, true };
+        Vec points[2] = { Vec(1, 1), Vec(0, 0) };
+        auto [wa, wb, wc] = line.barycentric_of(Vec(1, 1));
+        return ts::test(   line.is_degenerate() && empty.is_degenerate()
+                        && !line.contains(Vec(1, 1)) && !empty.contains(Vec())
+                        && line.contains(points, points + 2, out) == 0 && !out[0] && !out[1]
+                        && wa == 0 && wb == 0 && wc == 0);
+    });
+    // exact with large integer coordinates
+    mark(suite).test([] {
+        const int k_big = 1 << 29;
+        PreparedTriangle<int> tri(VecI(-k_big, -k_big), VecI(k_big, -k_big + 1), VecI(k_big, k_big));
+        return ts::test(   tri.doubled_area() > 0
+                        && tri.contains(VecI(k_big - 1, 0))
+                        && !tri.contains(VecI(-k_big, -k_big + 1))
+                        && !tri.contains(VecI(k_big, -k_big)));
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,177 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Region.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using RegionI = Region<int>;
+using RectI   = Rectangle<int>;
+using VecI    = Vector2<int>;
+
+constexpr const int k_grid_size = 24;
+
+std::vector<RectI> make_random_rectangles(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pos(0, k_grid_size - 1), sz(0, 8);
+    std::vector<RectI> rv;
+    for (std::size_t i = 0; i != count; ++i)
+        rv.emplace_back(pos(rng), pos(rng), sz(rng), sz(rng));
+    return rv;
+}
+
+template <typename Func>
+bool matches_points(const RegionI & region, Func && expected) {
+    for (int y = -1; y != k_grid_size + 8; ++y) {
+    for (int x = -1; x != k_grid_size + 8; ++x) {
+        if (region.contains(VecI(x, y)) != expected(VecI(x, y))) return false;
+    }}
+    return true;
+}
+
+bool in_any(const std::vector<RectI> & rects, const VecI & r) {
+    for (const auto & rect : rects)
+        { if (is_contained_in(r, rect)) return true; }
+    return false;
+}
+
+// no rectangles overlap, and no two in a band touch
+bool is_canonical(const RegionI & region) {
+    auto rects = region.rectangles();
+    for (std::size_t i = 0; i != rects.size(); ++i) {
+        for (std::size_t j = i + 1; j != rects.size(); ++j) {
+            const auto & a = rects[i];
+            const auto & b = rects[j];
+            if (overlaps(a, b)) return false;
+            if (a.top == b.top && right_of(a) == b.left) return false;
+            // row order
+            if (b.top < a.top || (b.top == a.top && b.left < a.left)) return false;
+        }
+    }
+    return true;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("Region");
+    suite.hide_successes();
+    mark(suite).test([] {
+        RegionI region(RectI(0, 0, 4, 4));
+        region |= RectI(0, 0, 4, 4);
+        region |= RectI(4, 0, 2, 4);
+        // same rectangle added twice, and a touching one: still one rectangle
+        return ts::test(region.rectangle_count() == 1
+                        && region.bounds() == RectI(0, 0, 6, 4));
+    });
+    mark(suite).test([] {
+        auto region = RegionI(RectI(0, 0, 10, 10)) - RectI(3, 3, 4, 4);
+        // top, left, right, bottom
+        return ts::test(region.rectangle_count() == 4 && is_canonical(region)
+                        && !region.contains(VecI(3, 3)) && region.contains(VecI(2, 3))
+                        && region.contains(VecI(7, 6)) && !region.contains(VecI(10, 0)));
+    });
+    mark(suite).test([] {
+        RegionI region(RectI(0, 0, 4, 4));
+        region |= RectI(0, 4, 4, 4);
+        // touching bands with the same spans are merged
+        return ts::test(region.rectangle_count() == 1 && region == RegionI(RectI(0, 0, 4, 8)));
+    });
+    mark(suite).test([] {
+        RegionI region = RegionI(RectI(0, 0, 2, 2)) | RectI(4, 0, 2, 2);
+        return ts::test(   region.contains(RectI(0, 0, 2, 2))
+                        && !region.contains(RectI(0, 0, 6, 2))
+                        && region.contains(RectI(3, 3, 0, 0))
+                        && region.overlaps(RectI(1, 1, 4, 4))
+                        && !region.overlaps(RectI(2, 0, 2, 2)));
+    });
+    // against every point, for random regions
+    mark(suite).test([] {
+        bool all_good = true;
+        for (unsigned seed = 1; seed != 40; ++seed) {
+            auto a_rects = make_random_rectangles(6 + seed % 5, seed);
+            auto b_rects = make_random_rectangles(4 + seed % 7, seed*31);
+            RegionI a(a_rects), b(b_rects);
+            auto in_a = [&a_rects](const VecI & r) { return in_any(a_rects, r); };
+            auto in_b = [&b_rects](const VecI & r) { return in_any(b_rects, r); };
+            all_good &= matches_points(a, in_a);
+            all_good &= matches_points(a | b, [&](const VecI & r) { return in_a(r) || in_b(r); });
+            all_good &= matches_points(a & b, [&](const VecI & r) { return in_a(r) && in_b(r); });
+            all_good &= matches_points(a - b, [&](const VecI & r) { return in_a(r) && !in_b(r); });
+            all_good &= matches_points(a ^ b, [&](const VecI & r) { return in_a(r) != in_b(r); });
+            all_good &= is_canonical(a | b) && is_canonical(a - b) && is_canonical(a ^ b);
+            // canonical: same set, same rectangles
+            all_good &= (a | b) == (b | a);
+            all_good &= ((a - b) | (a & b)) == a;
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        bool all_good = true;
+        for (unsigned seed = 1; seed != 20; ++seed) {
+            auto rects = make_random_rectangles(8, seed);
+            RegionI region(rects);
+            for (const auto & rect : make_random_rectangles(20, seed*7)) {
+                bool expected = true;
+                for (int y = rect.top; y < bottom_of(rect); ++y) {
+                for (int x = rect.left; x < right_of(rect); ++x) {
+                    expected &= in_any(rects, VecI(x, y));
+                }}
+                all_good &= region.contains(rect) == expected;
+            }
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        RegionI region = RegionI(RectI(0, 0, 2, 2)) | RectI(4, 0, 2, 2) | RectI(0, 5, 1, 1);
+        int count = 0;
+        region.for_each_rectangle([&count](const RectI &) {
+            ++count;
+            return fc_signal::k_break;
+        });
+        return ts::test(count == 1 && region.rectangles().size() == 3
+                        && region.rectangles()[1] == RectI(4, 0, 2, 2));
+    });
+    mark(suite).test([] {
+        RegionI region(RectI(0, 0, 0, 5));
+        auto other = RegionI(RectI(0, 0, 2, 2)) & RectI(5, 5, 1, 1);
+        return ts::test(region.is_empty() && other.is_empty()
+                        && other.bounds() == RectI() && other == RegionI());
+    });
+    mark(suite).test([] {
+        using RegionD = Region<double>;
+        RegionD region = RegionD(Rectangle<double>(0, 0, 1.5, 1.5)) - Rectangle<double>(0.5, 0.5, 0.5, 0.5);
+        return ts::test(region.contains(Vector2<double>(1.25, 0.75))
+                        && !region.contains(Vector2<double>(0.75, 0.75)));
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,247 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/SegmentIntersection.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+#include <set>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec     = Vector2<double>;
+using Segment = LineSegment<double>;
+using PairSet = std::set<std::pair<std::size_t, std::size_t>>;
+
+PairSet brute_force_pairs(const std::vector<Segment> & segments) {
+    PairSet rv;
+    for (std::size_t i = 0; i != segments.size(); ++i) {
+    for (std::size_t j = i + 1; j != segments.size(); ++j) {
+        const auto & a = segments[i];
+        const auto & b = segments[j];
+        if (is_real(find_intersection(a.a, a.b, b.a, b.b)))
+            rv.emplace(i, j);
+    }}
+    return rv;
+}
+
+PairSet swept_pairs(const std::vector<Segment> & segments) {
+    PairSet rv;
+    for (const auto & intx : find_all_intersections(segments)) {
+        if (intx.first_index >= intx.second_index) return PairSet();
+        // pairs may only be reported once
+        if (!rv.emplace(intx.first_index, intx.second_index).second)
+            return PairSet();
+    }
+    return rv;
+}
+
+bool sweep_matches_brute_force(const std::vector<Segment> & segments)
+    { return swept_pairs(segments) == brute_force_pairs(segments); }
+
+std::vector<Segment> random_segments(std::size_t count, double length, unsigned seed) {
+    std::default_random_engine rng { seed };
+    std::uniform_real_distribution<double> pos_dist(0, 100);
+    std::uniform_real_distribution<double> len_dist(-length, length);
+    std::vector<Segment> rv;
+    for (std::size_t i = 0; i != count; ++i) {
+        Vec a(pos_dist(rng), pos_dist(rng));
+        rv.emplace_back(a, a + Vec(len_dist(rng), len_dist(rng)));
+    }
+    return rv;
+}
+
+// end points on a coarse lattice, with many vertical and horizontal
+// segments, so that segments often meet at end points and share x values
+std::vector<Segment> random_lattice_segments(std::size_t count, unsigned seed) {
+    std::default_random_engine rng { seed };
+    std::uniform_int_distribution<int> pos_dist(0, 99);
+    std::uniform_int_distribution<int> kind_dist(0, 3);
+    auto random_pos = [&rng, &pos_dist]
+        { return Vec(pos_dist(rng) / 37., pos_dist(rng) / 37.); };
+    std::vector<Segment> rv;
+    for (std::size_t i = 0; i != count; ++i) {
+        auto a = random_pos();
+        auto b = random_pos();
+        switch (kind_dist(rng)) {
+        case 0: b.x = a.x; break;
+        case 1: b.y = a.y; break;
+        default: break;
+        }
+        rv.emplace_back(a, b);
+    }
+    return rv;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("Segment Intersections");
+    suite.hide_successes();
+    // one vs many agrees with find_intersection
+    mark(suite).test([] {
+        auto walls = random_segments(101, 30., 1);
+        Segment ray(Vec(0, 10), Vec(100, 90));
+        std::vector<Vec> out(walls.size());
+        auto count = intersect_one_vs_many(ray, walls.data(), walls.data() + walls.size(), out.data());
+        std::size_t expected_count = 0;
+        bool all_agree = true;
+        for (std::size_t i = 0; i != walls.size(); ++i) {
+            auto expected = find_intersection(ray.a, ray.b, walls[i].a, walls[i].b);
+            if (is_real(expected)) {
+                ++expected_count;
+                all_agree = all_agree && are_within(expected, out[i], 1e-9);
+            } else {
+                all_agree = all_agree && !is_real(out[i]);
+            }
+        }
+        return ts::test(all_agree && count == expected_count && count > 0);
+    });
+    mark(suite).test([] {
+        Segment walls[] = {
+            Segment(Vec(0, 0), Vec(0, 2)), // touching end points
+            Segment(Vec(1, 1), Vec(2, 2)), // parallel
+            Segment(Vec(5, 5), Vec(6, 6)), // out of bounding box
+        };
+        Vec out[3];
+        auto count = intersect_one_vs_many(Segment(Vec(0, 0), Vec(3, 3)),
+                                           std::begin(walls), std::end(walls), out);
+        return ts::test(   count == 1 && are_within(out[0], Vec(), 1e-9)
+                        && !is_real(out[1]) && !is_real(out[2]));
+    });
+    mark(suite).test([] {
+        auto inf = std::numeric_limits<double>::infinity();
+        try {
+            intersect_one_vs_many(Segment(Vec(), Vec(inf, 0)), static_cast<Segment *>(nullptr),
+                                  static_cast<Segment *>(nullptr), static_cast<Vec *>(nullptr));
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    mark(suite).test([] {
+        return ts::test(   find_all_intersections(std::vector<Segment>()).empty()
+                        && find_all_intersections(std::vector<Segment> { Segment(Vec(), Vec(1, 1)) }).empty());
+    });
+    mark(suite).test([] {
+        std::vector<Segment> segs = { Segment(Vec(0, 0), Vec(2, 2)), Segment(Vec(0, 2), Vec(2, 0)) };
+        auto res = find_all_intersections(segs);
+        return ts::test(   res.size() == 1 && are_within(res[0].point, Vec(1, 1), 1e-9)
+                        && res[0].first_index == 0 && res[0].second_index == 1);
+    });
+    mark(suite).test([] {
+        bool all_good = true;
+        for (unsigned seed = 0; seed != 20; ++seed)
+            all_good = all_good && sweep_matches_brute_force(random_segments(200, 15., seed));
+        return ts::test(all_good);
+    });
+    // vertical segment whose crossings round to just right of it
+    mark(suite).test([] {
+        std::vector<Segment> segs = {
+            Segment(Vec(990 / 37., 129 / 37.), Vec(123 / 37., 540 / 37.)),
+            Segment(Vec(206 / 37., 996 / 37.), Vec(206 / 37.,   5 / 37.)),
+            Segment(Vec(513 / 37., 954 / 37.), Vec(134 / 37., 987 / 37.)),
+        };
+        return ts::test(swept_pairs(segs) == PairSet { { 0, 1 }, { 1, 2 } });
+    });
+    // three segments through a point, one ending and one starting there
+    mark(suite).test([] {
+        std::vector<Segment> segs = {
+            Segment(Vec(48 / 37., 48 / 37.), Vec(37 / 37., 15 / 37.)),
+            Segment(Vec(88 / 37., 50 / 37.), Vec(42 / 37., 30 / 37.)),
+            Segment(Vec(42 / 37., 30 / 37.), Vec(41 / 37.,  3 / 37.)),
+        };
+        return ts::test(sweep_matches_brute_force(segs) && swept_pairs(segs).size() == 3);
+    });
+    mark(suite).test([] {
+        bool all_good = true;
+        for (unsigned seed = 0; seed != 2000; ++seed) {
+            auto count = 3 + std::size_t(seed % 40);
+            all_good = all_good && sweep_matches_brute_force(random_lattice_segments(count, seed));
+        }
+        return ts::test(all_good);
+    });
+    // many segments through a single point
+    mark(suite).test([] {
+        std::vector<Segment> segs;
+        for (int i = 0; i != 8; ++i) {
+            double t = double(i)*0.37;
+            Vec r(std::cos(t), std::sin(t));
+            segs.emplace_back(Vec(10, 10) - r*5., Vec(10, 10) + r*5.);
+        }
+        segs.emplace_back(Vec(0, 12), Vec(20, 13));
+        return ts::test(sweep_matches_brute_force(segs) && swept_pairs(segs).size() > 8*7/2);
+    });
+    // lattice of horizontal and vertical segments, meeting at end points too
+    mark(suite).test([] {
+        std::vector<Segment> segs;
+        for (int i = 0; i != 6; ++i) {
+            segs.emplace_back(Vec(0, i*2), Vec(10, i*2));
+            segs.emplace_back(Vec(i*2, 0), Vec(i*2, 10));
+        }
+        segs.emplace_back(Vec(4, 1), Vec(4, 9)); // overlaps another vertical
+        segs.emplace_back(Vec(3, 3), Vec(3, 3)); // just a point
+        return ts::test(sweep_matches_brute_force(segs));
+    });
+    // self intersecting polyline, consecutive segments share end points
+    mark(suite).test([] {
+        std::default_random_engine rng { 7 };
+        std::uniform_real_distribution<double> dist(0, 20);
+        std::vector<Segment> segs;
+        Vec last(dist(rng), dist(rng));
+        for (int i = 0; i != 60; ++i) {
+            Vec next(dist(rng), dist(rng));
+            segs.emplace_back(last, next);
+            last = next;
+        }
+        return ts::test(sweep_matches_brute_force(segs));
+    });
+    // segments starting and ending on others
+    mark(suite).test([] {
+        std::vector<Segment> segs = {
+            Segment(Vec(0, 0), Vec(10, 0)),
+            Segment(Vec(5, 0), Vec(8, 5)),
+            Segment(Vec(2, 5), Vec(5, 0)),
+            Segment(Vec(5, -4), Vec(5, 6)),
+            Segment(Vec(10, 0), Vec(12, 3)),
+            Segment(Vec(3, 3), Vec(9, 3)),
+        };
+        return ts::test(sweep_matches_brute_force(segs));
+    });
+    mark(suite).test([] {
+        auto nan = std::numeric_limits<double>::quiet_NaN();
+        try {
+            find_all_intersections(std::vector<Segment> { Segment(Vec(), Vec(nan, 0)) });
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,179 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/SeparatingAxis.hpp>
+#include <common/TestSuite.hpp>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec     = Vector2<double>;
+using Polygon = ConvexPolygon<double>;
+using CircleD = Circle<double>;
+
+Polygon make_box(double x, double y, double w, double h) {
+    return Polygon(std::vector<Vec>
+        { Vec(x, y), Vec(x + w, y), Vec(x + w, y + h), Vec(x, y + h) });
+}
+
+bool near(const Vec & a, const Vec & b) { return are_within(a, b, 1e-9); }
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("separating axis");
+    suite.hide_successes();
+    mark(suite).test([] {
+        auto res = find_minimum_translation(make_box(0, 0, 4, 4), make_box(3, 1, 4, 4));
+        return ts::test(res.is_overlapping && near(res.translation(), Vec(-1, 0)));
+    });
+    // winding does not matter
+    mark(suite).test([] {
+        Polygon ccw(std::vector<Vec>{ Vec(0, 0), Vec(4, 0), Vec(0, 4) });
+        Polygon cw (std::vector<Vec>{ Vec(0, 0), Vec(0, 4), Vec(4, 0) });
+        auto other = make_box(1, -3.5, 1, 4);
+        auto a = find_minimum_translation(ccw, other);
+        auto b = find_minimum_translation(cw , other);
+        return ts::test(a.is_overlapping && b.is_overlapping
+                        && near(a.translation(), Vec(0, 0.5))
+                        && near(b.translation(), Vec(0, 0.5)));
+    });
+    // separated along a diagonal, which bounding boxes would miss
+    mark(suite).test([] {
+        Polygon tri(std::vector<Vec>{ Vec(0, 0), Vec(4, 0), Vec(0, 4) });
+        auto res = find_minimum_translation(tri, make_box(2.5, 2.5, 2, 2));
+        return ts::test(!res.is_overlapping && res.depth == 0.);
+    });
+    // touching does not overlap
+    mark(suite).test([] {
+        auto a = find_minimum_translation(make_box(0, 0, 1, 1), make_box(1, 0, 1, 1));
+        auto b = find_minimum_translation(CircleD(Vec(), 1.), CircleD(Vec(2, 0), 1.));
+        return ts::test(!a.is_overlapping && !b.is_overlapping);
+    });
+    mark(suite).test([] {
+        auto res = find_minimum_translation(CircleD(Vec(0, 0), 2.), CircleD(Vec(3, 0), 2.));
+        return ts::test(res.is_overlapping && near(res.translation(), Vec(-1, 0)));
+    });
+    mark(suite).test([] {
+        auto res = find_minimum_translation(CircleD(Vec(1, 1), 2.), CircleD(Vec(1, 1), 1.));
+        return ts::test(res.is_overlapping && are_within(res.depth, 3., 1e-9));
+    });
+    // circle against a side
+    mark(suite).test([] {
+        auto res = find_minimum_translation(CircleD(Vec(2, 4.5), 1.), make_box(0, 0, 4, 4));
+        auto rev = find_minimum_translation(make_box(0, 0, 4, 4), CircleD(Vec(2, 4.5), 1.));
+        return ts::test(res.is_overlapping && near(res.translation(), Vec(0, 0.5))
+                        && rev.is_overlapping && near(rev.translation(), Vec(0, -0.5)));
+    });
+    // circle near a corner, but outside of it
+    mark(suite).test([] {
+        auto res = find_minimum_translation(CircleD(Vec(4.6, 4.6), 0.8), make_box(0, 0, 4, 4));
+        return ts::test(!res.is_overlapping);
+    });
+    // ...and inside of it
+    mark(suite).test([] {
+        Vec center(4.5, 4.5);
+        auto res = find_minimum_translation(CircleD(center, 1.), make_box(0, 0, 4, 4));
+        auto expected = normalize(Vec(1, 1))*(1. - magnitude(Vec(0.5, 0.5)));
+        return ts::test(res.is_overlapping && near(res.translation(), expected));
+    });
+    // translation really does separate
+    mark(suite).test([] {
+        Polygon hex(std::vector<Vec>{ Vec(2, 0), Vec(1, 1.7), Vec(-1, 1.7),
+                                      Vec(-2, 0), Vec(-1, -1.7), Vec(1, -1.7) });
+        Polygon tri(std::vector<Vec>{ Vec(1, 0.5), Vec(5, 1), Vec(3, 4) });
+        auto res = find_minimum_translation(hex, tri);
+        std::vector<Vec> moved;
+        for (std::size_t i = 0; i != hex.size(); ++i)
+            moved.push_back(hex.vertices()[i] + res.translation()*1.0001);
+        auto after = find_minimum_translation(Polygon(moved), tri);
+        return ts::test(res.is_overlapping && !after.is_overlapping);
+    });
+    // batch gives the same as one at a time
+    mark(suite).test([] {
+        ConvexShapeSet<double> set;
+        auto a = set.add(make_box(0, 0, 4, 4));
+        auto b = set.add(CircleD(Vec(4.5, 2), 1.));
+        auto c = set.add(Polygon(std::vector<Vec>{ Vec(3, 3), Vec(6, 3), Vec(3, 6) }));
+        auto d = set.add(CircleD(Vec(10, 10), 1.));
+        std::vector<ConvexShapeSet<double>::ShapePair> pairs =
+            { { a, b }, { b, a }, { a, c }, { c, b }, { d, a }, { d, d } };
+        std::vector<MinimumTranslation<double>> out(pairs.size());
+        auto count = find_minimum_translations(set, pairs.data(), pairs.data() + pairs.size(), out.data());
+        auto ab = find_minimum_translation(make_box(0, 0, 4, 4), CircleD(Vec(4.5, 2), 1.));
+        // c only touches b
+        return ts::test(count == 4 && out[0].is_overlapping && !out[3].is_overlapping
+                        && near(out[0].translation(), ab.translation())
+                        && near(out[1].translation(), -ab.translation())
+                        && out[2].is_overlapping && !out[4].is_overlapping);
+    });
+    mark(suite).test([] {
+        ConvexShapeSet<double> set;
+        set.add(CircleD(Vec(), 1.));
+        std::vector<ConvexShapeSet<double>::ShapePair> pairs = { { 0, 1 } };
+        MinimumTranslation<double> out;
+        try {
+            find_minimum_translations(set, pairs.data(), pairs.data() + 1, &out);
+        } catch (std::out_of_range &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    mark(suite).test([] {
+        try {
+            Polygon(std::vector<Vec>{ Vec(0, 0), Vec(4, 0), Vec(1, 1), Vec(0, 4) });
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    // a pentagram turns the same way at every vertex, but winds twice
+    mark(suite).test([] {
+        try {
+            Polygon(std::vector<Vec>{ Vec(0, 4), Vec(2, -3), Vec(-4, 1), Vec(4, 1), Vec(-2, -3) });
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    // ...while the pentagon it is drawn from is fine
+    mark(suite).test([] {
+        Polygon pentagon(std::vector<Vec>{ Vec(0, 4), Vec(4, 1), Vec(2, -3),
+                                           Vec(-2, -3), Vec(-4, 1) });
+        return ts::test(pentagon.size() == 5);
+    });
+    mark(suite).test([] {
+        try {
+            find_minimum_translation(CircleD(Vec(), -1.), CircleD(Vec(), 1.));
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,133 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/SlotMap.hpp>
+#include <common/Grid.hpp>
+#include <common/TestSuite.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_set>
+#include <algorithm>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+int main() {
+    using namespace cul;
+    using Handle = SlotMapHandle;
+    ts::TestSuite suite("SlotMap");
+    suite.hide_successes();
+    mark(suite).test([] {
+        SlotMap<std::string> map;
+        auto a = map.insert("a");
+        auto b = map.insert("b");
+        return ts::test(   map.size() == 2 && a != b
+                        && map.at(a) == "a" && *map.find(b) == "b");
+    });
+    mark(suite).test([] {
+        SlotMap<std::string> map;
+        auto a = map.insert("a");
+        auto b = map.insert("b");
+        auto c = map.insert("c");
+        bool erased = map.erase(a);
+        return ts::test(   erased && !map.contains(a) && map.size() == 2
+                        && map.at(b) == "b" && map.at(c) == "c");
+    });
+    // stale handles must not see reused slots
+    mark(suite).test([] {
+        SlotMap<int> map;
+        auto a = map.insert(1);
+        map.erase(a);
+        auto b = map.insert(2);
+        return ts::test(   a.index == b.index && !map.contains(a)
+                        && !map.erase(a) && map.at(b) == 2);
+    });
+    mark(suite).test([] {
+        SlotMap<int> map;
+        map.insert(1);
+        return ts::test(!map.contains(Handle()) && Handle().is_null());
+    });
+    mark(suite).test([] {
+        SlotMap<int> map;
+        auto a = map.insert(1);
+        map.erase(a);
+        try {
+            (void)map.at(a);
+        } catch (std::out_of_range &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    // storage stays dense, and handles can be recovered while iterating
+    mark(suite).test([] {
+        SlotMap<int> map;
+        std::vector<Handle> handles;
+        for (int i = 0; i != 100; ++i) handles.push_back(map.insert(i));
+        for (int i = 0; i < 100; i += 3) map.erase(handles[std::size_t(i)]);
+        bool all_good = true;
+        for (auto itr = map.begin(); itr != map.end(); ++itr) {
+            auto handle = map.handle_of(itr);
+            all_good = all_good && *itr % 3 != 0 && handles[std::size_t(*itr)] == handle;
+        }
+        return ts::test(all_good && map.size() == 66);
+    });
+    mark(suite).test([] {
+        SlotMap<std::unique_ptr<int>> map;
+        auto a = map.emplace(std::make_unique<int>(4));
+        auto b = map.emplace(std::make_unique<int>(5));
+        map.erase(a);
+        return ts::test(**map.find(b) == 5);
+    });
+    mark(suite).test([] {
+        SlotMap<int> map;
+        auto a = map.insert(1);
+        map.clear();
+        auto b = map.insert(2);
+        return ts::test(!map.contains(a) && map.contains(b) && map.size() == 1);
+    });
+    // handles in a grid, referencing objects that come and go
+    mark(suite).test([] {
+        SlotMap<std::string> map;
+        Grid<Handle> grid;
+        grid.set_size(4, 4);
+        grid(1, 2) = map.insert("popup");
+        grid(3, 3) = map.insert("shape");
+        map.erase(grid(1, 2));
+        int live_count = 0;
+        for (auto handle : grid) {
+            if (map.contains(handle)) ++live_count;
+        }
+        return ts::test(live_count == 1 && map.at(grid(3, 3)) == "shape");
+    });
+    mark(suite).test([] {
+        SlotMap<int> map;
+        std::unordered_set<Handle> set;
+        for (int i = 0; i != 10; ++i) set.insert(map.insert(i));
+        return ts::test(set.size() == 10);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,181 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/SpatialHashGrid.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Rect     = Rectangle<float>;
+using Vec      = Vector2<float>;
+using HashGrid = SpatialHashGrid<int>;
+using Index    = HashGrid::ObjectIndex;
+using IndexSet = std::set<Index>;
+using PairSet  = std::set<std::pair<Index, Index>>;
+
+// some objects go outside of the world, and a few are large
+std::vector<Rect> random_rectangles(std::size_t count, unsigned seed) {
+    std::default_random_engine rng { seed };
+    std::uniform_real_distribution<float> pos(-10, 110), size(0.5f, 4);
+    std::uniform_int_distribution<int> large(0, 50);
+    std::vector<Rect> rv;
+    for (std::size_t i = 0; i != count; ++i) {
+        float scale = large(rng) == 0 ? 5.f : 1.f;
+        rv.emplace_back(pos(rng), pos(rng), size(rng)*scale, size(rng)*scale);
+    }
+    return rv;
+}
+
+void fill(HashGrid & grid, const std::vector<Rect> & rects) {
+    grid.clear();
+    for (const auto & rect : rects) grid.add(rect, 0);
+    grid.rebuild();
+}
+
+float distance_squared(const Rect & rect, const Vec & r) {
+    float dx = std::max(0.f, std::max(rect.left - r.x, r.x - right_of (rect)));
+    float dy = std::max(0.f, std::max(rect.top  - r.y, r.y - bottom_of(rect)));
+    return dx*dx + dy*dy;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("SpatialHashGrid");
+    suite.hide_successes();
+    mark(suite).test([] {
+        auto rects = random_rectangles(1000, 1);
+        HashGrid grid(Rect(0, 0, 100, 100), 4.f);
+        fill(grid, rects);
+        bool all_good = true;
+        std::default_random_engine rng { 2 };
+        std::uniform_real_distribution<float> pos(-20, 120), size(0, 15);
+        for (int i = 0; i != 50; ++i) {
+            Rect query(pos(rng), pos(rng), size(rng), size(rng));
+            IndexSet found, expected;
+            grid.query(query, [&found](Index idx, int) { found.insert(idx); });
+            for (Index j = 0; j != rects.size(); ++j)
+                { if (overlaps(rects[j], query)) expected.insert(j); }
+            all_good = all_good && found == expected;
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        auto rects = random_rectangles(1500, 3);
+        HashGrid grid(Rect(0, 0, 100, 100), 3.f);
+        fill(grid, rects);
+        PairSet found, expected;
+        bool ordered = true;
+        grid.for_each_overlapping_pair([&](Index a, Index b) {
+            ordered = ordered && a < b;
+            found.emplace(a, b);
+        });
+        for (Index i = 0; i != rects.size(); ++i) {
+        for (Index j = i + 1; j != rects.size(); ++j) {
+            if (overlaps(rects[i], rects[j])) expected.emplace(i, j);
+        }}
+        return ts::test(ordered && found == expected && !found.empty());
+    });
+    mark(suite).test([] {
+        auto rects = random_rectangles(800, 4);
+        HashGrid grid(Rect(0, 0, 100, 100), 5.f);
+        fill(grid, rects);
+        bool all_good = true;
+        for (const auto & r : { Vec(50, 50), Vec(0, 0), Vec(-30, 70), Vec(99, 12) }) {
+            Index out[10];
+            auto count = grid.find_k_nearest(r, 10, out);
+            std::vector<float> expected;
+            for (const auto & rect : rects) expected.push_back(distance_squared(rect, r));
+            std::sort(expected.begin(), expected.end());
+            all_good = all_good && count == 10;
+            for (std::size_t i = 0; i != count; ++i)
+                { all_good = all_good && distance_squared(rects[out[i]], r) == expected[i]; }
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        HashGrid grid(Rect(0, 0, 10, 10), 1.f);
+        grid.add(Rect(1, 1, 1, 1), 5);
+        grid.add(Rect(8, 8, 1, 1), 6);
+        grid.rebuild();
+        Index out[3] = {};
+        auto count = grid.find_k_nearest(Vec(0, 0), 3, out);
+        return ts::test(   count == 2 && out[0] == 0 && out[1] == 1
+                        && grid.payload_of(out[1]) == 6
+                        && grid.find_k_nearest(Vec(), 0, out) == 0);
+    });
+    // without a world, rebuilding does nothing and nothing is found
+    mark(suite).test([] {
+        HashGrid grid;
+        grid.add(Rect(1, 1, 1, 1), 5);
+        grid.rebuild();
+        Index out[1] = {};
+        bool found_any = false;
+        grid.query(Rect(0, 0, 10, 10), [&found_any](Index, int) { found_any = true; });
+        grid.for_each_overlapping_pair([&found_any](Index, Index) { found_any = true; });
+        return ts::test(   !found_any && grid.size() == 1
+                        && grid.find_k_nearest(Vec(), 1, out) == 0);
+    });
+    // rebuilding the same number of objects again makes no allocations
+    mark(suite).test([] {
+        HashGrid grid(Rect(0, 0, 100, 100), 4.f);
+        fill(grid, random_rectangles(500, 5));
+        const auto * sorted = grid.sorted_objects().data();
+        fill(grid, random_rectangles(500, 6));
+        const auto & cells = grid.cells();
+        std::size_t total = 0;
+        for (const auto & cell : cells) total += cell.end - cell.begin;
+        return ts::test(sorted == grid.sorted_objects().data() && total == 500);
+    });
+    mark(suite).test([] {
+        HashGrid grid(Rect(0, 0, 10, 10), 1.f);
+        grid.add(Rect(1, 1, 1, 1), 0);
+        grid.add(Rect(1.5f, 1.5f, 1, 1), 0);
+        grid.add(Rect(1.2f, 1.2f, 1, 1), 0);
+        grid.rebuild();
+        int count = 0;
+        grid.for_each_overlapping_pair([&count](Index, Index)
+            { return ++count == 2 ? fc_signal::k_break : fc_signal::k_continue; });
+        return ts::test(count == 2);
+    });
+    mark(suite).test([] {
+        bool threw = false;
+        try {
+            HashGrid(Rect(0, 0, 10, 10), 0.f);
+        } catch (std::invalid_argument &) {
+            threw = true;
+        }
+        return ts::test(threw);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,170 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/SweptRectangle.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec  = Vector2<double>;
+using Rect = Rectangle<double>;
+
+// finds first overlap by stepping in very small increments
+double stepped_time_of_impact
+    (const Rect & moving, const Vec & displacement, const Rect & obstacle)
+{
+    static constexpr const int k_steps = 10000;
+    for (int i = 0; i <= k_steps; ++i) {
+        double t = double(i) / k_steps;
+        Rect rect = moving;
+        rect.left += displacement.x*t;
+        rect.top  += displacement.y*t;
+        if (overlaps(rect, obstacle)) return t;
+    }
+    return SweepHit<double>::k_no_impact;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("sweep");
+    suite.hide_successes();
+    // fast object through a thin wall
+    mark(suite).test([] {
+        auto hit = sweep(Rect(0, 0, 1, 1), Vec(100, 0), Rect(50, -5, 0.1, 10));
+        return ts::test(are_within(hit.time_of_impact, 0.49, 1e-12)
+                        && hit.normal == Vec(-1, 0));
+    });
+    mark(suite).test([] {
+        auto hit = sweep(Rect(0, 0, 1, 1), Vec(0, -10), Rect(-5, -6, 10, 2));
+        return ts::test(are_within(hit.time_of_impact, 0.4, 1e-12)
+                        && hit.normal == Vec(0, 1));
+    });
+    // too short, and missing to the side
+    mark(suite).test([] {
+        auto a = sweep(Rect(0, 0, 1, 1), Vec(10, 0), Rect(20, 0, 1, 1));
+        auto b = sweep(Rect(0, 0, 1, 1), Vec(10, 10), Rect(0, 5, 1, 1));
+        return ts::test(!a.is_hit() && !b.is_hit());
+    });
+    // sliding along a side, and moving away, are not hits
+    mark(suite).test([] {
+        auto a = sweep(Rect(0, 0, 1, 1), Vec(10, 0), Rect(-5, 1, 20, 1));
+        auto b = sweep(Rect(0, 0, 1, 1), Vec(0, -3), Rect(-5, 1, 20, 1));
+        return ts::test(!a.is_hit() && !b.is_hit());
+    });
+    // touching and moving into it hits right away
+    mark(suite).test([] {
+        auto hit = sweep(Rect(0, 0, 1, 1), Vec(0, 3), Rect(-5, 1, 20, 1));
+        return ts::test(hit.time_of_impact == 0. && hit.normal == Vec(0, -1));
+    });
+    mark(suite).test([] {
+        auto hit = sweep(Rect(0, 0, 2, 2), Vec(3, 3), Rect(1, 1, 2, 2));
+        return ts::test(hit.time_of_impact == 0. && hit.normal == Vec());
+    });
+    // agrees with small steps
+    mark(suite).test([] {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> pos(-10., 10.), sz(0.1, 3.);
+        bool all_good = true;
+        for (int i = 0; i != 300; ++i) {
+            Rect moving(pos(rng), pos(rng), sz(rng), sz(rng));
+            Rect obstacle(pos(rng), pos(rng), sz(rng), sz(rng));
+            Vec displacement(pos(rng)*2., pos(rng)*2.);
+            if (overlaps(moving, obstacle)) continue;
+            auto hit = sweep(moving, displacement, obstacle);
+            auto stepped = stepped_time_of_impact(moving, displacement, obstacle);
+            if (hit.is_hit() != (stepped != SweepHit<double>::k_no_impact)) {
+                all_good = false;
+            } else if (hit.is_hit()) {
+                all_good &= stepped - hit.time_of_impact <= 0.0002
+                         && stepped >= hit.time_of_impact;
+            }
+        }
+        return ts::test(all_good);
+    });
+    // earliest of several
+    mark(suite).test([] {
+        std::vector<Rect> obstacles = {
+            Rect(30, 0, 1, 1), Rect(10, -20, 1, 1), Rect(20, 0, 1, 1),
+            Rect(std::numeric_limits<double>::quiet_NaN(), 0, 1, 1)
+        };
+        auto [hit, idx] = sweep(Rect(0, 0, 1, 1), Vec(40, 0), obstacles);
+        return ts::test(idx == 2 && are_within(hit.time_of_impact, 19. / 40., 1e-12));
+    });
+    mark(suite).test([] {
+        std::vector<Rect> obstacles;
+        auto [hit, idx] = sweep(Rect(0, 0, 1, 1), Vec(40, 0), obstacles);
+        (void)idx;
+        return ts::test(!hit.is_hit());
+    });
+    // sliding into a corner
+    mark(suite).test([] {
+        std::vector<Rect> obstacles = { Rect(-10, 5, 20, 1), Rect(4, -10, 1, 20) };
+        auto res = slide(Rect(0, 0, 1, 1), Vec(10, 10), obstacles);
+        return ts::test(res.rectangle == Rect(3, 4, 1, 1) && res.hit_count == 2);
+    });
+    // sliding along the floor
+    mark(suite).test([] {
+        std::vector<Rect> obstacles = { Rect(-10, 5, 20, 1) };
+        auto res = slide(Rect(0, 0, 1, 1), Vec(3, 10), obstacles);
+        return ts::test(res.rectangle == Rect(3, 4, 1, 1) && res.hit_count == 1
+                        && res.last_normal == Vec(0, -1));
+    });
+    // stops at the last hit allowed
+    mark(suite).test([] {
+        std::vector<Rect> obstacles = { Rect(-10, 5, 20, 1) };
+        auto res = slide(Rect(0, 0, 1, 1), Vec(3, 10), obstacles, 1);
+        return ts::test(are_within(res.rectangle.left, 1.2, 1e-12)
+                        && res.rectangle.top == 4.);
+    });
+    // zero hits allowed acts like one, it still stops against the obstacle
+    mark(suite).test([] {
+        std::vector<Rect> obstacles = { Rect(-10, 5, 20, 1) };
+        auto res = slide(Rect(0, 0, 1, 1), Vec(3, 10), obstacles, 0);
+        return ts::test(are_within(res.rectangle.left, 1.2, 1e-12)
+                        && res.rectangle.top == 4. && res.hit_count == 1);
+    });
+    // may leave what it already overlaps
+    mark(suite).test([] {
+        std::vector<Rect> obstacles = { Rect(0, 0, 5, 5) };
+        auto res = slide(Rect(1, 1, 1, 1), Vec(10, 0), obstacles);
+        return ts::test(res.rectangle == Rect(11, 1, 1, 1) && res.hit_count == 0);
+    });
+    mark(suite).test([] {
+        try {
+            sweep(Rect(0, 0, 1, 1), get_no_solution_sentinel<Vec>(), Rect());
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,285 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/ThreadPool.hpp>
+#include <common/TaskGraph.hpp>
+#include <common/TestSuite.hpp>
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <string>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+
+bool run_parallel_for_tests();
+bool run_parallel_reduce_tests();
+bool run_submit_tests();
+bool run_task_graph_tests();
+
+} // end of <anonymous> namespace
+
+int main() {
+    auto test_list = {
+        run_parallel_for_tests,
+        run_parallel_reduce_tests,
+        run_submit_tests,
+        run_task_graph_tests
+    };
+
+    bool all_good = true;
+    for (auto f : test_list) {
+        if (!f()) all_good = false;
+    }
+
+    return all_good ? 0 : ~0;
+}
+
+namespace {
+
+bool run_parallel_for_tests() {
+    ts::TestSuite suite("parallel_for");
+    suite.hide_successes();
+    mark(suite).test([] {
+        ThreadPool pool(4);
+        std::vector<int> hits(10007, 0);
+        parallel_for(pool, 0, int(hits.size()), 64, [&hits](int i) { ++hits[std::size_t(i)]; });
+        return ts::test(std::all_of(hits.begin(), hits.end(), [](int x) { return x == 1; }));
+    });
+    // no workers, caller does all the work
+    mark(suite).test([] {
+        ThreadPool pool(0);
+        std::vector<int> hits(100, 0);
+        parallel_for(pool, 0, 100, 7, [&hits](int i) { hits[std::size_t(i)] = i; });
+        return ts::test(hits[99] == 99 && hits[50] == 50);
+    });
+    mark(suite).test([] {
+        int count = 0;
+        parallel_for(10, 10, 1, [&count](int) { ++count; });
+        return ts::test(count == 0);
+    });
+    mark(suite).test([] {
+        try {
+            parallel_for(0, 10, 0, [](int) {});
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    // nested loops must not deadlock, waiting threads run tasks
+    mark(suite).test([] {
+        ThreadPool pool(3);
+        std::vector<int> sums(16, 0);
+        parallel_for(pool, 0, 16, 1, [&pool, &sums](int i) {
+            std::vector<int> inner(100, 0);
+            parallel_for(pool, 0, 100, 10, [&inner](int j) { inner[std::size_t(j)] = j; });
+            sums[std::size_t(i)] = std::accumulate(inner.begin(), inner.end(), 0);
+        });
+        return ts::test(std::all_of(sums.begin(), sums.end(), [](int x) { return x == 4950; }));
+    });
+    mark(suite).test([] {
+        ThreadPool pool(2);
+        try {
+            parallel_for(pool, 0, 1000, 10, [](int i) {
+                if (i == 503) throw std::runtime_error("503");
+            });
+        } catch (std::runtime_error &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only();
+}
+
+bool run_parallel_reduce_tests() {
+    ts::TestSuite suite("parallel_reduce");
+    suite.hide_successes();
+    mark(suite).test([] {
+        ThreadPool pool(4);
+        auto sum = parallel_reduce(pool, std::int64_t(0), std::int64_t(100000),
+            std::int64_t(1000), std::int64_t(0),
+            [](std::int64_t i) { return i; },
+            [](std::int64_t a, std::int64_t b) { return a + b; });
+        return ts::test(sum == std::int64_t(99999)*100000 / 2);
+    });
+    // order is preserved for associative, non-commutative reductions
+    mark(suite).test([] {
+        ThreadPool pool(4);
+        auto str = parallel_reduce(pool, 0, 26, 3, std::string(),
+            [](int i) { return std::string(1, char('a' + i)); },
+            [](std::string a, const std::string & b) { return a + b; });
+        return ts::test(str == "abcdefghijklmnopqrstuvwxyz");
+    });
+    // bool partials are not packed together (std::vector<bool> would be)
+    mark(suite).test([] {
+        ThreadPool pool(4);
+        auto any_big = parallel_reduce(pool, 0, 10000, 7, false,
+            [](int i) { return i == 9876; },
+            [](bool a, bool b) { return a || b; });
+        auto all_small = parallel_reduce(pool, 0, 10000, 7, true,
+            [](int i) { return i < 10000; },
+            [](bool a, bool b) { return a && b; });
+        return ts::test(any_big && all_small);
+    });
+    return suite.has_successes_only();
+}
+
+bool run_submit_tests() {
+    ts::TestSuite suite("ThreadPool::submit");
+    suite.hide_successes();
+    mark(suite).test([] {
+        ThreadPool pool(4);
+        TaskGroup group;
+        std::atomic<int> count = 0;
+        for (int i = 0; i != 1000; ++i) {
+            pool.submit(group, [&count] { ++count; });
+        }
+        pool.wait(group);
+        return ts::test(count == 1000 && group.is_done());
+    });
+    // tasks submitted from inside tasks go to the worker's own deque
+    mark(suite).test([] {
+        ThreadPool pool(4);
+        TaskGroup group;
+        std::atomic<int> count = 0;
+        for (int i = 0; i != 10; ++i) {
+            pool.submit(group, [&pool, &group, &count] {
+                for (int j = 0; j != 100; ++j) {
+                    pool.submit(group, [&count] { ++count; });
+                }
+            });
+        }
+        pool.wait(group);
+        return ts::test(count == 1000);
+    });
+    mark(suite).test([] {
+        TaskGroup group;
+        Task task;
+        task.group = &group;
+        try {
+            ThreadPool::default_instance().submit(task);
+        } catch (std::invalid_argument &) {
+            return ts::test(group.is_done());
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only();
+}
+
+bool run_task_graph_tests() {
+    ts::TestSuite suite("TaskGraph");
+    suite.hide_successes();
+    // resource declarations order tasks as they were added
+    mark(suite).test([] {
+        ThreadPool pool(3);
+        TaskGraph graph;
+        int world = 0, text = 0, drawn = 0;
+        auto upd = graph.add_task([&world] { ++world; });
+        auto geo = graph.add_task([&world, &text] { text = world*10; });
+        auto drw = graph.add_task([&text, &drawn] { drawn = text; },
+                                  TaskGraph::k_main_thread);
+        graph.add_write(upd, &world);
+        graph.add_read (geo, &world);
+        graph.add_write(geo, &text );
+        graph.add_read (drw, &text );
+        bool ok = true;
+        for (int frame = 1; frame != 20; ++frame) {
+            graph.run(pool);
+            ok = ok && drawn == frame*10;
+        }
+        return ts::test(ok);
+    });
+    // main thread tasks run on the caller
+    mark(suite).test([] {
+        ThreadPool pool(3);
+        TaskGraph graph;
+        auto caller = std::this_thread::get_id();
+        std::atomic<int> wrong_thread = 0;
+        for (int i = 0; i != 50; ++i) {
+            graph.add_task([&] {
+                if (std::this_thread::get_id() != caller) ++wrong_thread;
+            }, TaskGraph::k_main_thread);
+            graph.add_task([] {});
+        }
+        graph.run(pool);
+        graph.run(pool);
+        return ts::test(wrong_thread == 0);
+    });
+    mark(suite).test([] {
+        ThreadPool pool(2);
+        TaskGraph graph;
+        std::vector<int> order;
+        std::mutex mtx;
+        auto push = [&order, &mtx](int i) {
+            return [&order, &mtx, i] {
+                std::lock_guard<std::mutex> lock(mtx);
+                order.push_back(i);
+            };
+        };
+        auto c = graph.add_task(push(2));
+        auto a = graph.add_task(push(0));
+        auto b = graph.add_task(push(1));
+        graph.add_dependency(a, b);
+        graph.add_dependency(b, c);
+        graph.run(pool);
+        return ts::test(order == std::vector<int> { 0, 1, 2 });
+    });
+    mark(suite).test([] {
+        TaskGraph graph;
+        auto a = graph.add_task([] {});
+        auto b = graph.add_task([] {});
+        graph.add_dependency(a, b);
+        graph.add_dependency(b, a);
+        try {
+            graph.prepare();
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    // a throwing task skips what follows, and the run still finishes
+    mark(suite).test([] {
+        ThreadPool pool(2);
+        TaskGraph graph;
+        bool after_ran = false;
+        auto a = graph.add_task([] { throw std::runtime_error("a"); });
+        auto b = graph.add_task([&after_ran] { after_ran = true; });
+        graph.add_dependency(a, b);
+        try {
+            graph.run(pool);
+        } catch (std::runtime_error &) {
+            return ts::test(!after_ran);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only();
+}
+
+} // end of <anonymous> namespace
@@ -0,0 +1,110 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#define MACRO_CUL_ENABLE_TRACING
+#include <common/Trace.hpp>
+#include <common/ThreadPool.hpp>
+#include <common/TestSuite.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+int count_of(const std::string & str, const std::string & sub) {
+    int count = 0;
+    for (auto pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1))
+        { ++count; }
+    return count;
+}
+
+std::string write_trace() {
+    std::stringstream sstrm;
+    cul::trace::write_chrome_trace(sstrm);
+    return sstrm.str();
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    using namespace cul;
+    ts::TestSuite suite("Trace");
+    suite.hide_successes();
+    mark(suite).test([] {
+        trace::clear();
+        {
+        CUL_TRACE_SCOPE("outer");
+        CUL_TRACE_SCOPE("inner");
+        }
+        auto json = write_trace();
+        return ts::test(   count_of(json, "\"name\":\"outer\"") == 1
+                        && count_of(json, "\"name\":\"inner\"") == 1
+                        && count_of(json, "\"ph\":\"X\"") == 2
+                        && json.find("{\"traceEvents\":[") == 0);
+    });
+    // each thread gets its own id
+    mark(suite).test([] {
+        trace::clear();
+        std::thread thd([] { CUL_TRACE_SCOPE("on other thread"); });
+        thd.join();
+        { CUL_TRACE_SCOPE("on this thread"); }
+        auto json = write_trace();
+        auto other_tid = json.find("\"tid\":", json.find("on other thread"));
+        auto this_tid  = json.find("\"tid\":", json.find("on this thread"));
+        return ts::test(   other_tid != std::string::npos && this_tid != std::string::npos
+                        && json.substr(other_tid, 8) != json.substr(this_tid, 8));
+    });
+    mark(suite).test([] {
+        trace::clear();
+        { CUL_TRACE_SCOPE("a \"quoted\" name"); }
+        return ts::test(count_of(write_trace(), "a \\\"quoted\\\" name") == 1);
+    });
+    // ring buffers keep only the most recent events
+    mark(suite).test([] {
+        trace::clear();
+        for (std::size_t i = 0; i != trace::k_events_per_thread + 10; ++i)
+            { CUL_TRACE_SCOPE("many"); }
+        return ts::test(count_of(write_trace(), "\"many\"") == int(trace::k_events_per_thread));
+    });
+    // library headers record nothing of their own (that would be an ODR
+    // violation for users built with a different setting), user scopes around
+    // library calls are still recorded
+    mark(suite).test([] {
+        trace::clear();
+        ThreadPool pool(2);
+        {
+        CUL_TRACE_SCOPE("user parallel_for");
+        parallel_for(pool, 0, 100, 10, [](int) {});
+        }
+        auto json = write_trace();
+        return ts::test(   count_of(json, "\"user parallel_for\"") == 1
+                        && count_of(json, "\"ph\":\"X\"") == 1);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
@@ -0,0 +1,133 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Transform2.hpp>
+#include <common/TestSuite.hpp>
+
+#include <vector>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+
+template <typename T>
+bool near(const Vector2<T> & a, const Vector2<T> & b)
+    { return are_within(a, b, T(0.0001)); }
+
+template <typename T>
+bool near(const Transform2<T> & a, const Transform2<T> & b) {
+    return    near(Vector2<T>(a.a , a.b ), Vector2<T>(b.a , b.b ))
+           && near(Vector2<T>(a.c , a.d ), Vector2<T>(b.c , b.d ))
+           && near(Vector2<T>(a.tx, a.ty), Vector2<T>(b.tx, b.ty));
+}
+
+template <typename T>
+bool run_transform_tests(const char * series_name);
+
+} // end of <anonymous> namespace
+
+int main() {
+    bool all_good = true;
+    if (!run_transform_tests<float >("Transform2<float>" )) all_good = false;
+    if (!run_transform_tests<double>("Transform2<double>")) all_good = false;
+    return all_good ? 0 : ~0;
+}
+
+namespace {
+
+template <typename T>
+bool run_transform_tests(const char * series_name) {
+    using Transform = Transform2<T>;
+    using Vec       = Vector2<T>;
+    static constexpr const T k_pi = k_pi_for_type<T>;
+    ts::TestSuite suite(series_name);
+    suite.hide_successes();
+    // same as rotate_vector
+    mark(suite).test([] {
+        auto rot = Transform::make_rotation(T(0.7));
+        Vec r(T(3), T(-2));
+        return ts::test(near(rot(r), rotate_vector(r, T(0.7))));
+    });
+    mark(suite).test([] {
+        auto t = Transform::make_translation(Vec(T(1), T(2)))
+                 * Transform::make_scale(T(2), T(3));
+        return ts::test(   near(t(Vec(T(1), T(1))), Vec(T(3), T(5)))
+                        && near(t.transform_direction(Vec(T(1), T(1))), Vec(T(2), T(3))));
+    });
+    // "then" composes the other way around
+    mark(suite).test([] {
+        auto a = Transform::make_rotation(k_pi*T(0.5));
+        auto b = Transform::make_translation(Vec(T(5), T(0)));
+        Vec r(T(1), T(0));
+        return ts::test(   near(a.then(b)(r), b(a(r)))
+                        && near((a*b)(r), a(b(r))));
+    });
+    mark(suite).test([] {
+        auto t = Transform::make_translation(Vec(T(4), T(-1)))
+                 * Transform::make_rotation(T(1.1))
+                 * Transform::make_scale(T(2), T(0.5));
+        return ts::test(near(t*t.inverse(), Transform()) && near(t.inverse()*t, Transform()));
+    });
+    mark(suite).test([] {
+        try {
+            (void)Transform::make_scale(T(0), T(1)).inverse();
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    // all batch versions agree with one at a time
+    mark(suite).test([] {
+        auto t = Transform::make_translation(Vec(T(4), T(-1)))
+                 * Transform::make_rotation(T(0.3));
+        std::vector<Vec> points;
+        for (int i = 0; i != 11; ++i) points.emplace_back(T(i), T(i*i % 7));
+        auto in_place = points;
+        transform_points(t, in_place.data(), in_place.data() + in_place.size());
+        std::vector<Vec> copied(points.size());
+        transform_points(t, static_cast<const Vec *>(points.data()),
+                         static_cast<const Vec *>(points.data() + points.size()),
+                         copied.data());
+        Vector2Array<T> arr(points.data(), points.data() + points.size()), arr_out;
+        transform_points(t, arr, arr_out);
+        bool all_good = true;
+        for (std::size_t i = 0; i != points.size(); ++i) {
+            all_good =    all_good && near(in_place[i], t(points[i]))
+                       && near(copied[i], t(points[i])) && near(arr_out[i], t(points[i]));
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        std::vector<Vec> empty;
+        transform_points(Transform(), empty.data(), empty.data());
+        return ts::test(true);
+    });
+    return suite.has_successes_only();
+}
+
+} // end of <anonymous> namespace
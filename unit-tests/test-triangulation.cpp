@@ -0,0 +1,233 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Triangulation.hpp>
+#include <common/TestSuite.hpp>
+
+#include <random>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+using Vec      = Vector2<double>;
+using HoleList = std::vector<std::vector<Vec>>;
+
+constexpr const double k_pi = k_pi_for_type<double>;
+
+std::vector<Vec> make_rectangle(double left, double bottom, double width, double height) {
+    return { Vec(left, bottom), Vec(left + width, bottom),
+             Vec(left + width, bottom + height), Vec(left, bottom + height) };
+}
+
+// every vertex visible from the origin, but many of them reflex
+std::vector<Vec> make_random_star(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> radius(1., 10.);
+    std::vector<Vec> rv;
+    for (std::size_t i = 0; i != count; ++i) {
+        double t = 2.*k_pi*double(i) / double(count);
+        double r = radius(rng);
+        rv.emplace_back(r*std::cos(t), r*std::sin(t));
+    }
+    return rv;
+}
+
+std::vector<Vec> make_comb(int teeth) {
+    std::vector<Vec> rv = { Vec(0, 0) };
+    for (int i = teeth; i != 0; --i) {
+        rv.emplace_back(i*2    , 1);
+        rv.emplace_back(i*2    , 5);
+        rv.emplace_back(i*2 - 1, 5);
+        rv.emplace_back(i*2 - 1, 1);
+    }
+    rv.emplace_back(0, 1);
+    // counter clockwise, the spine along the bottom
+    rv.insert(rv.begin() + 1, Vec(teeth*2, 0));
+    return rv;
+}
+
+// sum of triangle areas, or -1 if any triangle winds clockwise
+double total_area
+    (const std::vector<Vec> & points, const std::vector<std::size_t> & indices)
+{
+    double sum = 0.;
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        Vec tri[] = { points[indices[i]], points[indices[i + 1]], points[indices[i + 2]] };
+        double area = signed_area_of_polygon(tri, tri + 3);
+        if (area < 0.) return -1.;
+        sum += area;
+    }
+    return sum;
+}
+
+std::vector<Vec> concatenate(std::vector<Vec> outline, const HoleList & holes) {
+    for (const auto & hole : holes)
+        { outline.insert(outline.end(), hole.begin(), hole.end()); }
+    return outline;
+}
+
+// all triangle centers must be inside the outline, and outside the holes
+bool all_centers_inside
+    (const std::vector<Vec> & outline, const HoleList & holes,
+     const std::vector<std::size_t> & indices)
+{
+    auto points = concatenate(outline, holes);
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        auto center = (points[indices[i]] + points[indices[i + 1]]
+                       + points[indices[i + 2]]) / 3.;
+        if (!is_inside_polygon(outline.data(), outline.data() + outline.size(), center))
+            { return false; }
+        for (const auto & hole : holes) {
+            if (is_inside_polygon(hole.data(), hole.data() + hole.size(), center))
+                return false;
+        }
+    }
+    return true;
+}
+
+} // end of <anonymous> namespace
+
+int main() {
+    ts::TestSuite suite("PolygonTriangulator");
+    suite.hide_successes();
+    mark(suite).test([] {
+        auto square = make_rectangle(0, 0, 1, 1);
+        std::vector<std::size_t> indices;
+        auto count = triangulate_polygon(square, indices);
+        return ts::test(count == 2 && indices.size() == 6
+                        && are_within(total_area(square, indices), 1., 1e-9));
+    });
+    // clockwise outlines still give counter clockwise triangles
+    mark(suite).test([] {
+        auto square = make_rectangle(0, 0, 2, 3);
+        std::reverse(square.begin(), square.end());
+        std::vector<std::size_t> indices;
+        auto count = triangulate_polygon(square, indices);
+        return ts::test(count == 2 && are_within(total_area(square, indices), 6., 1e-9));
+    });
+    // concave, indices are appended
+    mark(suite).test([] {
+        std::vector<Vec> ell = {
+            Vec(0, 0), Vec(3, 0), Vec(3, 1), Vec(1, 1), Vec(1, 3), Vec(0, 3)
+        };
+        std::vector<std::size_t> indices = { 7, 7, 7 };
+        auto count = triangulate_polygon(ell, indices);
+        indices.erase(indices.begin(), indices.begin() + 3);
+        return ts::test(count == 4 && are_within(total_area(ell, indices), 5., 1e-9)
+                        && all_centers_inside(ell, HoleList{}, indices));
+    });
+    mark(suite).test([] {
+        bool all_good = true;
+        for (unsigned seed = 0; seed != 10; ++seed) {
+            auto star = make_random_star(100 + seed*20, seed);
+            std::vector<std::size_t> indices;
+            auto count = triangulate_polygon(star, indices);
+            double area = area_of_polygon(star.data(), star.data() + star.size());
+            all_good = all_good && count == star.size() - 2
+                && magnitude(total_area(star, indices) - area) < 1e-9*area
+                && all_centers_inside(star, HoleList{}, indices);
+        }
+        return ts::test(all_good);
+    });
+    // straight vertices are dropped
+    mark(suite).test([] {
+        std::vector<Vec> square = {
+            Vec(0, 0), Vec(1, 0), Vec(2, 0), Vec(2, 1), Vec(2, 2), Vec(0, 2)
+        };
+        std::vector<std::size_t> indices;
+        auto count = triangulate_polygon(square, indices);
+        return ts::test(count == 2 && are_within(total_area(square, indices), 4., 1e-9));
+    });
+    mark(suite).test([] {
+        auto outline = make_rectangle(0, 0, 10, 10);
+        HoleList holes = { make_rectangle(3, 3, 4, 4) };
+        std::vector<std::size_t> indices;
+        auto count = triangulate_polygon(outline, holes, indices);
+        auto points = concatenate(outline, holes);
+        return ts::test(count == 8
+                        && are_within(total_area(points, indices), 84., 1e-9)
+                        && all_centers_inside(outline, holes, indices));
+    });
+    // several holes, wound either way, sharing x and y with each other
+    mark(suite).test([] {
+        auto outline = make_random_star(60, 3);
+        for (auto & pt : outline) pt = pt*3.;
+        HoleList holes = {
+            make_rectangle(-2, -2, 1.5, 1.5), make_rectangle(0.5, -2, 1.5, 1.5),
+            make_rectangle(-2, 0.5, 1.5, 1.5), make_rectangle(0.5, 0.5, 1.5, 1.5)
+        };
+        std::reverse(holes[1].begin(), holes[1].end());
+        std::vector<std::size_t> indices;
+        auto count = triangulate_polygon(outline, holes, indices);
+        auto points = concatenate(outline, holes);
+        double area = area_of_polygon(outline.data(), outline.data() + outline.size())
+            - 4.*1.5*1.5;
+        return ts::test(count <= 60 + 16 + 2*4 - 2
+                        && magnitude(total_area(points, indices) - area) < 1e-9*area
+                        && all_centers_inside(outline, holes, indices));
+    });
+    // a reused triangulator
+    mark(suite).test([] {
+        PolygonTriangulator<double> triangulator;
+        auto comb = make_comb(10);
+        std::vector<std::size_t> first, second;
+        triangulator.triangulate(comb, first);
+        triangulator.triangulate(make_random_star(30, 1), second);
+        second.clear();
+        triangulator.triangulate(comb, second);
+        return ts::test(first == second && first.size() <= (comb.size() - 2)*3
+                        && are_within(total_area(comb, first), 2.*10. + 10.*4., 1e-9));
+    });
+    // many reflex vertices
+    mark(suite).test([] {
+        auto comb = make_comb(2000);
+        std::vector<std::size_t> indices;
+        auto count = triangulate_polygon(comb, indices);
+        // tooth bases line up once the teeth are gone, so fewer than n - 2
+        return ts::test(count <= comb.size() - 2
+                        && are_within(total_area(comb, indices), 2.*2000. + 2000.*4., 1e-9));
+    });
+    mark(suite).test([] {
+        std::vector<Vec> line = { Vec(0, 0), Vec(1, 1) };
+        std::vector<std::size_t> indices;
+        return ts::test(triangulate_polygon(line, indices) == 0 && indices.empty());
+    });
+    mark(suite).test([] {
+        auto outline = make_rectangle(0, 0, 1, 1);
+        HoleList holes = { { Vec(0.5, std::numeric_limits<double>::quiet_NaN()),
+                             Vec(0.6, 0.5), Vec(0.5, 0.6) } };
+        std::vector<std::size_t> indices;
+        try {
+            triangulate_polygon(outline, holes, indices);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only() ? 0 : ~0;
+}
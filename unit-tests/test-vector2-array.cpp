@@ -0,0 +1,176 @@
+/****************************************************************************
+
+    MIT License
+
+    Copyright (c) 2021 Aria Janke
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*****************************************************************************/
+
+#include <common/Vector2Array.hpp>
+#include <common/TestSuite.hpp>
+
+#include <vector>
+#include <memory>
+
+#define mark MACRO_MARK_POSITION_OF_CUL_TEST_SUITE
+
+namespace {
+
+using namespace cul;
+
+template <typename T>
+bool run_batch_tests(const char * series_name);
+
+// odd on purpose, so that both SIMD and scalar tail loops run
+constexpr const std::size_t k_test_size = 37;
+
+template <typename T>
+std::vector<Vector2<T>> make_test_vectors(int seed) {
+    std::vector<Vector2<T>> rv;
+    for (std::size_t i = 0; i != k_test_size; ++i) {
+        int n = int(i)*7 + seed;
+        rv.emplace_back(T((n % 23) - 11), T((n % 17) - 8));
+    }
+    // zero vector for normalize
+    rv[5] = Vector2<T>();
+    return rv;
+}
+
+template <typename T>
+bool near(T a, T b) { return magnitude(a - b) <= T(0.0001); }
+
+template <typename T>
+bool near(const Vector2<T> & a, const Vector2<T> & b)
+    { return near(a.x, b.x) && near(a.y, b.y); }
+
+} // end of <anonymous> namespace
+
+int main() {
+    bool all_good = true;
+    if (!run_batch_tests<float >("Vector2Array<float>" )) all_good = false;
+    if (!run_batch_tests<double>("Vector2Array<double>")) all_good = false;
+    if (!run_batch_tests<int   >("Vector2Array<int>"   )) all_good = false;
+    return all_good ? 0 : ~0;
+}
+
+namespace {
+
+template <typename T>
+bool run_batch_tests(const char * series_name) {
+    using Array = Vector2Array<T>;
+    using Vec   = Vector2<T>;
+    ts::TestSuite suite(series_name);
+    suite.hide_successes();
+    mark(suite).test([] {
+        auto vecs = make_test_vectors<T>(1);
+        Array arr(&vecs.front(), &vecs.back() + 1);
+        std::vector<Vec> back(vecs.size());
+        arr.copy_to(back.data());
+        bool all_good = true;
+        for (std::size_t i = 0; i != vecs.size(); ++i)
+            { all_good = all_good && back[i] == vecs[i] && arr[i] == vecs[i]; }
+        return ts::test(all_good && arr.size() == k_test_size);
+    });
+    mark(suite).test([] {
+        auto va = make_test_vectors<T>(1), vb = make_test_vectors<T>(4);
+        Array a(&va.front(), &va.back() + 1), b(&vb.front(), &vb.back() + 1), out;
+        add(a, b, out);
+        bool all_good = true;
+        for (std::size_t i = 0; i != k_test_size; ++i)
+            { all_good = all_good && out[i] == va[i] + vb[i]; }
+        subtract(a, b, out);
+        for (std::size_t i = 0; i != k_test_size; ++i)
+            { all_good = all_good && out[i] == va[i] - vb[i]; }
+        // output may be an input
+        scale(a, T(3), a);
+        for (std::size_t i = 0; i != k_test_size; ++i)
+            { all_good = all_good && a[i] == va[i]*T(3); }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        auto va = make_test_vectors<T>(2), vb = make_test_vectors<T>(9);
+        Array a(&va.front(), &va.back() + 1), b(&vb.front(), &vb.back() + 1);
+        std::vector<T> dots(k_test_size), crosses(k_test_size), mags(k_test_size);
+        dot(a, b, dots.data());
+        cross(a, b, crosses.data());
+        magnitude(a, mags.data());
+        bool all_good = true;
+        for (std::size_t i = 0; i != k_test_size; ++i) {
+            all_good =    all_good && dots[i] == dot(va[i], vb[i])
+                       && crosses[i] == cross(va[i], vb[i])
+                       && mags[i] == magnitude(va[i]);
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        if constexpr (std::is_floating_point_v<T>) {
+            auto va = make_test_vectors<T>(3);
+            Array a(&va.front(), &va.back() + 1), out;
+            normalize(a, out);
+            std::vector<T> dists(k_test_size);
+            distance_to(a, Vec(T(1), T(2)), dists.data());
+            bool all_good = out[5] == Vec();
+            for (std::size_t i = 0; i != k_test_size; ++i) {
+                if (i != 5) all_good = all_good && near(out[i], normalize(va[i]));
+                all_good = all_good && near(dists[i], magnitude(va[i] - Vec(T(1), T(2))));
+            }
+            return ts::test(all_good);
+        }
+        return ts::test(true);
+    });
+    mark(suite).test([] {
+        auto va = make_test_vectors<T>(3);
+        auto vb = va;
+        for (std::size_t i = 0; i < k_test_size; i += 2) vb[i].x += T(3);
+        Array a(&va.front(), &va.back() + 1), b(&vb.front(), &vb.back() + 1);
+        std::unique_ptr<bool[]> within(new bool[k_test_size]);
+        are_within(a, b, T(2), within.get());
+        bool all_good = true;
+        for (std::size_t i = 0; i != k_test_size; ++i)
+            { all_good = all_good && within[i] == (i % 2 == 1); }
+        return ts::test(all_good);
+    });
+    // a negative error is never within, the same as are_within
+    mark(suite).test([] {
+        auto va = make_test_vectors<T>(3);
+        Array a(&va.front(), &va.back() + 1);
+        std::unique_ptr<bool[]> within(new bool[k_test_size]);
+        are_within(a, a, T(-1), within.get());
+        bool all_good = true;
+        for (std::size_t i = 0; i != k_test_size; ++i) {
+            all_good =    all_good && !within[i]
+                       && within[i] == unchecked::are_within(va[i], va[i], T(-1));
+        }
+        return ts::test(all_good);
+    });
+    mark(suite).test([] {
+        Array a(4), b(5), out;
+        try {
+            add(a, b, out);
+        } catch (std::invalid_argument &) {
+            return ts::test(true);
+        }
+        return ts::test(false);
+    });
+    return suite.has_successes_only();
+}
+
+} // end of <anonymous> namespace